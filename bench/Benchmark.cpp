@@ -0,0 +1,119 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Statistics.h"
+#include "Trace.h"
+
+namespace yaga::bench {
+
+std::vector<std::string> Suite::names() const
+{
+    std::vector<std::string> result;
+    for (auto const& benchmark : benchmarks)
+    {
+        result.push_back(benchmark.name);
+    }
+    return result;
+}
+
+std::vector<Result> Suite::run(Run_options const& options,
+                               std::function<void(Result const&)> const& on_result) const
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Result> results;
+    for (auto const& benchmark : benchmarks)
+    {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        auto body = benchmark.setup();
+
+        // warm up and estimate the number of iterations per sample
+        auto start = Clock::now();
+        auto checksum = body();
+        auto duration = std::max<Clock::duration>(Clock::now() - start, Clock::duration{1});
+        auto num_iterations = std::max<std::uint64_t>(
+            1, static_cast<std::uint64_t>(options.min_sample_time / duration));
+
+        std::vector<double> samples;
+        for (int i = 0; i < options.num_samples; ++i)
+        {
+            start = Clock::now();
+            for (std::uint64_t j = 0; j < num_iterations; ++j)
+            {
+                auto value = body();
+                if (i == 0 && j == 0)
+                {
+                    checksum = value;
+                }
+            }
+            std::chrono::duration<double, std::nano> sample_time = Clock::now() - start;
+            samples.push_back(sample_time.count() / static_cast<double>(num_iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+
+        auto& result = results.emplace_back(Result{
+            .name = benchmark.name,
+            .num_samples = options.num_samples,
+            .num_iterations = num_iterations,
+            .min_ns = samples.empty() ? 0 : samples.front(),
+            .median_ns = samples.empty() ? 0 : samples[samples.size() / 2],
+            .mean_ns = samples.empty()
+                           ? 0
+                           : std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size(),
+            .max_ns = samples.empty() ? 0 : samples.back(),
+            .checksum = checksum,
+        });
+
+        if (on_result)
+        {
+            on_result(result);
+        }
+    }
+    return results;
+}
+
+void print_json(std::ostream& out, std::vector<Result> const& results)
+{
+    out << "{\"context\":{\"compiler\":\"";
+#ifdef __VERSION__
+    out << __VERSION__;
+#else
+    out << "unknown";
+#endif
+#ifdef NDEBUG
+    out << "\",\"assertions\":false";
+#else
+    out << "\",\"assertions\":true";
+#endif
+    out << ",\"statistics\":" << (statistics_enabled ? "true" : "false")
+        << ",\"trace\":" << (tracing_enabled ? "true" : "false") << "},\"benchmarks\":[";
+    for (bool is_first = true; auto const& result : results)
+    {
+        out << (is_first ? "\n" : ",\n");
+        out << "{\"name\":\"" << result.name << "\",\"samples\":" << result.num_samples
+            << ",\"iterations\":" << result.num_iterations << ",\"min_ns\":" << result.min_ns
+            << ",\"median_ns\":" << result.median_ns << ",\"mean_ns\":" << result.mean_ns
+            << ",\"max_ns\":" << result.max_ns << ",\"checksum\":" << result.checksum << "}";
+        is_first = false;
+    }
+    out << "\n]}\n";
+}
+
+void print_csv(std::ostream& out, std::vector<Result> const& results)
+{
+    out << "name,samples,iterations,min_ns,median_ns,mean_ns,max_ns,checksum\n";
+    for (auto const& result : results)
+    {
+        out << result.name << "," << result.num_samples << "," << result.num_iterations << ","
+            << result.min_ns << "," << result.median_ns << "," << result.mean_ns << ","
+            << result.max_ns << "," << result.checksum << "\n";
+    }
+}
+
+} // namespace yaga::bench
@@ -0,0 +1,115 @@
+#ifndef YAGA_BENCHMARK_H
+#define YAGA_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace yaga::bench {
+
+// function which runs one iteration of a benchmark and returns a checksum of its result
+using Benchmark_body = std::function<std::uint64_t()>;
+
+// function which prepares input data of a benchmark and returns its body
+using Benchmark_setup = std::function<Benchmark_body()>;
+
+/** Parameters of a benchmark run.
+ */
+struct Run_options {
+    // only benchmarks whose name contains this string are run
+    std::string filter;
+    // number of measured samples of each benchmark
+    int num_samples = 10;
+    // minimal duration of one sample (the number of iterations per sample is chosen accordingly)
+    std::chrono::nanoseconds min_sample_time = std::chrono::milliseconds{50};
+};
+
+/** Measurements of one benchmark.
+ */
+struct Result {
+    std::string name;
+    // number of measured samples
+    int num_samples;
+    // number of iterations in each sample
+    std::uint64_t num_iterations;
+    // statistics of time of one iteration across samples in nanoseconds
+    double min_ns;
+    double median_ns;
+    double mean_ns;
+    double max_ns;
+    // checksum returned by the first measured iteration (it does not depend on timing, so it can
+    // be used to check that two runs computed the same thing)
+    std::uint64_t checksum;
+};
+
+/** Collection of named microbenchmarks.
+ *
+ * Each benchmark consists of a setup function, which is run once and whose time is not
+ * measured, and a body, which is run repeatedly. Inputs should be generated from a fixed seed so
+ * that runs are reproducible.
+ */
+class Suite {
+public:
+    /** Add a new benchmark to the suite
+     *
+     * @param name unique name of the benchmark (`group/name`)
+     * @param setup function which prepares data of the benchmark and returns its body
+     */
+    inline void add(std::string name, Benchmark_setup setup)
+    {
+        benchmarks.push_back({std::move(name), std::move(setup)});
+    }
+
+    /** Get names of all benchmarks in this suite
+     *
+     * @return list of names in the order in which benchmarks were added
+     */
+    std::vector<std::string> names() const;
+
+    /** Run all benchmarks which match @p options
+     *
+     * @param options parameters of the run
+     * @param on_result callback called after each benchmark
+     * @return measurements of benchmarks that have been run
+     */
+    std::vector<Result> run(Run_options const& options,
+                            std::function<void(Result const&)> const& on_result = {}) const;
+
+private:
+    struct Benchmark {
+        std::string name;
+        Benchmark_setup setup;
+    };
+
+    std::vector<Benchmark> benchmarks;
+};
+
+/** Print results as a JSON object with build information and a list of benchmarks
+ *
+ * @param out output stream
+ * @param results measured benchmarks
+ */
+void print_json(std::ostream& out, std::vector<Result> const& results);
+
+/** Print results as CSV with a header line
+ *
+ * @param out output stream
+ * @param results measured benchmarks
+ */
+void print_csv(std::ostream& out, std::vector<Result> const& results);
+
+// benchmarks of core data structures (BCP, variable order, conflict analysis)
+void add_core_benchmarks(Suite& suite);
+
+// benchmarks of the LRA plugin data structures
+void add_lra_benchmarks(Suite& suite);
+
+// benchmarks of the term manager
+void add_terms_benchmarks(Suite& suite);
+
+} // namespace yaga::bench
+
+#endif // YAGA_BENCHMARK_H
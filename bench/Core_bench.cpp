@@ -0,0 +1,197 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Bool_theory.h"
+#include "Conflict_analysis.h"
+#include "Database.h"
+#include "Event_dispatcher.h"
+#include "Trail.h"
+#include "Variable_priority_queue.h"
+
+namespace yaga::bench {
+
+namespace {
+
+// random literal over `num_vars` variables
+Literal random_literal(std::mt19937& rng, int num_vars)
+{
+    Literal lit{static_cast<int>(rng() % num_vars)};
+    return rng() % 2 ? ~lit : lit;
+}
+
+/** Decide random literals in a random 3-CNF and propagate them using `Bool_theory` until
+ * there is a conflict.
+ */
+Benchmark_body bool_theory_propagate(int num_vars, int num_clauses)
+{
+    struct State {
+        Bool_theory theory;
+        Event_dispatcher dispatcher;
+        Trail trail{dispatcher};
+        Database db;
+        std::vector<Literal> decisions;
+    };
+
+    auto state = std::make_shared<State>();
+    state->dispatcher.add(&state->theory);
+    // the last variable is fixed at level 0 so that backtracking to level 0 does not empty the
+    // trail (Bool_theory rebuilds all watch lists if the trail is empty)
+    state->trail.set_model<bool>(Variable::boolean, num_vars + 1);
+    state->db.assert_clause(Literal{num_vars});
+
+    std::mt19937 rng{42};
+    for (int i = 0; i < num_clauses; ++i)
+    {
+        auto& clause = state->db.assert_clause();
+        while (clause.size() < 3)
+        {
+            auto lit = random_literal(rng, num_vars);
+            if (std::none_of(clause.begin(), clause.end(),
+                             [&](auto other) { return other.var() == lit.var(); }))
+            {
+                clause.push_back(lit);
+            }
+        }
+    }
+
+    for (int i = 0; i < num_vars; ++i)
+    {
+        state->decisions.push_back(random_literal(rng, num_vars));
+    }
+
+    state->theory.propagate(state->db, state->trail);
+    return [state] {
+        auto& [theory, dispatcher, trail, db, decisions] = *state;
+        auto& model = trail.model<bool>(Variable::boolean);
+        for (auto lit : decisions)
+        {
+            if (model.is_defined(lit.var().ord()))
+            {
+                continue;
+            }
+
+            trail.decide(lit.var());
+            model.set_value(lit.var().ord(), !lit.is_negation());
+            if (!theory.propagate(db, trail).empty())
+            {
+                break;
+            }
+        }
+
+        std::uint64_t num_assigned = trail.num_assigned();
+        dispatcher.on_before_backtrack(db, trail, 0);
+        trail.backtrack(0);
+        return num_assigned;
+    };
+}
+
+/** Push variables with random scores, bump random variables and pop all variables.
+ */
+Benchmark_body variable_priority_queue(int num_vars, int num_updates)
+{
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<Variable_priority_queue::Score> score_dist{0, 1000};
+    std::vector<Variable_priority_queue::Score> scores(num_vars);
+    std::generate(scores.begin(), scores.end(), [&] { return score_dist(rng); });
+    std::vector<std::pair<int, Variable_priority_queue::Score>> updates;
+    for (int i = 0; i < num_updates; ++i)
+    {
+        updates.emplace_back(static_cast<int>(rng() % num_vars), score_dist(rng));
+    }
+
+    return [=]() mutable {
+        Variable_priority_queue queue;
+        for (int i = 0; i < num_vars; ++i)
+        {
+            queue.push(Variable{i, Variable::boolean}, scores[i]);
+        }
+
+        auto current = scores;
+        for (auto [var_ord, bump] : updates)
+        {
+            current[var_ord] += bump;
+            queue.update(Variable{var_ord, Variable::boolean}, current[var_ord]);
+        }
+
+        std::uint64_t checksum = 0;
+        while (!queue.empty())
+        {
+            checksum = checksum * 31 + queue.top().ord();
+            queue.pop();
+        }
+        return checksum;
+    };
+}
+
+/** Analyze a conflict in a trail with long implication chains at each decision level.
+ */
+Benchmark_body conflict_analysis(int num_levels, int chain_length)
+{
+    struct State {
+        Event_dispatcher dispatcher;
+        Trail trail{dispatcher};
+        std::deque<Clause> reasons;
+        Clause conflict;
+        Conflict_analysis analysis;
+    };
+
+    auto state = std::make_shared<State>();
+    auto& trail = state->trail;
+    auto& model = trail.set_model<bool>(Variable::boolean, num_levels * (chain_length + 1));
+
+    // all variables are true, reasons consist of the propagated literal and negations of literals
+    // from the chain and from random lower decision levels
+    std::mt19937 rng{42};
+    std::vector<int> decisions;
+    int next_var = 0;
+    for (int level = 1; level <= num_levels; ++level)
+    {
+        int decision = next_var++;
+        trail.decide(Variable{decision, Variable::boolean});
+        model.set_value(decision, true);
+        decisions.push_back(decision);
+
+        int prev = decision;
+        for (int i = 0; i < chain_length; ++i)
+        {
+            int var_ord = next_var++;
+            auto& reason = state->reasons.emplace_back(Clause{Literal{var_ord}, ~Literal{prev}});
+            if (i > 0)
+            {
+                reason.push_back(~Literal{var_ord - 2});
+            }
+            reason.push_back(~Literal{decisions[rng() % decisions.size()]});
+            trail.propagate(Variable{var_ord, Variable::boolean}, &reason, level);
+            model.set_value(var_ord, true);
+            prev = var_ord;
+        }
+    }
+    state->conflict = Clause{~Literal{next_var - 1}, ~Literal{next_var - 2},
+                             ~Literal{decisions[rng() % decisions.size()]}};
+
+    return [state] {
+        auto [clause, level] =
+            state->analysis.analyze(state->trail, Clause{state->conflict}, [](auto const&) {});
+        return static_cast<std::uint64_t>(clause.size()) * 1000 + level;
+    };
+}
+
+} // namespace
+
+void add_core_benchmarks(Suite& suite)
+{
+    suite.add("bool_theory/propagate_3cnf_10k", [] { return bool_theory_propagate(10000, 42600); });
+    suite.add("bool_theory/propagate_3cnf_100k",
+              [] { return bool_theory_propagate(100000, 426000); });
+    suite.add("variable_priority_queue/push_update_pop_100k",
+              [] { return variable_priority_queue(100000, 200000); });
+    suite.add("conflict_analysis/analyze_100x100", [] { return conflict_analysis(100, 100); });
+}
+
+} // namespace yaga::bench
@@ -0,0 +1,186 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Linear_constraints.h"
+#include "Model.h"
+#include "Rational.h"
+#include "Variable_bounds.h"
+
+namespace yaga::bench {
+
+namespace {
+
+/** Evaluate `(a * b + c) / d` for each quadruple of fractions in @p values
+ *
+ * @param values list of fractions (its size is a multiple of 4)
+ */
+Benchmark_body fraction_arithmetic(std::vector<Rational> values)
+{
+    return [values = std::move(values)] {
+        std::uint64_t checksum = 0;
+        for (std::size_t i = 0; i + 3 < values.size(); i += 4)
+        {
+            auto result = (values[i] * values[i + 1] + values[i + 2]) / values[i + 3];
+            checksum = checksum * 31 + std::hash<Rational>{}(result);
+        }
+        return checksum;
+    };
+}
+
+// small fractions whose numerators and denominators fit in a machine word
+std::vector<Rational> word_fractions(int count)
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> num_dist{-1000, 1000};
+    std::uniform_int_distribution<unsigned> den_dist{1, 1000};
+    std::vector<Rational> values;
+    for (int i = 0; i < count; ++i)
+    {
+        auto num = num_dist(rng);
+        values.emplace_back(num == 0 ? 1 : num, den_dist(rng));
+    }
+    return values;
+}
+
+// fractions whose numerators and denominators do not fit in a machine word
+std::vector<Rational> mpq_fractions(int count)
+{
+    std::mt19937_64 rng{42};
+    std::vector<Rational> values;
+    for (int i = 0; i < count; ++i)
+    {
+        auto str = std::to_string(rng() | 1) + std::to_string(rng()) + "/" +
+                   std::to_string(rng() | 1) + "7";
+        values.emplace_back(str.c_str());
+    }
+    return values;
+}
+
+/** Create linear constraints with random coefficients and then create the same constraints again
+ * (the repository deduplicates them, so the benchmark measures normalization and hash lookup).
+ */
+Benchmark_body linear_constraints_make(int num_constraints, int num_vars, int size)
+{
+    struct Input {
+        std::vector<int> vars;
+        std::vector<Rational> coef;
+        Rational rhs;
+    };
+
+    struct State {
+        Linear_constraints<Rational> constraints;
+        std::vector<Input> inputs;
+    };
+
+    auto state = std::make_shared<State>();
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> value_dist{-100, 100};
+    std::vector<int> all_vars(num_vars);
+    std::iota(all_vars.begin(), all_vars.end(), 0);
+    for (int i = 0; i < num_constraints; ++i)
+    {
+        auto& input = state->inputs.emplace_back();
+        std::sample(all_vars.begin(), all_vars.end(), std::back_inserter(input.vars), size, rng);
+        for (int j = 0; j < size; ++j)
+        {
+            auto coef = value_dist(rng);
+            input.coef.emplace_back(coef == 0 ? 1 : coef);
+        }
+        input.rhs = value_dist(rng);
+        state->constraints.make(input.vars, input.coef, Order_predicate::leq, input.rhs);
+    }
+
+    return [state] {
+        std::uint64_t checksum = 0;
+        for (auto const& input : state->inputs)
+        {
+            auto cons =
+                state->constraints.make(input.vars, input.coef, Order_predicate::leq, input.rhs);
+            checksum += cons.lit().var().ord();
+        }
+        return checksum;
+    };
+}
+
+/** Query bounds of a variable with deep stacks of lower and upper bounds.
+ *
+ * Variable `x` has bounds implied by `x + y_i <= c_i` and `x + y_i >= d_i` where `y_i = 0`.
+ */
+Benchmark_body variable_bounds_query(int num_bounds, int num_queries)
+{
+    struct State {
+        Model<bool> bool_model;
+        Model<Rational> lra_model;
+        Theory_models<Rational> models{bool_model, lra_model};
+        Linear_constraints<Rational> constraints;
+        Variable_bounds<Rational> bounds;
+        std::vector<Rational> queries;
+    };
+
+    auto state = std::make_shared<State>();
+    auto& [bool_model, lra_model, models, constraints, bounds, queries] = *state;
+    bool_model.resize(2 * num_bounds);
+    lra_model.resize(num_bounds + 1);
+
+    std::vector<Rational> coef{1, 1};
+    for (int i = 0; i < num_bounds; ++i)
+    {
+        std::vector<int> vars{0, i + 1};
+        lra_model.set_value(i + 1, 0);
+
+        // each bound is better than the previous one
+        auto upper = constraints.make(vars, coef, Order_predicate::leq, 2 * num_bounds - i);
+        auto lower = ~constraints.make(vars, coef, Order_predicate::lt, i - 2 * num_bounds);
+        for (auto cons : {upper, lower})
+        {
+            bool_model.set_value(cons.lit().var().ord(), !cons.lit().is_negation());
+        }
+        bounds.add_upper_bound(models, Implied_value<Rational>{
+                                           0, upper.implied_value(lra_model) / upper.coef().front(),
+                                           upper, models});
+        bounds.add_lower_bound(models, Implied_value<Rational>{
+                                           0, lower.implied_value(lra_model) / lower.coef().front(),
+                                           lower, models});
+    }
+
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> value_dist{-2 * num_bounds, 2 * num_bounds};
+    for (int i = 0; i < num_queries; ++i)
+    {
+        queries.emplace_back(value_dist(rng));
+    }
+
+    return [state] {
+        auto& [bool_model, lra_model, models, constraints, bounds, queries] = *state;
+        std::uint64_t checksum = 0;
+        for (auto const& value : queries)
+        {
+            checksum += bounds.is_allowed(models, value);
+            checksum += bounds.upper_bound(models) != nullptr;
+            checksum += bounds.lower_bound(models) != nullptr;
+        }
+        return checksum;
+    };
+}
+
+} // namespace
+
+void add_lra_benchmarks(Suite& suite)
+{
+    suite.add("long_fraction/word_arithmetic_10k",
+              [] { return fraction_arithmetic(word_fractions(40000)); });
+    suite.add("long_fraction/mpq_arithmetic_10k",
+              [] { return fraction_arithmetic(mpq_fractions(40000)); });
+    suite.add("linear_constraints/make_duplicate_10k",
+              [] { return linear_constraints_make(10000, 1000, 4); });
+    suite.add("variable_bounds/query_1k_bounds",
+              [] { return variable_bounds_query(1000, 10000); });
+}
+
+} // namespace yaga::bench
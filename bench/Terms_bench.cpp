@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Term_manager.h"
+#include "Terms.h"
+
+namespace yaga::bench {
+
+namespace {
+
+/** Build a formula with random linear constraints over real constants in a new term manager.
+ *
+ * Each constraint `c_1 * x_1 + ... + c_k * x_k <= c` is built twice so that the benchmark also
+ * measures lookup of existing terms in the term table.
+ */
+Benchmark_body term_manager_build(int num_consts, int num_constraints, int size)
+{
+    struct Input {
+        std::vector<int> vars;
+        std::vector<std::string> coef;
+        std::string rhs;
+    };
+
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> var_dist{0, num_consts - 1};
+    std::uniform_int_distribution<int> value_dist{1, 100};
+    std::vector<Input> inputs(num_constraints);
+    for (auto& input : inputs)
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            input.vars.push_back(var_dist(rng));
+            input.coef.push_back(std::to_string(value_dist(rng)));
+        }
+        input.rhs = std::to_string(value_dist(rng));
+    }
+
+    return [=] {
+        using namespace terms;
+
+        Term_manager manager;
+        std::vector<term_t> consts;
+        for (int i = 0; i < num_consts; ++i)
+        {
+            consts.push_back(manager.mk_uninterpreted_constant(types::real_type));
+        }
+
+        std::uint64_t checksum = 0;
+        std::vector<term_t> atoms;
+        for (int round = 0; round < 2; ++round)
+        {
+            for (auto const& input : inputs)
+            {
+                std::vector<term_t> monomials;
+                for (std::size_t i = 0; i < input.vars.size(); ++i)
+                {
+                    std::array<term_t, 2> factors{manager.mk_integer_constant(input.coef[i]),
+                                                  consts[input.vars[i]]};
+                    monomials.push_back(manager.mk_arithmetic_times(factors));
+                }
+                auto sum = manager.mk_arithmetic_plus(monomials);
+                auto atom = manager.mk_arithmetic_leq(sum, manager.mk_integer_constant(input.rhs));
+                if (round == 0)
+                {
+                    atoms.push_back(atom);
+                }
+                checksum += index_of(atom);
+            }
+        }
+
+        for (std::size_t i = 0; i + 2 < atoms.size(); i += 3)
+        {
+            std::array<term_t, 3> disjuncts{atoms[i], opposite_term(atoms[i + 1]), atoms[i + 2]};
+            checksum += index_of(manager.mk_or(disjuncts));
+        }
+        return checksum;
+    };
+}
+
+} // namespace
+
+void add_terms_benchmarks(Suite& suite)
+{
+    suite.add("term_manager/build_linear_10k", [] { return term_manager_build(1000, 10000, 4); });
+}
+
+} // namespace yaga::bench
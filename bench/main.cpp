@@ -0,0 +1,97 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "Benchmark.h"
+
+using namespace yaga::bench;
+
+void print_help()
+{
+    std::cerr << "Usage: ./bench [options]\n";
+    std::cerr << "Options:\n";
+    std::cerr << "   --list: print names of all benchmarks.\n";
+    std::cerr << "   --filter <text>: run only benchmarks whose name contains text.\n";
+    std::cerr << "   --samples <n>: number of measured samples of each benchmark (default: 10).\n";
+    std::cerr << "   --min-time <ms>: minimal duration of one sample (default: 50).\n";
+    std::cerr << "   --format [json|csv]: format of the results (default: json).\n";
+    std::cerr << "   --output <path>: write the results to path instead of the standard output.\n";
+}
+
+int main(int argc, char** argv)
+{
+    Suite suite;
+    add_core_benchmarks(suite);
+    add_lra_benchmarks(suite);
+    add_terms_benchmarks(suite);
+
+    Run_options options;
+    std::string format = "json";
+    std::string output_path;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg{argv[i]};
+        if (arg == "--list")
+        {
+            for (auto const& name : suite.names())
+            {
+                std::cout << name << "\n";
+            }
+            return 0;
+        }
+        else if (arg == "--filter" && i + 1 < argc)
+        {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--samples" && i + 1 < argc)
+        {
+            options.num_samples = std::stoi(argv[++i]);
+        }
+        else if (arg == "--min-time" && i + 1 < argc)
+        {
+            options.min_sample_time = std::chrono::milliseconds{std::stoi(argv[++i])};
+        }
+        else if (arg == "--format" && i + 1 < argc && (argv[i + 1] == std::string{"json"} ||
+                                                       argv[i + 1] == std::string{"csv"}))
+        {
+            format = argv[++i];
+        }
+        else if (arg == "--output" && i + 1 < argc)
+        {
+            output_path = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unrecognized option: '" << arg << "'\n";
+            print_help();
+            return -1;
+        }
+    }
+
+    // progress is reported on the standard error output so that results can be redirected
+    auto results = suite.run(options, [](Result const& result) {
+        std::cerr << result.name << ": " << result.median_ns << " ns\n";
+    });
+
+    std::ofstream file;
+    if (!output_path.empty())
+    {
+        file.open(output_path);
+        if (!file)
+        {
+            std::cerr << "Error: cannot write to '" << output_path << "'\n";
+            return -1;
+        }
+    }
+
+    auto& out = output_path.empty() ? std::cout : file;
+    if (format == "csv")
+    {
+        print_csv(out, results);
+    }
+    else
+    {
+        print_json(out, results);
+    }
+    return 0;
+}
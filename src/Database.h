@@ -6,6 +6,7 @@
 
 #include "Clause.h"
 #include "Literal.h"
+#include "Memory.h"
 
 namespace yaga {
 
@@ -56,6 +57,16 @@ public:
      */
     inline auto const& asserted() const { return asserted_clauses; }
 
+    /** Add memory used by clauses in this database to @p usage
+     *
+     * @param usage memory usage of subsystems
+     */
+    inline void memory_usage(Memory_usage& usage) const
+    {
+        usage.add("database.asserted", memory_of(asserted_clauses));
+        usage.add("database.learned", memory_of(learned_clauses));
+    }
+
 private:
     std::deque<Clause> learned_clauses;
     std::deque<Clause> asserted_clauses;
@@ -0,0 +1,344 @@
+#include "Dimacs_reader.h"
+
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace yaga {
+
+namespace {
+
+/** Run `@p program -dc` which reads @p input_fd and writes to a new pipe
+ *
+ * @param program name of a decompressor (`gzip` or `xz`)
+ * @param input_fd file descriptor of the compressed file
+ * @param name name of the input for error messages
+ * @return pid of the child process and the read end of its output pipe
+ */
+std::pair<pid_t, int> spawn_decompressor(char const* program, int input_fd, std::string const& name)
+{
+    int pipe_fds[2];
+    if (::pipe(pipe_fds) < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), name);
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, input_fd, STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, pipe_fds[0]);
+    posix_spawn_file_actions_addclose(&actions, pipe_fds[1]);
+
+    pid_t pid = -1;
+    std::string arg0{program};
+    std::string arg1{"-dc"};
+    char* argv[] = {arg0.data(), arg1.data(), nullptr};
+    int error = posix_spawnp(&pid, program, &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(pipe_fds[1]);
+    if (error != 0)
+    {
+        ::close(pipe_fds[0]);
+        throw std::system_error(error, std::generic_category(), name + ": " + program);
+    }
+    return {pid, pipe_fds[0]};
+}
+
+} // namespace
+
+Dimacs_reader::Dimacs_reader(std::string const& path) : name(path)
+{
+    int file_fd = ::open(path.c_str(), O_RDONLY);
+    if (file_fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+
+    char const* decompressor = path.ends_with(".gz")   ? "gzip"
+                               : path.ends_with(".xz") ? "xz"
+                                                       : nullptr;
+    if (decompressor != nullptr)
+    {
+        try
+        {
+            auto [pid, pipe_fd] = spawn_decompressor(decompressor, file_fd, path);
+            child = pid;
+            fd = pipe_fd;
+        }
+        catch (...)
+        {
+            ::close(file_fd);
+            throw;
+        }
+        ::close(file_fd); // the child process has its own copy
+    }
+    else
+    {
+        struct stat file_stat{};
+        if (::fstat(file_fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode) && file_stat.st_size > 0)
+        {
+            mapping_size = static_cast<std::size_t>(file_stat.st_size);
+            mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file_fd, 0);
+        }
+
+        if (mapping != nullptr && mapping != MAP_FAILED)
+        {
+            ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+            ::close(file_fd); // the mapping remains valid
+            next = static_cast<char const*>(mapping);
+            end = next + mapping_size;
+            num_read = mapping_size;
+        }
+        else // pipes, empty files and files which cannot be mapped are read in blocks
+        {
+            mapping = nullptr;
+            fd = file_fd;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        block = std::make_unique<char[]>(block_size);
+    }
+}
+
+Dimacs_reader::Dimacs_reader(std::string_view input)
+    : name("input"), next(input.data()), end(input.data() + input.size()), num_read(input.size())
+{
+}
+
+Dimacs_reader::~Dimacs_reader()
+{
+    if (mapping != nullptr)
+    {
+        ::munmap(mapping, mapping_size);
+    }
+
+    if (fd >= 0)
+    {
+        ::close(fd); // the child process terminates if it is still writing to the pipe
+    }
+
+    if (child >= 0)
+    {
+        ::waitpid(child, nullptr, 0);
+    }
+}
+
+bool Dimacs_reader::refill()
+{
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    ssize_t size = 0;
+    do
+    {
+        size = ::read(fd, block.get(), block_size);
+    } while (size < 0 && errno == EINTR);
+
+    if (size < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), name);
+    }
+
+    if (size == 0)
+    {
+        close_child();
+        return false;
+    }
+
+    next = block.get();
+    end = next + size;
+    num_read += static_cast<std::size_t>(size);
+    return true;
+}
+
+void Dimacs_reader::close_child()
+{
+    if (child < 0)
+    {
+        return;
+    }
+
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    child = -1;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        throw Dimacs_error{"failed to decompress " + name};
+    }
+}
+
+void Dimacs_reader::skip_whitespace()
+{
+    for (int c = peek(); c == ' ' || c == '\n' || c == '\t' || c == '\r'; c = peek())
+    {
+        ++next;
+    }
+}
+
+void Dimacs_reader::skip_line()
+{
+    for (int c = peek(); c >= 0 && c != '\n'; c = peek())
+    {
+        ++next;
+    }
+}
+
+void Dimacs_reader::expect(std::string_view word)
+{
+    for (char expected : word)
+    {
+        if (peek() != expected)
+        {
+            throw Dimacs_error{"failed to parse the DIMACS problem line. Expected: 'p cnf "
+                               "[num_vars] [num_clauses]'"};
+        }
+        ++next;
+    }
+}
+
+int Dimacs_reader::scan_int()
+{
+    skip_whitespace();
+    bool is_negative = peek() == '-';
+    if (is_negative)
+    {
+        ++next;
+    }
+
+    int c = peek();
+    if (c < '0' || c > '9')
+    {
+        throw Dimacs_error{c < 0 ? std::string{"unexpected end of input"}
+                                 : "unexpected character '" + std::string(1, static_cast<char>(c)) +
+                                       "'"};
+    }
+
+    long long value = 0;
+    do
+    {
+        value = value * 10 + (c - '0');
+        if (value > INT_MAX)
+        {
+            throw Dimacs_error{"integer is too large"};
+        }
+        ++next;
+        c = peek();
+    } while (c >= '0' && c <= '9');
+    return static_cast<int>(is_negative ? -value : value);
+}
+
+Dimacs_stats Dimacs_reader::read(Solver& solver)
+{
+    auto start = std::chrono::steady_clock::now();
+    Dimacs_stats stats;
+    bool is_initialized = false;
+    int num_missing = 0;
+
+    // assert clause in `buffer` and return true iff it is empty
+    auto finish_clause = [&]() {
+        if (num_missing > 0 && buffer.empty())
+        {
+            return true;
+        }
+
+        if (num_missing > 0) // superfluous clauses are ignored
+        {
+            solver.db().assert_clause(Clause{buffer.begin(), buffer.end()});
+        }
+        buffer.clear();
+        --num_missing;
+        return false;
+    };
+
+    for (;;)
+    {
+        skip_whitespace();
+        int c = peek();
+        if (c < 0 || c == '%') // formulas in the SATLIB benchmarks end with `%`
+        {
+            break;
+        }
+
+        if (c == 'c')
+        {
+            skip_line();
+        }
+        else if (c == 'p')
+        {
+            if (is_initialized)
+            {
+                throw Dimacs_error{"duplicate DIMACS problem line 'p cnf ...'"};
+            }
+            is_initialized = true;
+            expect("p");
+            skip_whitespace();
+            expect("cnf");
+            stats.num_vars = scan_int();
+            stats.num_clauses = scan_int();
+            if (stats.num_vars < 0 || stats.num_clauses < 0)
+            {
+                throw Dimacs_error{"negative size in the DIMACS problem line"};
+            }
+            num_missing = stats.num_clauses;
+            solver.trail().set_model<bool>(Variable::boolean, stats.num_vars);
+        }
+        else
+        {
+            if (!is_initialized)
+            {
+                throw Dimacs_error{"clause before DIMACS problem line"};
+            }
+
+            int lit = scan_int();
+            if (lit > stats.num_vars || lit < -stats.num_vars)
+            {
+                throw Dimacs_error{"unknown literal " + std::to_string(lit)};
+            }
+
+            if (lit != 0)
+            {
+                buffer.emplace_back(lit < 0 ? ~Literal{-lit - 1} : Literal{lit - 1});
+            }
+            else if (finish_clause())
+            {
+                stats.has_empty_clause = true;
+                break;
+            }
+        }
+    }
+
+    if (!is_initialized)
+    {
+        throw Dimacs_error{"missing DIMACS problem line. Expected 'p cnf [num_vars] [num_clauses]'"};
+    }
+
+    // the last clause does not have to be terminated by 0
+    if (!stats.has_empty_clause && !buffer.empty())
+    {
+        finish_clause();
+    }
+
+    if (!stats.has_empty_clause && num_missing > 0)
+    {
+        throw Dimacs_error{"insufficient number of clauses"};
+    }
+
+    stats.num_bytes = num_read - static_cast<std::size_t>(end - next);
+    stats.time = std::chrono::steady_clock::now() - start;
+    return stats;
+}
+
+} // namespace yaga
@@ -0,0 +1,160 @@
+#ifndef YAGA_DIMACS_READER_H
+#define YAGA_DIMACS_READER_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+
+#include "Clause.h"
+#include "Solver.h"
+
+namespace yaga {
+
+/** Error in the content of a DIMACS file.
+ */
+class Dimacs_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/** Summary of a CNF formula read by `Dimacs_reader`.
+ */
+struct Dimacs_stats {
+    // number of variables from the problem line
+    int num_vars = 0;
+    // number of clauses from the problem line
+    int num_clauses = 0;
+    // true iff the formula contains an empty clause (clauses after it are not read)
+    bool has_empty_clause = false;
+    // number of (decompressed) bytes read
+    std::size_t num_bytes = 0;
+    // time spent reading the input
+    std::chrono::steady_clock::duration time{0};
+
+    /** Get parsing throughput
+     *
+     * @return number of megabytes (10^6 bytes) read per second
+     */
+    inline double megabytes_per_second() const
+    {
+        std::chrono::duration<double> seconds = time;
+        return seconds.count() > 0 ? num_bytes / 1e6 / seconds.count() : 0;
+    }
+};
+
+/** Reader of CNF formulas in the DIMACS format.
+ *
+ * Regular files are mapped to memory and scanned in place. Files with extension `.gz` or `.xz`
+ * are decompressed by `gzip` or `xz` in a child process and scanned in blocks while they are
+ * being decompressed. Other files (e.g., pipes) are read in blocks as well.
+ *
+ * Integers are scanned by a hand-written scanner, so no line or token is ever copied.
+ */
+class Dimacs_reader {
+public:
+    /** Open file @p path
+     *
+     * @param path path to a DIMACS file (possibly compressed by gzip or xz)
+     * @throws std::system_error if the file cannot be opened or the decompressor cannot be run
+     */
+    explicit Dimacs_reader(std::string const& path);
+
+    /** Read formula from @p input
+     *
+     * @param input content of a DIMACS file (it has to outlive the reader)
+     */
+    explicit Dimacs_reader(std::string_view input);
+
+    ~Dimacs_reader();
+
+    Dimacs_reader(Dimacs_reader const&) = delete;
+    Dimacs_reader& operator=(Dimacs_reader const&) = delete;
+
+    /** Read the problem line and all clauses and assert the clauses to @p solver
+     *
+     * The model of boolean variables in the solver trail is created with the number of
+     * variables from the problem line.
+     *
+     * @param solver solver without boolean variables
+     * @return summary of the formula
+     * @throws Dimacs_error if the input is not a valid DIMACS file
+     * @throws std::system_error if the input cannot be read
+     */
+    Dimacs_stats read(Solver& solver);
+
+private:
+    // name of the input used in error messages
+    std::string name;
+    // memory mapped by `mmap` (nullptr if the input is not mapped)
+    void* mapping = nullptr;
+    // size of `mapping` in bytes
+    std::size_t mapping_size = 0;
+    // file descriptor of a file or a pipe read in blocks (-1 if the input is in memory)
+    int fd = -1;
+    // decompressing child process (-1 if there is no such process)
+    pid_t child = -1;
+    // buffer for blocks of a file descriptor input
+    std::unique_ptr<char[]> block;
+    // next character to scan
+    char const* next = nullptr;
+    // end of the scanned part of the input
+    char const* end = nullptr;
+    // number of bytes mapped to memory or read from `fd` so far
+    std::size_t num_read = 0;
+    // literals of the current clause
+    Clause buffer;
+
+    // size of `block`
+    static constexpr std::size_t block_size = 1 << 20;
+
+    /** Read the next block of a file descriptor input
+     *
+     * @return false iff the end of the input has been reached
+     */
+    bool refill();
+
+    /** Get the next character without consuming it
+     *
+     * @return the next character or -1 at the end of the input
+     */
+    inline int peek()
+    {
+        if (next == end && !refill())
+        {
+            return -1;
+        }
+        return static_cast<unsigned char>(*next);
+    }
+
+    /** Skip whitespace characters
+     */
+    void skip_whitespace();
+
+    /** Skip the rest of the current line
+     */
+    void skip_line();
+
+    /** Consume @p word or throw an error if it is not the next part of the input
+     *
+     * @param word expected characters
+     */
+    void expect(std::string_view word);
+
+    /** Scan a decimal integer with an optional minus sign
+     *
+     * @return value of the integer
+     */
+    int scan_int();
+
+    /** Wait for the decompressing child process and check whether it succeeded
+     */
+    void close_child();
+};
+
+} // namespace yaga
+
+#endif // YAGA_DIMACS_READER_H
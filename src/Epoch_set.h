@@ -0,0 +1,78 @@
+#ifndef YAGA_EPOCH_SET_H
+#define YAGA_EPOCH_SET_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace yaga {
+
+/** Set of small non-negative integers (e.g., variable ordinal numbers or term indices) with
+ * constant time `clear()`.
+ *
+ * Each element is mapped to a stamp. An element is in the set iff its stamp is equal to the current
+ * epoch. `clear()` only increments the epoch, so the set can be reused for every propagation or
+ * traversal without allocating or touching memory of elements which were not inserted.
+ */
+class Epoch_set {
+public:
+    /** Allocate memory for elements in range [0, @p size)
+     *
+     * @param size new number of elements
+     */
+    inline void resize(int size) { stamps.resize(size, 0); }
+
+    /** Remove all elements from the set
+     */
+    inline void clear()
+    {
+        if (++epoch == 0) // overflow
+        {
+            std::fill(stamps.begin(), stamps.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    /** Insert @p value to the set. Memory is allocated if @p value is out of range.
+     *
+     * @param value non-negative integer to insert
+     * @return true iff @p value was not in the set before this call
+     */
+    inline bool insert(int value)
+    {
+        assert(value >= 0);
+        if (value >= static_cast<int>(stamps.size()))
+        {
+            stamps.resize(value + 1, 0);
+        }
+
+        if (stamps[value] == epoch)
+        {
+            return false;
+        }
+        stamps[value] = epoch;
+        return true;
+    }
+
+    /** Check whether @p value is in the set
+     *
+     * @param value non-negative integer
+     * @return true iff @p value is in the set
+     */
+    inline bool contains(int value) const
+    {
+        assert(value >= 0);
+        return value < static_cast<int>(stamps.size()) && stamps[value] == epoch;
+    }
+
+private:
+    // map element -> epoch in which it was inserted to the set
+    std::vector<std::uint32_t> stamps;
+    // current epoch
+    std::uint32_t epoch = 1;
+};
+
+} // namespace yaga
+
+#endif // YAGA_EPOCH_SET_H
@@ -5,6 +5,7 @@
 #include <ranges>
 
 #include "Event_listener.h"
+#include "Trace.h"
 
 namespace yaga {
 
@@ -21,6 +22,7 @@ public:
      */
     void on_init(Database& db, Trail& trail) override
     {
+        Trace_scope trace{Trace_event::on_init};
         for (auto&& listener : listeners)
         {
             listener->on_init(db, trail);
@@ -34,6 +36,7 @@ public:
      */
     void on_variable_resize(Variable::Type type, int num_vars) override
     {
+        Trace_scope trace{Trace_event::on_variable_resize, num_vars};
         for (auto&& listener : listeners)
         {
             listener->on_variable_resize(type, num_vars);
@@ -48,6 +51,7 @@ public:
      */
     void on_before_backtrack(Database& db, Trail& trail, int decision_level) override
     {
+        Trace_scope trace{Trace_event::on_before_backtrack, decision_level};
         for (auto&& listener : listeners)
         {
             listener->on_before_backtrack(db, trail, decision_level);
@@ -62,6 +66,7 @@ public:
      */
     void on_learned_clause(Database& db, Trail& trail, Clause const& learned) override
     {
+        Trace_scope trace{Trace_event::on_learned_clause, static_cast<int>(learned.size())};
         for (auto&& listener : listeners)
         {
             listener->on_learned_clause(db, trail, learned);
@@ -76,6 +81,8 @@ public:
      */
     void on_conflict_resolved(Database& db, Trail& trail, Clause const& other_clause) override
     {
+        Trace_scope trace{Trace_event::on_conflict_resolved,
+                          static_cast<int>(other_clause.size())};
         for (auto&& listener : listeners)
         {
             listener->on_conflict_resolved(db, trail, other_clause);
@@ -89,6 +96,7 @@ public:
      */
     void on_restart(Database& db, Trail& trail) override 
     {
+        Trace_scope trace{Trace_event::on_restart};
         for (auto&& listener : listeners)
         {
             listener->on_restart(db, trail);
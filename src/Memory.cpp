@@ -0,0 +1,46 @@
+#include "Memory.h"
+
+#include <fstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace yaga {
+
+std::size_t Memory_usage::total() const
+{
+    std::size_t result = 0;
+    for (auto const& [_, bytes] : usage)
+    {
+        result += bytes;
+    }
+    return result;
+}
+
+void Memory_usage::print_json(std::ostream& out) const
+{
+    out << "{\"total\":" << total();
+    for (auto const& [name, bytes] : usage)
+    {
+        out << ",\"" << name << "\":" << bytes;
+    }
+    out << "}";
+}
+
+std::size_t resident_memory()
+{
+    // the second number in statm is the number of resident pages (Linux)
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t num_pages = 0;
+    std::size_t num_resident_pages = 0;
+    if (statm >> num_pages >> num_resident_pages)
+    {
+        return num_resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024; // ru_maxrss is in kilobytes
+}
+
+} // namespace yaga
@@ -0,0 +1,106 @@
+#ifndef YAGA_MEMORY_H
+#define YAGA_MEMORY_H
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace yaga {
+
+/** Estimate of heap memory used by solver data structures, broken down by subsystem.
+ *
+ * Estimates are computed on demand from sizes and capacities of containers. They do not include
+ * overhead of the allocator, so they are lower bounds of the real memory use.
+ */
+class Memory_usage {
+public:
+    /** Add memory used by a subsystem
+     *
+     * @param subsystem name of the subsystem (e.g., `database.learned`)
+     * @param bytes number of bytes added to the subsystem
+     */
+    inline void add(std::string_view subsystem, std::size_t bytes)
+    {
+        auto it = usage.find(subsystem);
+        if (it == usage.end())
+        {
+            it = usage.emplace(std::string{subsystem}, 0).first;
+        }
+        it->second += bytes;
+    }
+
+    /** Get memory used by a subsystem
+     *
+     * @param subsystem name of the subsystem
+     * @return number of bytes used by @p subsystem or 0 if it has not been added
+     */
+    inline std::size_t bytes(std::string_view subsystem) const
+    {
+        auto it = usage.find(subsystem);
+        return it == usage.end() ? 0 : it->second;
+    }
+
+    /** Get memory used by all subsystems
+     *
+     * @return total number of bytes
+     */
+    std::size_t total() const;
+
+    // get map subsystem name -> number of bytes
+    inline std::map<std::string, std::size_t, std::less<>> const& subsystems() const
+    {
+        return usage;
+    }
+
+    /** Print memory usage as a JSON object which maps subsystems (and `total`) to bytes
+     *
+     * @param out output stream
+     */
+    void print_json(std::ostream& out) const;
+
+private:
+    std::map<std::string, std::size_t, std::less<>> usage;
+};
+
+// get number of bytes allocated by @p vec
+template <typename T> inline std::size_t memory_of(std::vector<T> const& vec)
+{
+    return vec.capacity() * sizeof(T);
+}
+
+// get number of bytes allocated by @p vec and by all its elements
+template <typename T> inline std::size_t memory_of(std::vector<std::vector<T>> const& vec)
+{
+    std::size_t result = vec.capacity() * sizeof(std::vector<T>);
+    for (auto const& inner : vec)
+    {
+        result += memory_of(inner);
+    }
+    return result;
+}
+
+// get number of bytes allocated by @p list and by all its elements
+template <typename T> inline std::size_t memory_of(std::deque<std::vector<T>> const& list)
+{
+    std::size_t result = list.size() * sizeof(std::vector<T>);
+    for (auto const& inner : list)
+    {
+        result += memory_of(inner);
+    }
+    return result;
+}
+
+/** Get resident set size of this process.
+ *
+ * @return current resident set size in bytes if the system provides it, peak resident set size
+ * otherwise
+ */
+std::size_t resident_memory();
+
+} // namespace yaga
+
+#endif // YAGA_MEMORY_H
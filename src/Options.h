@@ -1,6 +1,8 @@
 #ifndef YAGA_OPTIONS_H
 #define YAGA_OPTIONS_H
 
+#include <cstdint>
+
 #include "Bool_theory.h"
 
 namespace yaga {
@@ -23,9 +25,51 @@ struct Options {
      */
     bool print_stats = false;
 
+    /** If true, unsat cores are shrunk to a minimal set before they are printed.
+     */
+    bool minimize_cores = false;
+
+    /** If true, assertions are simplified before they are internalized (constant folding,
+     * normalization of atoms, ITE lifting, substitution of top-level equalities and removal of
+     * duplicate or subsumed assertions).
+     */
+    bool simplify = true;
+
+    /** Time limit (in milliseconds) for one run of the simplification to a fixed point.
+     */
+    int simplify_time_limit = 1000;
+
+    /** If true, input files are mapped to memory and scanned without copying tokens. Otherwise,
+     * they are read through a stream by the flex lexer.
+     */
+    bool mmap_input = true;
+
+    /** If true, assertions are internalized by a background thread while the rest of the input is
+     * parsed. Assertions internalized this way are not simplified, since the preprocessor needs
+     * all assertions of a level and it creates new terms.
+     */
+    bool pipeline = false;
+
     /** Value selection strategy for boolean variables.
      */
     Phase phase = Phase::positive;
+
+    /** Wall-clock time limit (in milliseconds) for solving the input. It is measured from
+     * creation of the solver, so it includes time spent by parsing and simplification. If it is
+     * exceeded, check returns `unknown`. Zero means no limit.
+     */
+    int timeout = 0;
+
+    /** Maximal number of conflicts in one check. If it is exceeded, check returns `unknown`.
+     * Zero means no limit.
+     */
+    std::int64_t conflict_limit = 0;
+
+    /** Maximal resident set size of the solver process in MB. Learned clauses are removed when the
+     * process gets close to the limit. If it is exceeded, check returns `unknown`. Zero means no
+     * limit.
+     */
+    std::int64_t memory_limit = 0;
 };
 
 }
@@ -0,0 +1,373 @@
+#include "Probing.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace yaga {
+
+bool Probing::run(Database& db, Trail& trail, Theory& theory, Event_listener& listener,
+                  std::int64_t budget)
+{
+    auto start = Clock::now();
+    resize(trail.model<bool>(Variable::boolean).num_vars());
+
+    Context ctx{db, trail, theory, listener};
+    bool is_consistent = simplify(ctx, budget);
+    time_spent += Clock::now() - start;
+    return is_consistent;
+}
+
+void Probing::resize(int num_vars)
+{
+    implications.resize(num_vars);
+    repr.resize(num_vars);
+    index.resize(num_vars);
+    lowlink.resize(num_vars);
+    is_on_stack.resize(num_vars);
+    marks.resize(num_vars);
+    is_substituted.resize(num_vars, false);
+    if (next_var >= num_vars)
+    {
+        next_var = 0;
+    }
+}
+
+bool Probing::simplify(Context& ctx, std::int64_t budget)
+{
+    if (!propagate(ctx))
+    {
+        return false;
+    }
+
+    build_implication_graph(ctx);
+    auto const& model = ctx.trail.model<bool>(Variable::boolean);
+    auto num_vars = static_cast<int>(model.num_vars());
+    auto num_new = find_equivalences(num_vars);
+    if (num_new < 0)
+    {
+        return false;
+    }
+    else if (num_new > 0)
+    {
+        // clauses are changed, so they cannot be reasons of assigned variables
+        ctx.listener.on_before_backtrack(ctx.db, ctx.trail, /*decision_level=*/0);
+        ctx.trail.clear();
+        substitute(ctx.db);
+        if (!propagate(ctx))
+        {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < num_vars && budget > 0; ++i)
+    {
+        int var_ord = next_var;
+        next_var = next_var + 1 < num_vars ? next_var + 1 : 0;
+
+        Literal lit{var_ord};
+        if (model.is_defined(var_ord) || repr[lit] != lit ||
+            (implications[lit].empty() && implications[~lit].empty()))
+        {
+            continue;
+        }
+
+        if (!probe(ctx, var_ord, budget))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Probing::propagate(Context& ctx)
+{
+    return ctx.theory.propagate(ctx.db, ctx.trail).empty();
+}
+
+void Probing::build_implication_graph(Context& ctx)
+{
+    for (auto& list : implications)
+    {
+        list.clear();
+    }
+
+    auto const& model = ctx.trail.model<bool>(Variable::boolean);
+    for (auto clauses : {&ctx.db.asserted(), &ctx.db.learned()})
+    {
+        for (auto const& clause : *clauses)
+        {
+            if (clause.size() != 2 || model.is_defined(clause[0].var().ord()) ||
+                model.is_defined(clause[1].var().ord()))
+            {
+                continue;
+            }
+
+            implications[~clause[0]].push_back(clause[1]);
+            implications[~clause[1]].push_back(clause[0]);
+        }
+    }
+}
+
+int Probing::find_equivalences(int num_vars)
+{
+    index.assign(-1);
+    is_on_stack.assign(false);
+    for (int var_ord = 0; var_ord < num_vars; ++var_ord)
+    {
+        repr[Literal{var_ord}] = Literal{var_ord};
+        repr[~Literal{var_ord}] = ~Literal{var_ord};
+    }
+
+    int num_new = 0;
+    int next_index = 0;
+    std::vector<Literal> stack;
+    std::vector<Literal> component;
+    // DFS stack of literals with the index of the next edge to follow
+    std::vector<std::pair<Literal, std::size_t>> path;
+
+    auto visit = [&](Literal lit) {
+        index[lit] = lowlink[lit] = next_index++;
+        stack.push_back(lit);
+        is_on_stack[lit] = true;
+        path.emplace_back(lit, 0);
+    };
+
+    for (int var_ord = 0; var_ord < num_vars; ++var_ord)
+    {
+        for (auto root : {Literal{var_ord}, ~Literal{var_ord}})
+        {
+            if (index[root] >= 0 || implications[root].empty())
+            {
+                continue;
+            }
+
+            visit(root);
+            while (!path.empty())
+            {
+                auto [lit, edge] = path.back();
+                if (edge < implications[lit].size())
+                {
+                    ++path.back().second;
+                    auto next = implications[lit][edge];
+                    if (index[next] < 0)
+                    {
+                        visit(next);
+                    }
+                    else if (is_on_stack[next])
+                    {
+                        lowlink[lit] = std::min(lowlink[lit], index[next]);
+                    }
+                    continue;
+                }
+
+                path.pop_back();
+                if (!path.empty())
+                {
+                    auto parent = path.back().first;
+                    lowlink[parent] = std::min(lowlink[parent], lowlink[lit]);
+                }
+
+                if (lowlink[lit] != index[lit])
+                {
+                    continue;
+                }
+
+                // `lit` is the root of a strongly connected component
+                component.clear();
+                Literal best = lit;
+                Literal other;
+                do
+                {
+                    other = stack.back();
+                    stack.pop_back();
+                    is_on_stack[other] = false;
+                    component.push_back(other);
+                    if (other.var().ord() < best.var().ord())
+                    {
+                        best = other;
+                    }
+                } while (other != lit);
+
+                // the complementary component has the negated representative since it is the
+                // literal with the same variable
+                bool is_contradiction = false;
+                for (auto member : component)
+                {
+                    is_contradiction = is_contradiction || marks[~member];
+                    marks[member] = true;
+                }
+
+                for (auto member : component)
+                {
+                    marks[member] = false;
+                    repr[member] = best;
+                    if (member != best && !member.is_negation() &&
+                        !is_substituted[member.var().ord()])
+                    {
+                        is_substituted[member.var().ord()] = true;
+                        ++num_new;
+                    }
+                }
+
+                if (is_contradiction)
+                {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    num_substituted_vars += num_new;
+    return num_new;
+}
+
+void Probing::substitute(Database& db)
+{
+    for (auto clauses : {&db.asserted(), &db.learned()})
+    {
+        for (auto& clause : *clauses)
+        {
+            // binary clauses within a component keep the equivalence
+            if (clause.size() == 2 && repr[clause[0]] == ~repr[clause[1]])
+            {
+                continue;
+            }
+
+            bool is_changed = false;
+            for (auto& lit : clause)
+            {
+                if (repr[lit] != lit)
+                {
+                    lit = repr[lit];
+                    is_changed = true;
+                }
+            }
+
+            if (!is_changed)
+            {
+                continue;
+            }
+
+            std::sort(clause.begin(), clause.end(), Literal_comparer{});
+            clause.erase(std::unique(clause.begin(), clause.end()), clause.end());
+            for (std::size_t i = 0; i + 1 < clause.size(); ++i)
+            {
+                if (clause[i].var() == clause[i + 1].var()) // tautology
+                {
+                    clause.clear();
+                    break;
+                }
+            }
+        }
+
+        clauses->erase(std::remove_if(clauses->begin(), clauses->end(),
+                                      [](auto const& clause) { return clause.empty(); }),
+                       clauses->end());
+    }
+}
+
+bool Probing::probe(Context& ctx, int var_ord, std::int64_t& budget)
+{
+    Literal pos{var_ord};
+    if (assume(ctx, pos, budget))
+    {
+        backtrack(ctx);
+        ++num_failed_lits;
+        return fix(ctx, ~pos);
+    }
+
+    // mark literals implied by `pos`
+    auto const& model = ctx.trail.model<bool>(Variable::boolean);
+    auto implied_lits = [&]() {
+        std::vector<Literal> lits;
+        for (auto [var, _] : ctx.trail.assigned(1))
+        {
+            if (var.type() == Variable::boolean && var.ord() != var_ord &&
+                ctx.trail.decision_level(var) == 1)
+            {
+                lits.push_back(model.value(var.ord()) ? Literal{var.ord()} : ~Literal{var.ord()});
+            }
+        }
+        return lits;
+    };
+
+    auto pos_implied = implied_lits();
+    backtrack(ctx);
+    for (auto lit : pos_implied)
+    {
+        marks[lit] = true;
+    }
+
+    bool is_failed = assume(ctx, ~pos, budget);
+    std::vector<Literal> common;
+    if (!is_failed)
+    {
+        for (auto lit : implied_lits())
+        {
+            if (marks[lit])
+            {
+                common.push_back(lit);
+            }
+        }
+    }
+    backtrack(ctx);
+    for (auto lit : pos_implied)
+    {
+        marks[lit] = false;
+    }
+
+    if (is_failed)
+    {
+        ++num_failed_lits;
+        return fix(ctx, pos);
+    }
+
+    for (auto lit : common)
+    {
+        auto value = eval(model, lit);
+        if (value == false)
+        {
+            return false;
+        }
+        else if (!value)
+        {
+            ++num_implied_lits;
+            if (!fix(ctx, lit))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Probing::assume(Context& ctx, Literal lit, std::int64_t& budget)
+{
+    auto& model = ctx.trail.model<bool>(Variable::boolean);
+    ctx.trail.decide(lit.var());
+    model.set_value(lit.var().ord(), !lit.is_negation());
+
+    bool is_conflict = !propagate(ctx);
+    auto num_propagated = static_cast<std::int64_t>(ctx.trail.assigned(1).size());
+    budget -= num_propagated;
+    total_propagations += num_propagated;
+    return is_conflict;
+}
+
+void Probing::backtrack(Context& ctx)
+{
+    ctx.listener.on_before_backtrack(ctx.db, ctx.trail, /*decision_level=*/0);
+    ctx.trail.backtrack(0);
+}
+
+bool Probing::fix(Context& ctx, Literal lit)
+{
+    auto& model = ctx.trail.model<bool>(Variable::boolean);
+    auto& unit = ctx.db.learn_clause(lit);
+    ctx.theory.on_learned_clause(ctx.db, ctx.trail, unit);
+    model.set_value(lit.var().ord(), !lit.is_negation());
+    ctx.trail.propagate(lit.var(), &unit, /*level=*/0);
+    return propagate(ctx);
+}
+
+} // namespace yaga
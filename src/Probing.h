@@ -0,0 +1,228 @@
+#ifndef YAGA_PROBING_H
+#define YAGA_PROBING_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Event_listener.h"
+#include "Literal.h"
+#include "Literal_map.h"
+#include "Theory.h"
+#include "Trail.h"
+
+namespace yaga {
+
+/** Failed-literal probing and equivalent-literal substitution at decision level 0.
+ *
+ * Each run:
+ *  -# computes strongly connected components of the binary implication graph and replaces
+ *     literals in each component by a representative literal in all clauses. Binary clauses
+ *     which form the components are kept so that the equivalences still hold in the database.
+ *  -# decides both literals of variables which occur in binary clauses at decision level 1 and
+ *     propagates them using the theory. If a literal leads to a conflict, its negation is
+ *     learned as a unit clause. Literals implied by both polarities of a variable are learned
+ *     as unit clauses as well.
+ *
+ * The work in each run is bounded by a budget counted in propagated variables. All derived
+ * clauses are implied by the clauses in the database, so probing must not be used if clauses are
+ * removed from the database later (e.g., by `Solver::remove_clauses()`).
+ */
+class Probing {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** Simplify clauses in @p db
+     *
+     * @param db clause database
+     * @param trail current solver trail without any assigned variables
+     * @param theory theory used to propagate probed literals
+     * @param listener listener notified before probed literals are backtracked
+     * @param budget maximal number of variables propagated while probing
+     * @return false iff the clauses in @p db are unsatisfiable
+     */
+    bool run(Database& db, Trail& trail, Theory& theory, Event_listener& listener,
+             std::int64_t budget);
+
+    /** Set budget used before each check
+     *
+     * @param budget maximal number of variables propagated before each check
+     */
+    inline void set_preprocess_budget(std::int64_t budget) { preprocess_limit = budget; }
+
+    /** Get budget used before each check
+     *
+     * @return maximal number of variables propagated before each check
+     */
+    inline std::int64_t preprocess_budget() const { return preprocess_limit; }
+
+    /** Set budget used between restarts
+     *
+     * @param budget maximal number of variables propagated in each run between restarts
+     */
+    inline void set_inprocess_budget(std::int64_t budget) { inprocess_limit = budget; }
+
+    /** Get budget used between restarts
+     *
+     * @return maximal number of variables propagated in each run between restarts
+     */
+    inline std::int64_t inprocess_budget() const { return inprocess_limit; }
+
+    /** Set number of restarts between two runs
+     *
+     * @param restarts number of restarts between two runs (0 disables inprocessing)
+     */
+    inline void set_interval(int restarts) { restart_interval = restarts; }
+
+    /** Get number of restarts between two runs
+     *
+     * @return number of restarts between two runs (0 if inprocessing is disabled)
+     */
+    inline int interval() const { return restart_interval; }
+
+    /** Get number of failed literals
+     *
+     * @return number of literals whose propagation led to a conflict
+     */
+    inline int num_failed() const { return num_failed_lits; }
+
+    /** Get number of literals implied by both polarities of a probed variable
+     *
+     * @return number of implied unit clauses
+     */
+    inline int num_implied() const { return num_implied_lits; }
+
+    /** Get number of variables substituted by an equivalent literal
+     *
+     * @return number of substituted variables
+     */
+    inline int num_substituted() const { return num_substituted_vars; }
+
+    /** Get number of variables propagated while probing
+     *
+     * @return total number of propagated variables
+     */
+    inline std::int64_t num_propagations() const { return total_propagations; }
+
+    /** Get total time spent in `run()`
+     *
+     * @return duration of all `run()` calls
+     */
+    inline Clock::duration total_time() const { return time_spent; }
+
+private:
+    // solver components used in a run
+    struct Context {
+        Database& db;
+        Trail& trail;
+        Theory& theory;
+        Event_listener& listener;
+    };
+
+    // map literal -> literals implied by it through a binary clause
+    Literal_map<std::vector<Literal>> implications;
+    // map literal -> its representative in the strongly connected component
+    Literal_map<Literal> repr;
+    // map literal -> DFS index in Tarjan's algorithm (-1 if it has not been visited)
+    Literal_map<int> index;
+    // map literal -> the lowest index reachable from the literal in Tarjan's algorithm
+    Literal_map<int> lowlink;
+    // map literal -> true iff it is on the stack of the current component candidates
+    Literal_map<bool> is_on_stack;
+    // auxiliary bitset of literals
+    Literal_map<bool> marks;
+    // map variable -> true iff it has been substituted by another literal
+    std::vector<bool> is_substituted;
+    // the next variable to probe (probing continues where the previous run stopped)
+    int next_var = 0;
+
+    std::int64_t preprocess_limit = 1'000'000;
+    std::int64_t inprocess_limit = 100'000;
+    int restart_interval = 16;
+
+    // statistics
+    int num_failed_lits = 0;
+    int num_implied_lits = 0;
+    int num_substituted_vars = 0;
+    std::int64_t total_propagations = 0;
+    Clock::duration time_spent{0};
+
+    /** Allocate memory for @p num_vars boolean variables
+     *
+     * @param num_vars number of boolean variables
+     */
+    void resize(int num_vars);
+
+    /** Run all simplifications
+     *
+     * @param ctx solver components
+     * @param budget maximal number of propagated variables
+     * @return false iff a conflict has been found at decision level 0
+     */
+    bool simplify(Context& ctx, std::int64_t budget);
+
+    /** Propagate variables at decision level 0
+     *
+     * @param ctx solver components
+     * @return false iff there is a conflict at decision level 0
+     */
+    bool propagate(Context& ctx);
+
+    /** Build `implications` from binary clauses which are not satisfied at decision level 0
+     *
+     * @param ctx solver components
+     */
+    void build_implication_graph(Context& ctx);
+
+    /** Compute `repr` using Tarjan's algorithm on `implications`
+     *
+     * @param num_vars number of boolean variables
+     * @return number of newly substituted variables or -1 if some literal is equivalent to its
+     * negation
+     */
+    int find_equivalences(int num_vars);
+
+    /** Replace literals in all clauses in @p db by their representatives
+     *
+     * @param db clause database
+     */
+    void substitute(Database& db);
+
+    /** Probe both literals of variable @p var_ord
+     *
+     * @param ctx solver components
+     * @param var_ord ordinal of an unassigned boolean variable
+     * @param budget remaining budget which is decreased by the number of propagated variables
+     * @return false iff a conflict has been found at decision level 0
+     */
+    bool probe(Context& ctx, int var_ord, std::int64_t& budget);
+
+    /** Decide @p lit at decision level 1 and propagate it
+     *
+     * @param ctx solver components
+     * @param lit unassigned literal
+     * @param budget remaining budget which is decreased by the number of propagated variables
+     * @return true iff there is a conflict
+     */
+    bool assume(Context& ctx, Literal lit, std::int64_t& budget);
+
+    /** Backtrack probed literal
+     *
+     * @param ctx solver components
+     */
+    void backtrack(Context& ctx);
+
+    /** Learn unit clause @p lit and propagate it at decision level 0
+     *
+     * @param ctx solver components
+     * @param lit literal implied by the clauses in database
+     * @return false iff there is a conflict at decision level 0
+     */
+    bool fix(Context& ctx, Literal lit);
+};
+
+} // namespace yaga
+
+#endif // YAGA_PROBING_H
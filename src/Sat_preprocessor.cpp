@@ -0,0 +1,426 @@
+#include "Sat_preprocessor.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <numeric>
+
+namespace yaga {
+
+std::uint64_t Sat_preprocessor::signature(Clause const& lits)
+{
+    Literal_hash hash;
+
+    constexpr std::uint64_t MOD64 = (1 << 6) - 1; // bitmask for mod 64
+    std::uint64_t sig = 0;
+    for (auto lit : lits)
+    {
+        sig |= 1UL << (hash(lit) & MOD64);
+    }
+    return sig;
+}
+
+void Sat_preprocessor::add_clause(Clause&& lits)
+{
+    // remove duplicate and false literals, drop tautologies and satisfied clauses
+    std::sort(lits.begin(), lits.end(), Literal_comparer{});
+    lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+    for (std::size_t i = 0; i + 1 < lits.size(); ++i)
+    {
+        if (lits[i].var() == lits[i + 1].var())
+        {
+            return;
+        }
+    }
+
+    if (std::any_of(lits.begin(), lits.end(), [&](auto lit) { return value(lit) > 0; }))
+    {
+        return;
+    }
+    std::erase_if(lits, [&](auto lit) { return value(lit) < 0; });
+
+    if (lits.empty())
+    {
+        is_unsat = true;
+    }
+    else if (lits.size() == 1)
+    {
+        assign(lits.front());
+    }
+    else
+    {
+        int index = static_cast<int>(clauses.size());
+        for (auto lit : lits)
+        {
+            occur[lit].push_back(index);
+        }
+        auto sig = signature(lits);
+        clauses.push_back(Entry{std::move(lits), sig, false});
+        is_queued.push_back(false);
+        enqueue(index);
+    }
+}
+
+void Sat_preprocessor::remove_clause(int index)
+{
+    // occurrence lists are cleaned lazily
+    clauses[index].is_removed = true;
+    clauses[index].lits = Clause{};
+}
+
+void Sat_preprocessor::assign(Literal lit)
+{
+    if (value(lit) < 0)
+    {
+        is_unsat = true;
+    }
+    else if (value(lit) == 0)
+    {
+        values[lit.var().ord()] = lit.is_negation() ? -1 : 1;
+        units.push_back(lit);
+    }
+}
+
+void Sat_preprocessor::propagate()
+{
+    for (; num_propagated < units.size() && !is_unsat; ++num_propagated)
+    {
+        Literal lit = units[num_propagated];
+        for (int index : occur[lit])
+        {
+            if (!clauses[index].is_removed)
+            {
+                remove_clause(index);
+            }
+        }
+        occur[lit].clear();
+
+        auto false_occur = std::move(occur[~lit]);
+        occur[~lit].clear();
+        for (int index : false_occur)
+        {
+            if (!clauses[index].is_removed && !is_unsat)
+            {
+                strengthen(index, ~lit);
+            }
+        }
+    }
+}
+
+void Sat_preprocessor::strengthen(int index, Literal lit)
+{
+    auto& entry = clauses[index];
+    auto it = std::find(entry.lits.begin(), entry.lits.end(), lit);
+    assert(it != entry.lits.end());
+    entry.lits.erase(it);
+    std::erase(occur[lit], index);
+
+    if (entry.lits.size() == 1)
+    {
+        Literal unit = entry.lits.front();
+        remove_clause(index);
+        assign(unit);
+    }
+    else
+    {
+        assert(!entry.lits.empty());
+        entry.sig = signature(entry.lits);
+        enqueue(index);
+    }
+}
+
+void Sat_preprocessor::enqueue(int index)
+{
+    if (!is_queued[index])
+    {
+        is_queued[index] = true;
+        subsumption_queue.push_back(index);
+    }
+}
+
+Sat_preprocessor::Subset Sat_preprocessor::check_subset(Entry const& first, Entry const& second,
+                                                        Literal& lit)
+{
+    // all literals of `first` except at most one occur in `second`, so the signatures can differ
+    // in at most one bit
+    if (first.lits.size() > second.lits.size() || std::popcount(first.sig & ~second.sig) > 1)
+    {
+        return Subset::none;
+    }
+
+    for (auto l : second.lits)
+    {
+        marks[l] = true;
+    }
+
+    auto result = Subset::subsumes;
+    for (auto l : first.lits)
+    {
+        if (marks[l])
+        {
+            continue;
+        }
+
+        if (marks[~l] && result == Subset::subsumes)
+        {
+            result = Subset::strengthens;
+            lit = ~l;
+        }
+        else
+        {
+            result = Subset::none;
+            break;
+        }
+    }
+
+    for (auto l : second.lits)
+    {
+        marks[l] = false;
+    }
+    return result;
+}
+
+void Sat_preprocessor::backward_subsume()
+{
+    while (!subsumption_queue.empty() && !is_unsat)
+    {
+        int index = subsumption_queue.back();
+        subsumption_queue.pop_back();
+        is_queued[index] = false;
+        if (clauses[index].is_removed || clauses[index].lits.size() > max_subsuming_size)
+        {
+            continue;
+        }
+
+        // each clause subsumed or strengthened by this clause contains the variable of `best`
+        auto const& lits = clauses[index].lits;
+        auto num_occurrences = [&](Literal lit) { return occur[lit].size() + occur[~lit].size(); };
+        Literal best = *std::min_element(lits.begin(), lits.end(), [&](auto lhs, auto rhs) {
+            return num_occurrences(lhs) < num_occurrences(rhs);
+        });
+
+        for (Literal candidate_lit : {best, ~best})
+        {
+            // the list can change when a clause is strengthened
+            auto candidates = occur[candidate_lit];
+            for (int other : candidates)
+            {
+                if (other == index || clauses[other].is_removed || clauses[index].is_removed)
+                {
+                    continue;
+                }
+
+                Literal lit;
+                auto result = check_subset(clauses[index], clauses[other], lit);
+                if (result == Subset::subsumes)
+                {
+                    remove_clause(other);
+                    ++num_subsumed_clauses;
+                }
+                else if (result == Subset::strengthens)
+                {
+                    strengthen(other, lit);
+                    ++num_strengthened_clauses;
+                    propagate();
+                    if (is_unsat)
+                    {
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool Sat_preprocessor::resolve(Clause const& first, Clause const& second, Literal pivot,
+                               Clause& out)
+{
+    out.clear();
+    for (auto lit : first)
+    {
+        if (lit != pivot)
+        {
+            marks[lit] = true;
+            out.push_back(lit);
+        }
+    }
+
+    bool is_tautology = false;
+    for (auto lit : second)
+    {
+        if (lit == ~pivot || marks[lit])
+        {
+            continue;
+        }
+
+        if (marks[~lit])
+        {
+            is_tautology = true;
+            break;
+        }
+        out.push_back(lit);
+    }
+
+    for (auto lit : first)
+    {
+        marks[lit] = false;
+    }
+    return !is_tautology;
+}
+
+bool Sat_preprocessor::eliminate(Variable var)
+{
+    Literal pos{var.ord()};
+    Literal neg = ~pos;
+    for (auto lit : {pos, neg})
+    {
+        std::erase_if(occur[lit], [&](int index) { return clauses[index].is_removed; });
+    }
+
+    auto const& pos_occur = occur[pos];
+    auto const& neg_occur = occur[neg];
+    std::size_t num_clauses = pos_occur.size() + neg_occur.size();
+    if (num_clauses == 0 || num_clauses > max_occurrences)
+    {
+        return false;
+    }
+
+    // the variable is eliminated only if it does not increase the number of clauses
+    std::vector<Clause> resolvents;
+    Clause resolvent;
+    for (int pos_index : pos_occur)
+    {
+        for (int neg_index : neg_occur)
+        {
+            if (resolve(clauses[pos_index].lits, clauses[neg_index].lits, pos, resolvent))
+            {
+                if (resolvents.size() == num_clauses || resolvent.size() > max_resolvent_size)
+                {
+                    return false;
+                }
+                resolvents.push_back(resolvent);
+            }
+        }
+    }
+
+    // clauses of the polarity with fewer occurrences and a unit clause of the opposite literal
+    // are enough to reconstruct the value of the variable
+    Literal pivot = pos_occur.size() <= neg_occur.size() ? pos : neg;
+    for (int index : occur[pivot])
+    {
+        auto& saved = elim_clauses.emplace_back(clauses[index].lits);
+        std::iter_swap(saved.begin(), std::find(saved.begin(), saved.end(), pivot));
+    }
+    elim_clauses.push_back(Clause{~pivot});
+
+    for (auto lit : {pos, neg})
+    {
+        for (int index : occur[lit])
+        {
+            remove_clause(index);
+        }
+        occur[lit].clear();
+    }
+    is_eliminated[var.ord()] = true;
+    ++num_eliminated_vars;
+
+    for (auto& clause : resolvents)
+    {
+        add_clause(std::move(clause));
+    }
+    return true;
+}
+
+bool Sat_preprocessor::simplify(Database& db, int num_vars)
+{
+    auto start = Clock::now();
+    clauses.clear();
+    occur = Literal_map<std::vector<int>>(num_vars);
+    marks = Literal_map<bool>(num_vars, false);
+    values.assign(num_vars, 0);
+    units.clear();
+    num_propagated = 0;
+    subsumption_queue.clear();
+    is_queued.clear();
+    is_eliminated.assign(num_vars, false);
+    elim_clauses.clear();
+    is_unsat = false;
+    clauses_before = db.asserted().size();
+
+    for (auto const& clause : db.asserted())
+    {
+        add_clause(Clause{clause});
+    }
+    propagate();
+    backward_subsume();
+
+    // try variables with fewer occurrences first
+    std::vector<int> order(num_vars);
+    std::iota(order.begin(), order.end(), 0);
+    auto cost = [&](int var_ord) {
+        Literal lit{var_ord};
+        return occur[lit].size() * occur[~lit].size();
+    };
+    std::vector<std::size_t> costs(num_vars);
+    for (int var_ord = 0; var_ord < num_vars; ++var_ord)
+    {
+        costs[var_ord] = cost(var_ord);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int lhs, int rhs) { return costs[lhs] < costs[rhs]; });
+
+    for (int var_ord : order)
+    {
+        if (is_unsat)
+        {
+            break;
+        }
+
+        if (values[var_ord] == 0 && eliminate(Variable{var_ord, Variable::boolean}))
+        {
+            propagate();
+            backward_subsume();
+        }
+    }
+
+    if (!is_unsat)
+    {
+        // replace asserted clauses by the simplified clauses
+        db.asserted().clear();
+        for (auto lit : units)
+        {
+            db.assert_clause(Clause{lit});
+        }
+
+        for (auto& entry : clauses)
+        {
+            if (!entry.is_removed)
+            {
+                db.assert_clause(std::move(entry.lits));
+            }
+        }
+        clauses_after = db.asserted().size();
+    }
+
+    // free memory which is not needed for model reconstruction
+    clauses = {};
+    occur = Literal_map<std::vector<int>>{};
+    subsumption_queue = {};
+    is_queued = {};
+    time_spent += Clock::now() - start;
+    return !is_unsat;
+}
+
+void Sat_preprocessor::extend(Model<bool>& model) const
+{
+    for (auto it = elim_clauses.rbegin(); it != elim_clauses.rend(); ++it)
+    {
+        if (eval(model, *it) != true)
+        {
+            Literal pivot = it->front();
+            model.set_value(pivot.var().ord(), !pivot.is_negation());
+        }
+    }
+}
+
+} // namespace yaga
@@ -0,0 +1,230 @@
+#ifndef YAGA_SAT_PREPROCESSOR_H
+#define YAGA_SAT_PREPROCESSOR_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Literal.h"
+#include "Literal_map.h"
+#include "Model.h"
+#include "Variable.h"
+
+namespace yaga {
+
+/** Simplification of asserted boolean clauses before search.
+ *
+ * The preprocessor runs:
+ *  - unit propagation at decision level 0 and removal of tautologies,
+ *  - backward subsumption and self-subsuming strengthening using occurrence lists,
+ *  - bounded variable elimination: a variable is replaced by all non-tautological resolvents of
+ *    clauses in which it occurs if it does not increase the number of clauses.
+ *
+ * The simplified clauses are only equisatisfiable with the original clauses. Models of the
+ * simplified clauses have to be extended by `extend()` to satisfy the original clauses. Since
+ * eliminated variables disappear from the clauses, the preprocessor cannot be used if clauses
+ * are added later or if eliminated variables are used in assumptions.
+ */
+class Sat_preprocessor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** Simplify asserted clauses in @p db
+     *
+     * @param db database with boolean clauses which are replaced by the simplified clauses
+     * @param num_vars number of boolean variables
+     * @return false iff the clauses are unsatisfiable (the database is left unchanged in this case)
+     */
+    bool simplify(Database& db, int num_vars);
+
+    /** Assign values to eliminated variables so that @p model satisfies the original clauses
+     *
+     * @param model model which satisfies the simplified clauses
+     */
+    void extend(Model<bool>& model) const;
+
+    /** Get number of eliminated variables
+     *
+     * @return number of variables removed by bounded variable elimination
+     */
+    inline int num_eliminated() const { return num_eliminated_vars; }
+
+    /** Get number of clauses removed because they were subsumed by another clause
+     *
+     * @return number of subsumed clauses
+     */
+    inline int num_subsumed() const { return num_subsumed_clauses; }
+
+    /** Get number of literals removed by self-subsuming resolution
+     *
+     * @return number of strengthened clauses
+     */
+    inline int num_strengthened() const { return num_strengthened_clauses; }
+
+    /** Get number of asserted clauses before the last `simplify()`
+     *
+     * @return number of input clauses
+     */
+    inline std::size_t num_clauses_before() const { return clauses_before; }
+
+    /** Get number of asserted clauses after the last `simplify()`
+     *
+     * @return number of simplified clauses
+     */
+    inline std::size_t num_clauses_after() const { return clauses_after; }
+
+    /** Get total time spent in `simplify()`
+     *
+     * @return duration of all `simplify()` calls
+     */
+    inline Clock::duration total_time() const { return time_spent; }
+
+private:
+    // clause with its signature (see `Subsumption`)
+    struct Entry {
+        Clause lits;
+        std::uint64_t sig = 0;
+        bool is_removed = false;
+    };
+
+    // result of `check_subset()`
+    enum class Subset {
+        none,
+        subsumes,
+        strengthens,
+    };
+
+    // variables whose elimination would produce a longer resolvent are not eliminated
+    static constexpr std::size_t max_resolvent_size = 20;
+    // variables with more occurrences are not eliminated
+    static constexpr std::size_t max_occurrences = 200;
+    // longer clauses are not used to subsume or strengthen other clauses
+    static constexpr std::size_t max_subsuming_size = 100;
+
+    // working copy of asserted clauses
+    std::vector<Entry> clauses;
+    // map literal -> indices of clauses in which it occurs (including removed clauses)
+    Literal_map<std::vector<int>> occur;
+    // auxiliary bitset for subset tests and resolution
+    Literal_map<bool> marks;
+    // map variable -> value fixed at level 0 (1 for true, -1 for false, 0 if it is not fixed)
+    std::vector<std::int8_t> values;
+    // literals fixed at level 0 in the order in which they were fixed
+    std::vector<Literal> units;
+    // number of `units` whose consequences have been propagated
+    std::size_t num_propagated = 0;
+    // clauses which should be used for backward subsumption
+    std::vector<int> subsumption_queue;
+    // map clause index -> true iff it is in `subsumption_queue`
+    std::vector<bool> is_queued;
+    // map variable -> true iff it has been eliminated
+    std::vector<bool> is_eliminated;
+    // clauses removed by elimination (first literal is the pivot) in the order of elimination
+    std::vector<Clause> elim_clauses;
+    // true iff an empty clause has been derived
+    bool is_unsat = false;
+
+    // statistics
+    int num_eliminated_vars = 0;
+    int num_subsumed_clauses = 0;
+    int num_strengthened_clauses = 0;
+    std::size_t clauses_before = 0;
+    std::size_t clauses_after = 0;
+    Clock::duration time_spent{0};
+
+    /** Get value of @p lit fixed at level 0
+     *
+     * @param lit literal
+     * @return 1 if @p lit is true, -1 if it is false, 0 otherwise
+     */
+    inline int value(Literal lit) const
+    {
+        int val = values[lit.var().ord()];
+        return lit.is_negation() ? -val : val;
+    }
+
+    /** Compute signature of @p lits
+     *
+     * @param lits clause
+     * @return 64-bit mask with one bit for each literal in @p lits
+     */
+    static std::uint64_t signature(Clause const& lits);
+
+    /** Normalize @p lits and add it to the working copy
+     *
+     * Tautologies and clauses satisfied at level 0 are dropped, false literals and duplicate
+     * literals are removed, and unit clauses are propagated.
+     *
+     * @param lits new clause
+     */
+    void add_clause(Clause&& lits);
+
+    /** Mark clause @p index as removed
+     *
+     * @param index index of a clause in `clauses`
+     */
+    void remove_clause(int index);
+
+    /** Fix value of @p lit at level 0
+     *
+     * @param lit literal which has to be true
+     */
+    void assign(Literal lit);
+
+    /** Remove clauses satisfied by fixed literals and false literals from other clauses
+     */
+    void propagate();
+
+    /** Remove @p lit from clause @p index
+     *
+     * @param index index of a clause in `clauses`
+     * @param lit literal in the clause
+     */
+    void strengthen(int index, Literal lit);
+
+    /** Add clause @p index to `subsumption_queue` if it is not there already
+     *
+     * @param index index of a clause in `clauses`
+     */
+    void enqueue(int index);
+
+    /** Check whether @p first subsumes @p second or whether @p second can be strengthened by
+     * self-subsuming resolution with @p first
+     *
+     * @param first first clause
+     * @param second second clause
+     * @param lit set to the literal which can be removed from @p second if the result is
+     * `Subset::strengthens`
+     * @return result of the check
+     */
+    Subset check_subset(Entry const& first, Entry const& second, Literal& lit);
+
+    /** Remove clauses subsumed by clauses in `subsumption_queue` and strengthen clauses using
+     * self-subsuming resolution until the queue is empty
+     */
+    void backward_subsume();
+
+    /** Compute resolvent of @p first and @p second on variable of @p pivot
+     *
+     * @param first clause which contains @p pivot
+     * @param second clause which contains negation of @p pivot
+     * @param pivot resolved literal
+     * @param out resolvent (only valid if the function returns true)
+     * @return false iff the resolvent is a tautology
+     */
+    bool resolve(Clause const& first, Clause const& second, Literal pivot, Clause& out);
+
+    /** Eliminate @p var if it does not increase the number of clauses
+     *
+     * @param var boolean variable
+     * @return true iff @p var has been eliminated
+     */
+    bool eliminate(Variable var);
+};
+
+} // namespace yaga
+
+#endif // YAGA_SAT_PREPROCESSOR_H
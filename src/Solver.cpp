@@ -1,18 +1,41 @@
 #include "Solver.h"
+#include "Literal_map.h"
 #include <iostream>
 
 namespace yaga {
 
+namespace {
+
+auto& analysis_timer = Statistics::global().timer("conflict_analysis");
+auto& lbd_histogram = Statistics::global().histogram("learned.lbd");
+auto& size_histogram = Statistics::global().histogram("learned.size");
+auto& backjump_histogram = Statistics::global().histogram("conflict.backjump_distance");
+auto& trail_histogram = Statistics::global().histogram("conflict.trail_size");
+auto& unknown_counter = Statistics::global().counter("solver.unknown");
+auto& reduction_counter = Statistics::global().counter("solver.memory_reductions");
+auto& removed_counter = Statistics::global().counter("solver.removed_clauses");
+
+// minimal number of learned clauses added since the last reduction of memory to reduce it again
+constexpr std::size_t min_reduction = 100;
+
+} // namespace
+
 Solver::Solver() : solver_trail(dispatcher)
 {
     subsumption = std::make_unique<Subsumption>();
     dispatcher.add(subsumption.get());
 }
 
-std::vector<Clause> Solver::propagate() { return theory()->propagate(database, solver_trail); }
+std::vector<Clause> Solver::propagate()
+{
+    Trace_scope trace{Trace_event::propagate, trail().decision_level()};
+    return theory()->propagate(database, solver_trail);
+}
 
 std::pair<std::vector<Clause>, int> Solver::analyze_conflicts(std::vector<Clause>&& conflicts)
 {
+    Scoped_timer timer{analysis_timer};
+    Trace_scope trace{Trace_event::analyze, static_cast<int>(conflicts.size())};
     ++total_conflicts;
     std::vector<Clause> learned;
     int level = std::numeric_limits<int>::max();
@@ -47,6 +70,8 @@ std::pair<std::vector<Clause>, int> Solver::analyze_conflicts(std::vector<Clause
 }
 std::pair<std::vector<Clause>, int> Solver::analyze_conflicts_with_vars(std::vector<Clause>&& conflicts, const std::vector<Variable>& model)
 {
+    Scoped_timer timer{analysis_timer};
+    Trace_scope trace{Trace_event::analyze, static_cast<int>(conflicts.size())};
     ++total_conflicts;
     std::vector<Clause> learned;
     int level = std::numeric_limits<int>::max();
@@ -81,6 +106,8 @@ std::pair<std::vector<Clause>, int> Solver::analyze_conflicts_with_vars(std::vec
 }
 std::pair<std::vector<Clause>, int> Solver::analyze_final(std::vector<Clause>&& conflicts, const std::vector<Variable>& vars_to_skip)
 {
+    Scoped_timer timer{analysis_timer};
+    Trace_scope trace{Trace_event::analyze, static_cast<int>(conflicts.size())};
    ++total_conflicts;
     std::vector<Clause> learned;
     int level = std::numeric_limits<int>::max();
@@ -116,6 +143,7 @@ std::pair<std::vector<Clause>, int> Solver::analyze_final(std::vector<Clause>&&
 
 Solver::Clause_range Solver::learn(std::vector<Clause>&& clauses)
 {
+    Trace_scope trace{Trace_event::learn, static_cast<int>(clauses.size())};
     // remove duplicate clauses
     std::sort(clauses.begin(), clauses.end(), [](auto const& lhs, auto const& rhs) {
         if (lhs.size() < rhs.size())
@@ -146,8 +174,14 @@ Solver::Clause_range Solver::learn(std::vector<Clause>&& clauses)
     for (auto const& clause : clauses)
     {
         ++total_learned_clauses;
+        int lbd = statistics_enabled || vivification_pass ? compute_lbd(clause) : 0;
+        record_learned(clause, lbd);
         // add the clause to database
         auto& learned_ref = db().learn_clause(std::move(clause));
+        if (vivification_pass)
+        {
+            vivification_pass->add_candidate(learned_ref, lbd);
+        }
         // trigger events
         dispatcher.on_learned_clause(db(), trail(), learned_ref);
     }
@@ -155,6 +189,35 @@ Solver::Clause_range Solver::learn(std::vector<Clause>&& clauses)
             db().learned().end()};
 }
 
+int Solver::compute_lbd(Clause const& clause)
+{
+    lbd_levels.clear();
+    for (auto lit : clause)
+    {
+        lbd_levels.push_back(trail().decision_level(lit.var()).value_or(0));
+    }
+    std::sort(lbd_levels.begin(), lbd_levels.end());
+    return static_cast<int>(std::unique(lbd_levels.begin(), lbd_levels.end()) - lbd_levels.begin());
+}
+
+void Solver::record_learned(Clause const& clause, int lbd)
+{
+    if constexpr (statistics_enabled)
+    {
+        lbd_histogram.record(lbd);
+        size_histogram.record(clause.size());
+    }
+}
+
+void Solver::record_conflict(int level)
+{
+    if constexpr (statistics_enabled)
+    {
+        trail_histogram.record(trail().num_assigned());
+        backjump_histogram.record(trail().decision_level() - level);
+    }
+}
+
 bool Solver::is_semantic_split(Clause const& clause) const
 {
     return clause.size() >= 2 && trail().decision_level(clause[0].var()).value() ==
@@ -163,6 +226,7 @@ bool Solver::is_semantic_split(Clause const& clause) const
 
 void Solver::backtrack_with(Clause_range clauses, int level)
 {
+    Trace_scope trace{Trace_event::backtrack, level};
     dispatcher.on_before_backtrack(db(), trail(), level);
 
     auto& model = trail().model<bool>(Variable::boolean);
@@ -219,12 +283,173 @@ std::optional<Variable> Solver::pick_variable() { return variable_order->pick(db
 
 void Solver::decide(Variable var)
 {
+    Trace_scope trace{Trace_event::decide, trail().decision_level() + 1};
     ++total_decisions;
     theory()->decide(db(), trail(), var);
 }
 
+std::optional<Literal> Solver::next_assumption(std::span<Literal const> assumptions) const
+{
+    auto const& model = trail().model<bool>(Variable::boolean);
+    for (auto lit : assumptions)
+    {
+        if (eval(model, lit) != true)
+        {
+            return lit;
+        }
+    }
+    return {}; // all assumptions are true
+}
+
+std::optional<std::vector<Literal>>
+Solver::analyze_assumptions(std::span<Literal const> assumptions, Literal lit)
+{
+    assert(eval(trail().model<bool>(Variable::boolean), lit) == false);
+
+    Literal_map<bool> is_assumption(num_bool_vars, false);
+    for (auto assumption : assumptions)
+    {
+        is_assumption[assumption] = true;
+    }
+
+    std::vector<bool> is_marked(num_bool_vars, false);
+    is_marked[lit.var().ord()] = true;
+
+    std::vector<Literal> core{lit};
+    int blocking_level = -1;
+    auto const& model = trail().model<bool>(Variable::boolean);
+    for (int level = trail().decision_level(lit.var()).value(); level > 0; --level)
+    {
+        auto const& assigned = trail().assigned(level);
+        for (auto it = assigned.rbegin(); it != assigned.rend(); ++it)
+        {
+            auto [var, reason] = *it;
+            if (var.type() != Variable::boolean || !is_marked[var.ord()])
+            {
+                continue;
+            }
+
+            auto var_lit = model.value(var.ord()) ? Literal{var.ord()} : ~Literal{var.ord()};
+            if (reason != nullptr) // resolve with the reason clause
+            {
+                for (auto other : *reason)
+                {
+                    if (other.var() != var)
+                    {
+                        is_marked[other.var().ord()] = true;
+                    }
+                }
+            }
+            else if (it + 1 == assigned.rend() && is_assumption[var_lit]) // assumption decision
+            {
+                core.push_back(var_lit);
+            }
+            else // decision or semantic propagation which is not an assumption
+            {
+                blocking_level = level;
+            }
+        }
+    }
+
+    if (blocking_level > 0)
+    {
+        // decide assumptions before the blocking decision and try again
+        backtrack(blocking_level - 1);
+        return {};
+    }
+    return core;
+}
+
+void Solver::backtrack(int level)
+{
+    dispatcher.on_before_backtrack(db(), trail(), level);
+    trail().backtrack(level);
+}
+
+std::vector<Literal> const& Solver::minimize_failed_assumptions(std::span<Literal const> fixed)
+{
+    Literal_map<bool> is_marked(num_bool_vars, false);
+    for (auto lit : fixed)
+    {
+        is_marked[lit] = true;
+    }
+
+    std::vector<Literal> candidates;
+    for (auto lit : failed)
+    {
+        if (!is_marked[lit])
+        {
+            candidates.push_back(lit);
+        }
+    }
+    is_marked.assign(false);
+
+    std::vector<Literal> required;
+    std::vector<Literal> assumptions;
+    while (!candidates.empty())
+    {
+        Literal lit = candidates.back();
+        candidates.pop_back();
+
+        assumptions.assign(fixed.begin(), fixed.end());
+        assumptions.insert(assumptions.end(), required.begin(), required.end());
+        assumptions.insert(assumptions.end(), candidates.begin(), candidates.end());
+        if (check(assumptions) == Result::unsat)
+        {
+            // keep only candidates which are necessary for the new conflict
+            for (auto other : failed)
+            {
+                is_marked[other] = true;
+            }
+            std::erase_if(candidates, [&](auto other) { return !is_marked[other]; });
+            for (auto other : failed)
+            {
+                is_marked[other] = false;
+            }
+        }
+        else // lit is necessary (or the check ran out of budget)
+        {
+            required.push_back(lit);
+        }
+    }
+    failed = std::move(required);
+    return failed;
+}
+
+void Solver::remove_clauses(std::span<Literal const> literals)
+{
+    // unassign all variables so that no plugin refers to a removed clause
+    if (!trail().empty())
+    {
+        dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
+        trail().clear();
+    }
+
+    Literal_map<bool> is_removed(trail().model<bool>(Variable::boolean).num_vars(), false);
+    for (auto lit : literals)
+    {
+        is_removed[lit] = true;
+    }
+
+    for (auto clauses : {&db().asserted(), &db().learned()})
+    {
+        clauses->erase(std::remove_if(clauses->begin(), clauses->end(), [&](auto const& clause) {
+            return std::any_of(clause.begin(), clause.end(), [&](auto lit) { 
+                return is_removed[lit]; 
+            });
+        }), clauses->end());
+    }
+}
+
 void Solver::init()
 {
+    // unassign all variables from the previous check
+    if (!trail().empty())
+    {
+        dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
+        trail().clear();
+    }
+
     // allocate memory
     for (auto [type, model] : trail().models())
     {
@@ -237,26 +462,169 @@ void Solver::init()
 
     // reset solver state
     total_conflicts = 0;
+    total_conflict_clauses = 0;
+    total_learned_clauses = 0;
     total_decisions = 0;
     total_restarts = 0;
-    dispatcher.on_init(db(), trail());
+    failed.clear();
+    start_propagations = trail().num_propagations();
+    start_time = std::chrono::steady_clock::now();
+    num_budget_polls = 0;
+    is_memory_low = false;
+    if (vivification_pass)
+    {
+        vivification_pass->reset();
+    }
+
+    if (!is_initialized)
+    {
+        dispatcher.on_init(db(), trail());
+        is_initialized = true;
+    }
+}
+
+bool Solver::is_out_of_budget()
+{
+    bool is_out = false;
+    if (interrupt_flag->load(std::memory_order_relaxed))
+    {
+        interrupt_flag->store(false, std::memory_order_relaxed);
+        is_out = true;
+    }
+    else if (check_budget.conflicts > 0 && total_conflicts >= check_budget.conflicts)
+    {
+        is_out = true;
+    }
+    else if (check_budget.propagations > 0 &&
+             trail().num_propagations() - start_propagations >= check_budget.propagations)
+    {
+        is_out = true;
+    }
+    // reading the clock and memory usage is more expensive so it is done periodically (starting
+    // with the first poll)
+    else if (auto poll = num_budget_polls++; poll % 64 == 0)
+    {
+        is_out = check_budget.time.count() > 0 &&
+                 std::chrono::steady_clock::now() - start_time >= check_budget.time;
+        if (!is_out && check_budget.memory > 0 && poll % 1024 == 0)
+        {
+            auto limit = static_cast<std::size_t>(check_budget.memory) << 20;
+            auto memory = resident_memory();
+            is_out = memory >= limit;
+            // remove learned clauses on the next restart if enough of them have been added since
+            // the last reduction
+            auto num_learned = db().learned().size();
+            is_memory_low = memory >= limit / 4 * 3 &&
+                            num_learned >= 2 * num_learned_after_reduction + min_reduction;
+        }
+    }
+
+    if (is_out)
+    {
+        unknown_counter.add(1);
+    }
+    return is_out;
 }
 
-void Solver::restart()
+bool Solver::restart()
 {
+    Trace_scope trace{Trace_event::restart, static_cast<int>(total_restarts)};
     dispatcher.on_before_backtrack(db(), trail(), /*decision_level=*/0);
 
     ++total_restarts;
     trail().clear();
 
+    // learned clauses cannot be removed before vivification
+    if (vivification_pass && !vivification_pass->run(db(), trail(), *theory(), dispatcher))
+    {
+        return false;
+    }
+
+    // theories remove data which are not referenced by the remaining clauses in `on_restart()`
+    if (is_memory_low)
+    {
+        reduce_memory();
+    }
+
     dispatcher.on_restart(db(), trail());
+
+    if (probing_pass && probing_pass->interval() > 0 &&
+        total_restarts % probing_pass->interval() == 0)
+    {
+        return probe(probing_pass->inprocess_budget());
+    }
+    return true;
+}
+
+void Solver::reduce_memory()
+{
+    assert(trail().empty());
+    is_memory_low = false;
+    reduction_counter.add(1);
+
+    // binary clauses are cheap, so only remove the longer half of other clauses (older clauses
+    // first if they have the same size)
+    std::vector<Clause*> candidates;
+    for (auto& clause : db().learned())
+    {
+        if (clause.size() > 2)
+        {
+            candidates.push_back(&clause);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](auto lhs, auto rhs) { return lhs->size() > rhs->size(); });
+    candidates.resize(candidates.size() / 2);
+    for (auto clause : candidates)
+    {
+        clause->clear();
+    }
+
+    auto& learned = db().learned();
+    learned.erase(std::remove_if(learned.begin(), learned.end(),
+                                 [](auto const& clause) { return clause.empty(); }),
+                  learned.end());
+    learned.shrink_to_fit();
+    removed_counter.add(candidates.size());
+    num_learned_after_reduction = learned.size();
+}
+
+Memory_usage Solver::memory_usage() const
+{
+    Memory_usage usage;
+    db().memory_usage(usage);
+    trail().memory_usage(usage);
+    if (solver_theory)
+    {
+        solver_theory->memory_usage(usage);
+    }
+    usage.add("long_fraction.mpq_pool", Rational::pool_memory_usage());
+    return usage;
+}
+
+bool Solver::probe(std::int64_t budget)
+{
+    auto arg = std::min<std::int64_t>(budget, std::numeric_limits<std::int32_t>::max());
+    Trace_scope trace{Trace_event::probe, static_cast<int>(arg)};
+    return probing_pass->run(db(), trail(), *theory(), dispatcher, budget);
 }
-Solver::Result Solver::check()
+
+Solver::Result Solver::check(std::span<Literal const> assumptions)
 {
+    Trace_scope trace{Trace_event::check, static_cast<int>(assumptions.size())};
     init();
+    if (probing_pass && !probe(probing_pass->preprocess_budget()))
+    {
+        return Result::unsat;
+    }
 
     for (;;)
     {
+        if (is_out_of_budget())
+        {
+            return Result::unknown;
+        }
+
         auto conflicts = propagate();
         if (!conflicts.empty())
         {
@@ -271,16 +639,38 @@ Solver::Result Solver::check()
                 return Result::unsat;
             }
 
+            record_conflict(level);
             auto clauses = learn(std::move(learned));
-            if (restart_policy->should_restart())
+            if (restart_policy->should_restart() || is_memory_low)
             {
-                restart();
+                if (!restart())
+                {
+                    return Result::unsat;
+                }
             }
             else // backtrack instead of restarting
             {
                 backtrack_with(clauses, level);
             }
         }
+        else if (auto lit = next_assumption(assumptions)) // decide assumptions first
+        {
+            auto& model = trail().model<bool>(Variable::boolean);
+            if (eval(model, lit.value()) == false)
+            {
+                if (auto core = analyze_assumptions(assumptions, lit.value()))
+                {
+                    failed = std::move(core.value());
+                    return Result::unsat;
+                }
+            }
+            else
+            {
+                ++total_decisions;
+                trail().decide(lit->var());
+                model.set_value(lit->var().ord(), !lit->is_negation());
+            }
+        }
         else // no conflict
         {
             auto var = pick_variable();
@@ -294,6 +684,7 @@ Solver::Result Solver::check()
 }
 std::pair<Solver::Result, std::vector<Clause>> Solver::check_with_model(const std::unordered_map<Variable, std::shared_ptr<Value>, Variable_hash>& model)
 {
+    Trace_scope trace{Trace_event::check};
     init();
     std::vector<Variable> vars;
 
@@ -303,6 +694,11 @@ std::pair<Solver::Result, std::vector<Clause>> Solver::check_with_model(const st
 
     for (;;)
     {
+        if (is_out_of_budget())
+        {
+            return std::make_pair(Result::unknown, std::vector<Clause>{});
+        }
+
         auto conflicts = propagate();
         if (!conflicts.empty())
         {
@@ -318,10 +714,14 @@ std::pair<Solver::Result, std::vector<Clause>> Solver::check_with_model(const st
                 return std::make_pair(Result::unsat, i.first);
             }
 
+            record_conflict(level);
             auto clauses = learn(std::move(learned));
-            if (restart_policy->should_restart())
+            if (restart_policy->should_restart() || is_memory_low)
             {
-                restart();
+                if (!restart())
+                {
+                    return std::make_pair(Result::unsat, std::vector<Clause>{});
+                }
             }
             else // backtrack instead of restarting
             {
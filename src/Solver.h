@@ -3,8 +3,13 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <concepts>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <type_traits>
 #include <vector>
 #include <ranges>
@@ -16,12 +21,17 @@
 #include "Event_listener.h"
 #include "Evsids.h"
 #include "Long_fraction.h"
+#include "Memory.h"
+#include "Probing.h"
 #include "Restart.h"
+#include "Statistics.h"
 #include "Subsumption.h"
 #include "Theory.h"
+#include "Trace.h"
 #include "Trail.h"
 #include "Variable.h"
 #include "Variable_order.h"
+#include "Vivification.h"
 #include "Rational.h"
 #include "Value.h"
 #include "Bool_value.h"
@@ -31,7 +41,23 @@ namespace yaga {
 
 class Solver {
 public:
-    enum class Result { unsat = 0, sat = 1 };
+    enum class Result { unsat = 0, sat = 1, unknown = 2 };
+
+    /** Limits of resources available to one `check()`. Zero means no limit.
+     *
+     * If a limit is exceeded, `check()` returns `Result::unknown`.
+     */
+    struct Budget {
+        // maximal number of conflicts
+        std::int64_t conflicts = 0;
+        // maximal number of propagated variables
+        std::int64_t propagations = 0;
+        // maximal wall-clock time
+        std::chrono::milliseconds time{0};
+        // maximal resident set size of the process in MB (learned clauses are removed when the
+        // process gets close to the limit)
+        std::int64_t memory = 0;
+    };
 
     Solver();
 
@@ -88,6 +114,7 @@ public:
         auto concrete_theory_ptr = concrete_theory.get();
         solver_theory = std::move(concrete_theory);
         dispatcher.add(solver_theory.get());
+        is_initialized = false;
         return *concrete_theory_ptr;
     }
 
@@ -107,6 +134,7 @@ public:
         auto vo_ptr = vo.get();
         variable_order = std::move(vo);
         dispatcher.add(variable_order.get());
+        is_initialized = false;
         return *vo_ptr;
     }
 
@@ -126,13 +154,123 @@ public:
         auto policy_ptr = policy.get();
         restart_policy = std::move(policy);
         dispatcher.add(restart_policy.get());
+        is_initialized = false;
         return *policy_ptr;
     }
+
+    /** Enable failed-literal probing and equivalent-literal substitution (see `Probing`).
+     *
+     * Probing runs at decision level 0 before each check and periodically after restarts.
+     *
+     * @return reference to the probing pass in this solver
+     */
+    inline Probing& enable_probing()
+    {
+        if (!probing_pass)
+        {
+            probing_pass = std::make_unique<Probing>();
+        }
+        return *probing_pass;
+    }
+
+    /** Get probing pass used by this solver
+     *
+     * @return probing pass or nullptr if probing is not enabled
+     */
+    inline Probing const* probing() const { return probing_pass.get(); }
+
+    /** Enable vivification of learned clauses (see `Vivification`).
+     *
+     * Clauses learned since the last restart are vivified at decision level 0 on each restart.
+     *
+     * @return reference to the vivification pass in this solver
+     */
+    inline Vivification& enable_vivification()
+    {
+        if (!vivification_pass)
+        {
+            vivification_pass = std::make_unique<Vivification>();
+        }
+        return *vivification_pass;
+    }
+
+    /** Get vivification pass used by this solver
+     *
+     * @return vivification pass or nullptr if vivification is not enabled
+     */
+    inline Vivification const* vivification() const { return vivification_pass.get(); }
+
+    /** Set limits of resources available to each subsequent `check()`
+     *
+     * @param new_budget new limits
+     */
+    inline void set_budget(Budget const& new_budget) { check_budget = new_budget; }
+
+    /** Get limits of resources available to `check()`
+     *
+     * @return current limits
+     */
+    inline Budget const& budget() const { return check_budget; }
+
+    /** Request the running `check()` to stop as soon as possible and return `Result::unknown`.
+     *
+     * This method can be called from another thread (e.g., a signal handler or a scheduler). The
+     * flag is polled in the main loop of `check()`. If no check is running, the next check
+     * returns `unknown` immediately. The request is cleared when a check stops because of it.
+     */
+    inline void interrupt() { interrupt_flag->store(true, std::memory_order_relaxed); }
+
     /** Check satisfiability of asserted clauses in database `db()`
      *
-     * @return `sat` if asserted clauses are satisfiable, `unsat` otherwise
+     * @return `sat` if asserted clauses are satisfiable, `unsat` otherwise, `unknown` if the
+     * budget is exhausted or the check is interrupted
+     */
+    inline Result check() { return check(std::span<Literal const>{}); }
+
+    /** Check satisfiability of asserted clauses in database `db()` under @p assumptions
+     *
+     * The solver is incremental. Clauses and variables can be added between calls. Learned
+     * clauses, variable scores and state of theories are kept from the previous call. Only
+     * variables in the trail are reset.
+     *
+     * @param assumptions literals which are assumed to be true in this check
+     * @return `sat` if asserted clauses together with @p assumptions are satisfiable, `unsat`
+     * otherwise. If the result is `unsat`, `failed_assumptions()` returns assumptions which are
+     * inconsistent with asserted clauses. If the budget is exhausted or
+     * the check is interrupted, the result is `unknown`.
+     */
+    Result check(std::span<Literal const> assumptions);
+
+    /** Get assumptions responsible for the last `unsat` result of `check()`
+     *
+     * @return subset of assumptions passed to the last `check()` whose conjunction is inconsistent
+     * with asserted clauses. The list is empty if asserted clauses are unsatisfiable on their own
+     * or if the last result was `sat`.
      */
-    Result check();
+    inline std::vector<Literal> const& failed_assumptions() const { return failed; }
+
+    /** Shrink failed assumptions of the last `unsat` result of `check()` to a minimal set.
+     *
+     * Each failed assumption is removed in turn and the remaining assumptions are checked again.
+     * If the result is still `unsat`, the assumption is dropped together with all other
+     * assumptions which are not in the new failed set. Learned clauses are kept between the
+     * checks.
+     *
+     * @param fixed assumptions which are assumed in every check and which are never removed
+     * @return minimal subset of failed assumptions (without @p fixed) which is inconsistent with
+     * asserted clauses and @p fixed. `failed_assumptions()` returns the same list afterwards.
+     */
+    std::vector<Literal> const& minimize_failed_assumptions(std::span<Literal const> fixed);
+
+    /** Remove all asserted and learned clauses which contain any literal from @p literals
+     *
+     * This is sound if @p literals are true in all future checks. For example, if they are
+     * negations of activation literals which will not be assumed anymore. All variables are
+     * unassigned.
+     *
+     * @param literals literals which are considered to be true from now on
+     */
+    void remove_clauses(std::span<Literal const> literals);
 
     /** Check satisfiability of asserted clauses in database with variable values assigned `db()`
      *
@@ -144,31 +282,31 @@ public:
      *
      * @return total number of conflicts in the last `check()`
      */
-    inline int num_conflicts() const { return total_conflicts; }
+    inline std::int64_t num_conflicts() const { return total_conflicts; }
 
     /** Get total number of decisions
      *
      * @return total number of decisions in the last `check()`
      */
-    inline int num_decisions() const { return total_decisions; }
+    inline std::int64_t num_decisions() const { return total_decisions; }
 
     /** Get number of restart
      *
      * @return total number of restarts in the last `check()`
      */
-    inline int num_restarts() const { return total_restarts; }
+    inline std::int64_t num_restarts() const { return total_restarts; }
 
     /** Get total number of generated conflict clauses
      * 
      * @return total number of conflict clauses in the last `check()`
      */
-    inline int num_conflict_clauses() const { return total_conflict_clauses; }
+    inline std::int64_t num_conflict_clauses() const { return total_conflict_clauses; }
 
     /** Get total number of learned clauses
      * 
      * @return total number of learned clauses in the last `check()`
      */
-    inline int num_learned_clauses() const { return total_learned_clauses; }
+    inline std::int64_t num_learned_clauses() const { return total_learned_clauses; }
 
     /** Get theory used by this solver
      * 
@@ -176,26 +314,54 @@ public:
      */
     inline Theory* theory() { return solver_theory.get(); }
 
+    /** Estimate memory used by clauses, the trail, theories, and the pool of rational numbers
+     *
+     * @return memory usage of subsystems of this solver
+     */
+    Memory_usage memory_usage() const;
+
 private:
     Event_dispatcher dispatcher;
     Trail solver_trail;
     Database database;
     Conflict_analysis analysis;
     std::unique_ptr<Subsumption> subsumption;
+    std::unique_ptr<Probing> probing_pass;
+    std::unique_ptr<Vivification> vivification_pass;
     std::unique_ptr<Theory> solver_theory;
     std::unique_ptr<Restart> restart_policy;
     std::unique_ptr<Variable_order> variable_order;
     int num_bool_vars = 0;
+    // true iff `on_init()` has been called since the last change of plugins
+    bool is_initialized = false;
+    // failed assumptions of the last `check()`
+    std::vector<Literal> failed;
 
     using Clause_iterator = std::deque<Clause>::iterator;
     using Clause_range = std::ranges::subrange<Clause_iterator>;
 
-    // statistics
-    int total_conflicts = 0;
-    int total_conflict_clauses = 0;
-    int total_learned_clauses = 0;
-    int total_restarts = 0;
-    int total_decisions = 0;
+    // statistics of the last check (cumulative statistics are in `Statistics::global()`)
+    std::int64_t total_conflicts = 0;
+    std::int64_t total_conflict_clauses = 0;
+    std::int64_t total_learned_clauses = 0;
+    std::int64_t total_restarts = 0;
+    std::int64_t total_decisions = 0;
+    // auxiliary list of decision levels used to compute LBD
+    std::vector<int> lbd_levels;
+    // limits of resources available to one check
+    Budget check_budget;
+    // set by `interrupt()` (allocated separately so that the solver remains movable)
+    std::unique_ptr<std::atomic<bool>> interrupt_flag = std::make_unique<std::atomic<bool>>(false);
+    // value of `trail().num_propagations()` at the beginning of the last check
+    std::int64_t start_propagations = 0;
+    // time at the beginning of the last check
+    std::chrono::steady_clock::time_point start_time;
+    // number of calls to `is_out_of_budget()` in the last check
+    std::int64_t num_budget_polls = 0;
+    // true iff the process is close to the memory limit and learned clauses should be removed
+    bool is_memory_low = false;
+    // number of learned clauses after the last call to `reduce_memory()`
+    std::size_t num_learned_after_reduction = 0;
 
     // run propagate in theory
     [[nodiscard]] std::vector<Clause> propagate();
@@ -208,14 +374,35 @@ private:
     void backtrack_with(Clause_range clauses, int level);
     // process all learned clauses and add them to database
     [[nodiscard]] Clause_range learn(std::vector<Clause>&& learned);
+    // compute LBD (number of distinct decision levels of literals) of a learned `clause`
+    int compute_lbd(Clause const& clause);
+    // record size and `lbd` of a learned `clause` in statistics
+    void record_learned(Clause const& clause, int lbd);
+    // record trail size and backjump distance of a conflict which is resolved at `level`
+    void record_conflict(int level);
     // check if conflict `clause` is a semantic split clause
     bool is_semantic_split(Clause const& clause) const;
+    // check if the last check should stop because of `interrupt()` or exhausted budget
+    bool is_out_of_budget();
     // pick the next variable to assign
     [[nodiscard]] std::optional<Variable> pick_variable();
     // decide value of an unassigned variable
     void decide(Variable var);
-    // restart the solver
-    void restart();
+    // find the first assumption which is not true in the current trail
+    [[nodiscard]] std::optional<Literal> next_assumption(std::span<Literal const> assumptions) const;
+    // find assumptions which imply negation of a false assumption `lit` or backtrack if `~lit`
+    // depends on a decision which is not an assumption (returns none in that case)
+    [[nodiscard]] std::optional<std::vector<Literal>>
+    analyze_assumptions(std::span<Literal const> assumptions, Literal lit);
+    // restart the solver (returns false iff inprocessing finds a conflict at decision level 0)
+    [[nodiscard]] bool restart();
+    // remove the longer half of learned clauses with more than 2 literals (at decision level 0)
+    void reduce_memory();
+    // run probing at decision level 0 with `budget` propagations (returns false iff the asserted
+    // clauses are unsatisfiable)
+    [[nodiscard]] bool probe(std::int64_t budget);
+    // backtrack to decision level `level`
+    void backtrack(int level);
     // reset the solver for a new check()
     void init();
 };
@@ -0,0 +1,132 @@
+#include "Statistics.h"
+
+namespace yaga {
+
+namespace {
+
+/** Find or create a statistic called @p name in @p stats
+ *
+ * @param stats map name -> statistic
+ * @param name name of the statistic
+ * @return reference to the statistic or a shared dummy if statistics are disabled
+ */
+template <typename T>
+T& find_or_create(std::map<std::string, T, std::less<>>& stats, std::string_view name)
+{
+    if constexpr (!statistics_enabled)
+    {
+        static T dummy;
+        return dummy;
+    }
+    else
+    {
+        auto it = stats.find(name);
+        if (it == stats.end())
+        {
+            it = stats.emplace(std::string{name}, T{}).first;
+        }
+        return it->second;
+    }
+}
+
+// print @p value as a JSON string
+void print_string(std::ostream& out, std::string_view value)
+{
+    out << '"';
+    for (auto c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+Statistics& Statistics::global()
+{
+    static Statistics registry;
+    return registry;
+}
+
+Counter& Statistics::counter(std::string_view name) { return find_or_create(counters, name); }
+
+Timer& Statistics::timer(std::string_view name) { return find_or_create(timers, name); }
+
+Histogram& Statistics::histogram(std::string_view name)
+{
+    return find_or_create(histograms, name);
+}
+
+void Statistics::reset()
+{
+    for (auto& [_, counter] : counters)
+    {
+        counter.reset();
+    }
+
+    for (auto& [_, timer] : timers)
+    {
+        timer.reset();
+    }
+
+    for (auto& [_, histogram] : histograms)
+    {
+        histogram.reset();
+    }
+}
+
+void Statistics::print_json(std::ostream& out) const
+{
+    out << "{\"counters\":{";
+    for (bool is_first = true; auto const& [name, counter] : counters)
+    {
+        out << (is_first ? "" : ",");
+        print_string(out, name);
+        out << ":" << counter.value();
+        is_first = false;
+    }
+
+    out << "},\"timers\":{";
+    for (bool is_first = true; auto const& [name, timer] : timers)
+    {
+        out << (is_first ? "" : ",");
+        print_string(out, name);
+        out << ":{\"seconds\":" << std::chrono::duration<double>(timer.total()).count()
+            << ",\"calls\":" << timer.calls() << "}";
+        is_first = false;
+    }
+
+    out << "},\"histograms\":{";
+    for (bool is_first = true; auto const& [name, histogram] : histograms)
+    {
+        out << (is_first ? "" : ",");
+        print_string(out, name);
+        out << ":{\"count\":" << histogram.count() << ",\"sum\":" << histogram.sum()
+            << ",\"min\":" << histogram.min() << ",\"max\":" << histogram.max()
+            << ",\"mean\":" << histogram.mean() << ",\"buckets\":[";
+        // each non-empty bucket is printed as [min value, max value, count]
+        bool is_first_bucket = true;
+        for (int i = 0; i < Histogram::num_buckets; ++i)
+        {
+            if (histogram.bucket(i) == 0)
+            {
+                continue;
+            }
+
+            std::uint64_t lower = i == 0 ? 0 : std::uint64_t{1} << (i - 1);
+            std::uint64_t upper = i == 0 ? 0 : (lower << 1) - 1; // wraps around for the last bucket
+            out << (is_first_bucket ? "" : ",") << "[" << lower << "," << upper << ","
+                << histogram.bucket(i) << "]";
+            is_first_bucket = false;
+        }
+        out << "]}";
+        is_first = false;
+    }
+    out << "}}";
+}
+
+} // namespace yaga
@@ -0,0 +1,245 @@
+#ifndef YAGA_STATISTICS_H
+#define YAGA_STATISTICS_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Statistics are collected unless the library is compiled with `YAGA_STATISTICS=0` (CMake option
+// `YAGA_STATISTICS`). If they are disabled, all recording functions are empty and the registry
+// does not store anything.
+#ifndef YAGA_STATISTICS
+#define YAGA_STATISTICS 1
+#endif
+
+namespace yaga {
+
+// true iff statistics are compiled in
+inline constexpr bool statistics_enabled = YAGA_STATISTICS != 0;
+
+/** 64-bit event counter.
+ */
+class Counter {
+public:
+    /** Increment the counter
+     *
+     * @param amount value added to the counter
+     */
+    inline void add(std::uint64_t amount = 1)
+    {
+        if constexpr (statistics_enabled)
+        {
+            count += amount;
+        }
+    }
+
+    // get current value of the counter
+    inline std::uint64_t value() const { return count; }
+
+    // set the counter to 0
+    inline void reset() { count = 0; }
+
+private:
+    std::uint64_t count = 0;
+};
+
+/** Cumulative timer which measures total time spent in a scope and the number of calls.
+ *
+ * Time is measured using `std::chrono::steady_clock`. Use `Scoped_timer` to measure a scope:
+ * ~~~~~{.cpp}
+ * Timer& timer = Statistics::global().timer("bool_theory.propagate");
+ * {
+ *     Scoped_timer scope{timer};
+ *     ...
+ * }
+ * ~~~~~
+ */
+class Timer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** Add one measurement to the timer
+     *
+     * @param duration measured duration
+     */
+    inline void add(Clock::duration duration)
+    {
+        if constexpr (statistics_enabled)
+        {
+            time += duration;
+            ++num_calls;
+        }
+    }
+
+    // get total measured time
+    inline Clock::duration total() const { return time; }
+
+    // get number of measurements
+    inline std::uint64_t calls() const { return num_calls; }
+
+    // remove all measurements
+    inline void reset()
+    {
+        time = Clock::duration{0};
+        num_calls = 0;
+    }
+
+private:
+    Clock::duration time{0};
+    std::uint64_t num_calls = 0;
+};
+
+/** RAII object which adds time between its construction and destruction to a `Timer`.
+ */
+class Scoped_timer {
+public:
+    inline explicit Scoped_timer(Timer& timer) : timer(timer)
+    {
+        if constexpr (statistics_enabled)
+        {
+            start = Timer::Clock::now();
+        }
+    }
+
+    inline ~Scoped_timer()
+    {
+        if constexpr (statistics_enabled)
+        {
+            timer.add(Timer::Clock::now() - start);
+        }
+    }
+
+    // non-copyable
+    Scoped_timer(Scoped_timer const&) = delete;
+    Scoped_timer& operator=(Scoped_timer const&) = delete;
+
+private:
+    Timer& timer;
+    Timer::Clock::time_point start;
+};
+
+/** Histogram of non-negative integer values with power of two buckets.
+ *
+ * Bucket 0 counts zeros and bucket `i > 0` counts values in range [2^(i-1), 2^i).
+ */
+class Histogram {
+public:
+    inline static constexpr int num_buckets = std::numeric_limits<std::uint64_t>::digits + 1;
+
+    /** Add @p value to the histogram
+     *
+     * @param value recorded value
+     */
+    inline void record(std::uint64_t value)
+    {
+        if constexpr (statistics_enabled)
+        {
+            ++buckets[std::bit_width(value)];
+            ++num_values;
+            sum_values += value;
+            min_value = std::min(min_value, value);
+            max_value = std::max(max_value, value);
+        }
+    }
+
+    // get number of recorded values
+    inline std::uint64_t count() const { return num_values; }
+
+    // get sum of all recorded values
+    inline std::uint64_t sum() const { return sum_values; }
+
+    // get the smallest recorded value (or 0 if the histogram is empty)
+    inline std::uint64_t min() const { return num_values == 0 ? 0 : min_value; }
+
+    // get the largest recorded value
+    inline std::uint64_t max() const { return max_value; }
+
+    // get mean of recorded values (or 0 if the histogram is empty)
+    inline double mean() const
+    {
+        return num_values == 0 ? 0.0 : static_cast<double>(sum_values) / num_values;
+    }
+
+    /** Get number of values in a bucket
+     *
+     * @param index index of a bucket in range [0, `num_buckets`)
+     * @return number of recorded values in bucket @p index
+     */
+    inline std::uint64_t bucket(int index) const { return buckets[index]; }
+
+    // remove all recorded values
+    inline void reset() { *this = Histogram{}; }
+
+private:
+    std::array<std::uint64_t, num_buckets> buckets{};
+    std::uint64_t num_values = 0;
+    std::uint64_t sum_values = 0;
+    std::uint64_t min_value = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max_value = 0;
+};
+
+/** Registry of named counters, timers and histograms.
+ *
+ * Statistics are cumulative for the whole process. Instrumented code looks up its statistics
+ * once (for example, in a namespace scope variable) and records values using the returned
+ * reference, which is valid for the lifetime of the registry. Recording is not synchronized, so
+ * the instrumented code should only run on the solver thread.
+ */
+class Statistics {
+public:
+    /** Get registry shared by all solvers in this process
+     *
+     * @return global statistics registry
+     */
+    static Statistics& global();
+
+    /** Find or create a counter
+     *
+     * @param name name of the counter
+     * @return reference to the counter called @p name
+     */
+    Counter& counter(std::string_view name);
+
+    /** Find or create a timer
+     *
+     * @param name name of the timer
+     * @return reference to the timer called @p name
+     */
+    Timer& timer(std::string_view name);
+
+    /** Find or create a histogram
+     *
+     * @param name name of the histogram
+     * @return reference to the histogram called @p name
+     */
+    Histogram& histogram(std::string_view name);
+
+    /** Set all statistics in this registry to 0
+     */
+    void reset();
+
+    /** Print all statistics as a JSON object with `counters`, `timers` and `histograms` fields.
+     *
+     * Timers are printed with total time in seconds and number of calls. Histograms are printed
+     * with a summary and a list of non-empty buckets with their value range.
+     *
+     * @param out output stream
+     */
+    void print_json(std::ostream& out) const;
+
+private:
+    std::map<std::string, Counter, std::less<>> counters;
+    std::map<std::string, Timer, std::less<>> timers;
+    std::map<std::string, Histogram, std::less<>> histograms;
+};
+
+} // namespace yaga
+
+#endif // YAGA_STATISTICS_H
@@ -1,9 +1,18 @@
 #include "Subsumption.h"
+#include "Statistics.h"
 
 namespace yaga {
 
+namespace {
+
+auto& minimize_timer = Statistics::global().timer("subsumption.minimize");
+auto& restart_timer = Statistics::global().timer("subsumption.restart");
+
+} // namespace
+
 void Subsumption::minimize(Trail const& trail, Clause& clause)
 {
+    Scoped_timer timer{minimize_timer};
     auto const& model = trail.model<bool>(Variable::boolean);
 
     auto is_redundant = [&](auto lit) {
@@ -27,7 +36,11 @@ void Subsumption::on_variable_resize(Variable::Type type, int num_vars)
     }
 }
 
-void Subsumption::on_restart(Database& db, Trail&) { remove_subsumed(db); }
+void Subsumption::on_restart(Database& db, Trail&)
+{
+    Scoped_timer timer{restart_timer};
+    remove_subsumed(db);
+}
 
 bool Subsumption::subsumes(Subsumption::Clause_ptr first, Subsumption::Clause_ptr second)
 {
@@ -134,6 +147,8 @@ void Subsumption::remove_subsumed(Subsumption::Clause_ptr clause)
 
 void Subsumption::remove_subsumed(Database& db)
 {
+    // learned clauses could have been removed from the database since the last restart
+    old_size = std::min(old_size, db.learned().size());
     auto const old_end = db.learned().begin() + old_size;
 
     // find old clauses subsumed by a new clause
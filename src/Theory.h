@@ -7,6 +7,7 @@
 #include "Clause.h"
 #include "Database.h"
 #include "Event_listener.h"
+#include "Memory.h"
 #include "Trail.h"
 #include "Value.h"
 #include "Variable.h"
@@ -45,6 +46,12 @@ public:
      */
     void on_before_backtrack(Database&, Trail&, int) override;
 
+    /** Add memory used by data structures of this theory to @p usage
+     *
+     * @param usage memory usage of subsystems
+     */
+    virtual void memory_usage(Memory_usage&) const {}
+
 protected:
     using Trail_const_iterator = std::vector<Trail::Assignment>::const_iterator;
     using Trail_subrange = std::ranges::subrange<Trail_const_iterator>;
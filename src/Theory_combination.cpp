@@ -93,4 +93,12 @@ void Theory_combination::on_restart(Database& db, Trail& trail)
     }
 }
 
+void Theory_combination::memory_usage(Memory_usage& usage) const
+{
+    for (auto const& theory : theory_list)
+    {
+        theory->memory_usage(usage);
+    }
+}
+
 } // namespace yaga
\ No newline at end of file
@@ -81,6 +81,12 @@ public:
      */
     void on_restart(Database&, Trail&) override;
 
+    /** Add memory used by all theories to @p usage
+     *
+     * @param usage memory usage of subsystems
+     */
+    void memory_usage(Memory_usage& usage) const override;
+
     /** Create a new theory and add it to this object.
      *
      * @tparam T type of the theory to create
@@ -0,0 +1,154 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace yaga {
+
+namespace {
+
+struct Event_info {
+    std::string_view name;
+    std::string_view arg_name;
+};
+
+// map event -> its name and name of its payload
+constexpr std::array<Event_info, 14> events{{
+    {"on_init", ""},
+    {"on_variable_resize", "num_vars"},
+    {"on_before_backtrack", "level"},
+    {"on_learned_clause", "size"},
+    {"on_conflict_resolved", "size"},
+    {"on_restart", ""},
+    {"check", "assumptions"},
+    {"propagate", "level"},
+    {"analyze", "conflicts"},
+    {"learn", "clauses"},
+    {"backtrack", "level"},
+    {"decide", "level"},
+    {"restart", "restarts"},
+    {"probe", "budget"},
+}};
+
+static_assert(events.size() == static_cast<std::size_t>(Trace_event::probe) + 1);
+static_assert(sizeof(Tracer::Record) == 16);
+
+} // namespace
+
+void Tracer::enable(std::size_t capacity)
+{
+    if constexpr (tracing_enabled)
+    {
+        buffer.assign(std::bit_ceil(std::max<std::size_t>(capacity, 1)), Record{});
+        mask = buffer.size() - 1;
+        next = 0;
+        start = Clock::now();
+        is_recording = true;
+    }
+}
+
+std::vector<Tracer::Record> Tracer::records() const
+{
+    std::vector<Record> result;
+    for (auto i = num_dropped(); i < next; ++i)
+    {
+        result.push_back(buffer[i & mask]);
+    }
+    return result;
+}
+
+std::string_view Tracer::name(Trace_event event)
+{
+    return events[static_cast<std::size_t>(event)].name;
+}
+
+std::string_view Tracer::arg_name(Trace_event event)
+{
+    return events[static_cast<std::size_t>(event)].arg_name;
+}
+
+void Tracer::write_chrome_json(std::ostream& out) const
+{
+    auto flags = out.flags();
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool is_first = true;
+    int depth = 0;
+    for (auto const& record : records())
+    {
+        if (record.phase == Phase::end)
+        {
+            if (depth == 0) // begin of the event has been overwritten
+            {
+                continue;
+            }
+            --depth;
+        }
+        else
+        {
+            ++depth;
+        }
+
+        out << (is_first ? "" : ",\n");
+        out << "{\"name\":\"" << name(record.event) << "\",\"cat\":\"yaga\",\"ph\":\""
+            << (record.phase == Phase::begin ? "B" : "E") << "\",\"ts\":" << std::fixed
+            << std::setprecision(3) << record.time / 1000.0 << ",\"pid\":1,\"tid\":1";
+        if (record.phase == Phase::begin && !arg_name(record.event).empty())
+        {
+            out << ",\"args\":{\"" << arg_name(record.event) << "\":" << record.arg << "}";
+        }
+        out << "}";
+        is_first = false;
+    }
+    out << "]}\n";
+    out.flags(flags);
+}
+
+void Tracer::write_binary(std::ostream& out) const
+{
+    auto events = records();
+    std::uint64_t num_events = events.size();
+    std::uint64_t dropped = num_dropped();
+    out.write("YAGATRC1", 8);
+    out.write(reinterpret_cast<char const*>(&num_events), sizeof(num_events));
+    out.write(reinterpret_cast<char const*>(&dropped), sizeof(dropped));
+    out.write(reinterpret_cast<char const*>(events.data()),
+              static_cast<std::streamsize>(events.size() * sizeof(Record)));
+}
+
+void Tracer::dump_at_exit(std::string path, std::size_t capacity)
+{
+    bool is_registered = !exit_path.empty();
+    exit_path = std::move(path);
+    enable(capacity);
+    if (is_registered)
+    {
+        return;
+    }
+
+    std::atexit([] {
+        auto& tracer = global();
+        tracer.disable();
+        std::ofstream out{tracer.exit_path, std::ios::binary};
+        if (!out)
+        {
+            std::cerr << "Error: cannot write trace to " << tracer.exit_path << "\n";
+            return;
+        }
+
+        if (tracer.exit_path.ends_with(".json"))
+        {
+            tracer.write_chrome_json(out);
+        }
+        else
+        {
+            tracer.write_binary(out);
+        }
+    });
+}
+
+} // namespace yaga
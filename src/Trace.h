@@ -0,0 +1,217 @@
+#ifndef YAGA_TRACE_H
+#define YAGA_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Tracing is compiled in unless the library is compiled with `YAGA_TRACE=0` (CMake option
+// `YAGA_TRACE`). If it is compiled in, it still has to be enabled at runtime by
+// `Tracer::enable()`. Until then, each trace point only checks a flag.
+#ifndef YAGA_TRACE
+#define YAGA_TRACE 1
+#endif
+
+namespace yaga {
+
+// true iff tracing is compiled in
+inline constexpr bool tracing_enabled = YAGA_TRACE != 0;
+
+/** Traced events.
+ */
+enum class Trace_event : std::uint16_t {
+    // callbacks of `Event_listener`
+    on_init,
+    on_variable_resize,
+    on_before_backtrack,
+    on_learned_clause,
+    on_conflict_resolved,
+    on_restart,
+    // phases of `Solver::check()`
+    check,
+    propagate,
+    analyze,
+    learn,
+    backtrack,
+    decide,
+    restart,
+    probe,
+};
+
+/** Recorder of a timeline of solver events.
+ *
+ * Events are stored in a preallocated ring buffer of fixed size. If the buffer is full, the
+ * oldest events are overwritten. Each event is a begin or an end of a scope with a timestamp and
+ * a small integer payload (e.g., decision level or size of a clause). The timeline can be written
+ * in the Chrome `trace_event` JSON format (which can be opened in `chrome://tracing` or Perfetto)
+ * or in a compact binary format.
+ *
+ * Recording is not synchronized, so events should only be recorded by one thread at a time.
+ */
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // default number of events in the ring buffer
+    inline static constexpr std::size_t default_capacity = std::size_t{1} << 20;
+
+    enum class Phase : std::uint8_t { begin, end };
+
+    // one event in the binary format
+    struct Record {
+        // time since `enable()` in nanoseconds
+        std::uint64_t time;
+        Trace_event event;
+        Phase phase;
+        std::uint8_t reserved;
+        // payload of the event (see `arg_name()`)
+        std::int32_t arg;
+    };
+
+    /** Get tracer shared by all solvers in this process
+     *
+     * @return global tracer
+     */
+    inline static Tracer& global()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    /** Allocate the ring buffer and start recording events
+     *
+     * All previously recorded events are removed.
+     *
+     * @param capacity number of events in the ring buffer (rounded up to a power of 2)
+     */
+    void enable(std::size_t capacity = default_capacity);
+
+    /** Stop recording events. Recorded events are kept.
+     */
+    inline void disable() { is_recording = false; }
+
+    /** Check whether events are being recorded
+     *
+     * @return true iff tracing is compiled in and enabled
+     */
+    inline bool is_enabled() const
+    {
+        if constexpr (tracing_enabled)
+        {
+            return is_recording;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    /** Record an event if tracing is enabled
+     *
+     * @param event type of the event
+     * @param phase begin or end of the event
+     * @param arg payload of the event
+     */
+    inline void record(Trace_event event, Phase phase, std::int32_t arg = 0)
+    {
+        if (is_enabled())
+        {
+            auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            buffer[next++ & mask] = Record{static_cast<std::uint64_t>(time.count()), event, phase,
+                                           0, arg};
+        }
+    }
+
+    /** Get recorded events
+     *
+     * @return events in the ring buffer from the oldest to the newest
+     */
+    std::vector<Record> records() const;
+
+    /** Get number of overwritten events
+     *
+     * @return number of events which have been recorded but are no longer in the ring buffer
+     */
+    inline std::uint64_t num_dropped() const
+    {
+        return next > buffer.size() ? next - buffer.size() : 0;
+    }
+
+    /** Write recorded events in the Chrome `trace_event` JSON format
+     *
+     * End events whose begin event has been overwritten are skipped.
+     *
+     * @param out output stream
+     */
+    void write_chrome_json(std::ostream& out) const;
+
+    /** Write recorded events in a binary format.
+     *
+     * The output starts with the magic string `YAGATRC1`, number of events and number of
+     * dropped events (both as 64-bit integers), followed by the events as `Record` structures
+     * in native byte order.
+     *
+     * @param out output stream
+     */
+    void write_binary(std::ostream& out) const;
+
+    /** Enable tracing and write recorded events to @p path when the program exits.
+     *
+     * The Chrome JSON format is used if @p path ends with `.json`, the binary format otherwise.
+     *
+     * @param path path to the output file
+     * @param capacity number of events in the ring buffer
+     */
+    void dump_at_exit(std::string path, std::size_t capacity = default_capacity);
+
+    /** Get name of an event
+     *
+     * @param event traced event
+     * @return name of @p event
+     */
+    static std::string_view name(Trace_event event);
+
+    /** Get meaning of the payload of an event
+     *
+     * @param event traced event
+     * @return name of the payload of @p event or an empty string if it does not have one
+     */
+    static std::string_view arg_name(Trace_event event);
+
+private:
+    std::vector<Record> buffer;
+    // `buffer.size() - 1`
+    std::uint64_t mask = 0;
+    // total number of recorded events
+    std::uint64_t next = 0;
+    bool is_recording = false;
+    Clock::time_point start;
+    // output path for `dump_at_exit()`
+    std::string exit_path;
+};
+
+/** RAII object which records begin and end of an event in the global tracer.
+ */
+class Trace_scope {
+public:
+    inline explicit Trace_scope(Trace_event event, std::int32_t arg = 0) : event(event)
+    {
+        Tracer::global().record(event, Tracer::Phase::begin, arg);
+    }
+
+    inline ~Trace_scope() { Tracer::global().record(event, Tracer::Phase::end); }
+
+    // non-copyable
+    Trace_scope(Trace_scope const&) = delete;
+    Trace_scope& operator=(Trace_scope const&) = delete;
+
+private:
+    Trace_event event;
+};
+
+} // namespace yaga
+
+#endif // YAGA_TRACE_H
@@ -9,8 +9,10 @@ void Trail::resize(Variable::Type type, int num_vars)
 
     var_models[type]->resize(num_vars);
     int num_types = std::max<int>(static_cast<int>(var_reason.size()), type + 1);
-    var_reason.resize(num_types, std::vector<Clause const*>(num_vars, nullptr));
-    var_level.resize(num_types, std::vector<int>(num_vars, unassigned));
+    // don't create a temporary vector of `num_vars` elements since this is called for each new
+    // variable
+    var_reason.resize(num_types);
+    var_level.resize(num_types);
     var_reason[type].resize(num_vars, nullptr);
     var_level[type].resize(num_vars, unassigned);
     // notify all listeners that the number of variables has changed
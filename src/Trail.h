@@ -2,6 +2,7 @@
 #define YAGA_TRAIL_H_
 
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <tuple>
@@ -9,6 +10,7 @@
 
 #include "Clause.h"
 #include "Literal.h"
+#include "Memory.h"
 #include "Model.h"
 #include "Variable.h"
 
@@ -183,6 +185,7 @@ public:
         trail.emplace_back(std::vector<Assignment>{Assignment{var, /*reason=*/nullptr}});
         var_level[var.type()][var.ord()] = decision_level();
         var_reason[var.type()][var.ord()] = nullptr;
+        ++num_assigned_vars;
     }
 
     /** Propagate variable @p var due to clause @p reason at decision level @p level
@@ -206,6 +209,8 @@ public:
         }
         var_level[var.type()][var.ord()] = level;
         var_reason[var.type()][var.ord()] = reason;
+        ++num_assigned_vars;
+        ++total_propagations;
     }
 
     /** Make all variables decided or propagated at levels > @p level unassigned.
@@ -225,6 +230,7 @@ public:
                     var_level[assignment.var.type()][assignment.var.ord()] = unassigned;
                     var_reason[assignment.var.type()][assignment.var.ord()] = nullptr;
                     var_models[assignment.var.type()]->clear(assignment.var.ord());
+                    --num_assigned_vars;
                 }
             }
         }
@@ -267,6 +273,23 @@ public:
 
         trail.clear();
         trail.emplace_back();
+        num_assigned_vars = 0;
+    }
+
+    // get number of assigned variables of all types
+    inline int num_assigned() const { return num_assigned_vars; }
+
+    // get total number of propagated variables since this trail was created (it is not reset by
+    // backtracking or `clear()`)
+    inline std::int64_t num_propagations() const { return total_propagations; }
+
+    /** Add memory used by assignments, reasons, and decision levels to @p usage
+     *
+     * @param usage memory usage of subsystems
+     */
+    inline void memory_usage(Memory_usage& usage) const
+    {
+        usage.add("trail", memory_of(trail) + memory_of(var_reason) + memory_of(var_level));
     }
 
 private:
@@ -284,6 +307,10 @@ private:
     std::vector<std::vector<int>> var_level;
     // models managed by this trail
     std::vector<std::unique_ptr<Model_base>> var_models;
+    // number of variables with a value in this trail
+    int num_assigned_vars = 0;
+    // number of calls to `propagate()`
+    std::int64_t total_propagations = 0;
 };
 
 } // namespace yaga
@@ -0,0 +1,115 @@
+#include "Vivification.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace yaga {
+
+void Vivification::reset()
+{
+    candidates.clear();
+    check_start = Clock::now();
+    check_time = Clock::duration{0};
+}
+
+bool Vivification::run(Database& db, Trail& trail, Theory& theory, Event_listener& listener)
+{
+    auto start = Clock::now();
+    if (check_time > (start - check_start) * max_time_ratio)
+    {
+        candidates.clear();
+        return true;
+    }
+
+    // clauses with low LBD first
+    std::stable_sort(candidates.begin(), candidates.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.lbd < rhs.lbd;
+    });
+
+    bool is_consistent = theory.propagate(db, trail).empty();
+    std::int64_t budget = run_budget;
+    for (auto it = candidates.begin(); is_consistent && it != candidates.end() && budget > 0;
+         ++it)
+    {
+        is_consistent = vivify(db, trail, theory, listener, *it->clause, budget);
+    }
+    candidates.clear();
+
+    // clauses are replaced after the last propagation so that watched literals stay valid
+    for (auto& [clause, lits] : shortened)
+    {
+        ++num_vivified_clauses;
+        num_removed_lits += static_cast<std::int64_t>(clause->size() - lits.size());
+        *clause = std::move(lits);
+    }
+    shortened.clear();
+
+    if (!trail.empty())
+    {
+        listener.on_before_backtrack(db, trail, /*decision_level=*/0);
+        trail.clear();
+    }
+
+    auto duration = Clock::now() - start;
+    check_time += duration;
+    time_spent += duration;
+    return is_consistent;
+}
+
+bool Vivification::vivify(Database& db, Trail& trail, Theory& theory, Event_listener& listener,
+                          Clause& clause, std::int64_t& budget)
+{
+    auto& model = trail.model<bool>(Variable::boolean);
+    if (std::any_of(clause.begin(), clause.end(),
+                    [&](auto lit) { return eval(model, lit) == true; }))
+    {
+        return true; // the clause is satisfied at level 0
+    }
+
+    // propagation can reorder literals in the clause
+    Clause lits = clause;
+    Clause kept;
+    for (std::size_t i = 0; i < lits.size(); ++i)
+    {
+        auto lit = lits[i];
+        auto value = eval(model, lit);
+        if (value == false) // negation of the literal is implied by negations of `kept`
+        {
+            continue;
+        }
+
+        kept.push_back(lit);
+        if (value == true || i + 1 == lits.size())
+        {
+            break;
+        }
+
+        trail.decide(lit.var());
+        model.set_value(lit.var().ord(), lit.is_negation());
+        bool is_conflict = !theory.propagate(db, trail).empty();
+        budget -= static_cast<std::int64_t>(trail.assigned(trail.decision_level()).size());
+        if (is_conflict)
+        {
+            break;
+        }
+    }
+
+    if (trail.decision_level() > 0)
+    {
+        listener.on_before_backtrack(db, trail, /*decision_level=*/0);
+        trail.backtrack(0);
+    }
+
+    if (kept.empty())
+    {
+        return false;
+    }
+
+    if (kept.size() < lits.size())
+    {
+        shortened.emplace_back(&clause, std::move(kept));
+    }
+    return true;
+}
+
+} // namespace yaga
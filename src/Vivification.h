@@ -0,0 +1,127 @@
+#ifndef YAGA_VIVIFICATION_H
+#define YAGA_VIVIFICATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Clause.h"
+#include "Database.h"
+#include "Event_listener.h"
+#include "Literal.h"
+#include "Theory.h"
+#include "Trail.h"
+
+namespace yaga {
+
+/** Vivification of learned clauses at decision level 0.
+ *
+ * Negations of literals of a learned clause are decided one at a time and propagated using the
+ * theory. The clause is shortened to the decided literals if the propagation leads to a
+ * conflict or if it implies some literal of the clause. Literals which become false are removed
+ * from the clause as well.
+ *
+ * Clauses learned since the last run are vivified in the order of their LBD (number of distinct
+ * decision levels when the clause was learned). Each run is bounded by a budget counted in
+ * propagated variables and runs are skipped while the time spent in vivification exceeds a
+ * fraction of the time spent in the current check.
+ */
+class Vivification final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** Remember @p learned as a candidate for the next run
+     *
+     * @param learned newly learned clause in the clause database
+     * @param lbd number of distinct decision levels of literals in @p learned when it was learned
+     */
+    inline void add_candidate(Clause& learned, int lbd) { candidates.push_back({&learned, lbd}); }
+
+    /** Forget all candidates and start measuring time of a new check
+     */
+    void reset();
+
+    /** Vivify clauses learned since the last run
+     *
+     * Clauses in @p db cannot be removed between the time they are learned and this run.
+     *
+     * @param db clause database
+     * @param trail current solver trail without any assigned variables (no variable is
+     * assigned when this method returns)
+     * @param theory theory used to propagate decided literals
+     * @param listener listener notified before decided literals are backtracked
+     * @return false iff the clauses in @p db are unsatisfiable
+     */
+    bool run(Database& db, Trail& trail, Theory& theory, Event_listener& listener);
+
+    /** Set budget of each run
+     *
+     * @param budget maximal number of variables propagated in one run
+     */
+    inline void set_budget(std::int64_t budget) { run_budget = budget; }
+
+    /** Set maximal fraction of time spent in vivification
+     *
+     * @param ratio maximal ratio of time spent in vivification to the time of the current check
+     */
+    inline void set_time_ratio(double ratio) { max_time_ratio = ratio; }
+
+    /** Get number of shortened clauses
+     *
+     * @return number of clauses from which at least one literal has been removed
+     */
+    inline int num_vivified() const { return num_vivified_clauses; }
+
+    /** Get number of removed literals
+     *
+     * @return total number of literals removed from learned clauses
+     */
+    inline std::int64_t num_removed() const { return num_removed_lits; }
+
+    /** Get total time spent in `run()`
+     *
+     * @return duration of all `run()` calls
+     */
+    inline Clock::duration total_time() const { return time_spent; }
+
+private:
+    // learned clause with its LBD
+    struct Candidate {
+        Clause* clause;
+        int lbd;
+    };
+
+    // learned clauses since the last run
+    std::vector<Candidate> candidates;
+    // shortened clauses which replace candidates at the end of a run
+    std::vector<std::pair<Clause*, Clause>> shortened;
+    // start of the current check
+    Clock::time_point check_start = Clock::now();
+    // time spent in vivification in the current check
+    Clock::duration check_time{0};
+
+    std::int64_t run_budget = 50'000;
+    double max_time_ratio = 0.05;
+
+    // statistics
+    int num_vivified_clauses = 0;
+    std::int64_t num_removed_lits = 0;
+    Clock::duration time_spent{0};
+
+    /** Vivify @p clause
+     *
+     * @param db clause database
+     * @param trail current solver trail at decision level 0
+     * @param theory theory used to propagate decided literals
+     * @param listener listener notified before decided literals are backtracked
+     * @param clause learned clause
+     * @param budget remaining budget which is decreased by the number of propagated variables
+     * @return false iff all literals of @p clause are false at decision level 0
+     */
+    bool vivify(Database& db, Trail& trail, Theory& theory, Event_listener& listener,
+                Clause& clause, std::int64_t& budget);
+};
+
+} // namespace yaga
+
+#endif // YAGA_VIVIFICATION_H
@@ -35,6 +35,7 @@ Yaga::Yaga(Initializer const& initializer, Options const& options) { init(initia
 
 void Yaga::init(Initializer const& init, Options const& options)
 {
+    smt.trail().clear();
     smt.db().learned().clear();
     smt.db().asserted().clear();
     init.setup(smt, options);
@@ -1,9 +1,17 @@
 #include "Bool_theory.h"
 #include "Bool_value.h"
+#include "Statistics.h"
 #include <iostream>
 
 namespace yaga {
 
+namespace {
+
+auto& propagate_timer = Statistics::global().timer("bool_theory.propagate");
+auto& propagation_counter = Statistics::global().counter("bool_theory.propagations");
+
+} // namespace
+
 void Bool_theory::decide_val(Trail& trail, Variable var, std::shared_ptr<Value> value)
 {
     if (value->type() != Value::boolean) {
@@ -47,6 +55,17 @@ void Bool_theory::on_variable_resize(Variable::Type type, int num_vars)
     }
 }
 
+void Bool_theory::memory_usage(Memory_usage& usage) const
+{
+    std::size_t bytes = 2 * watched.num_vars() * sizeof(std::vector<Watched_clause>);
+    for (auto const& list : watched)
+    {
+        bytes += memory_of(list);
+    }
+    usage.add("bool_theory.watches", bytes);
+    usage.add("bool_theory.other", memory_of(satisfied) + phase.capacity() / 8);
+}
+
 void Bool_theory::on_before_backtrack(Database& db, Trail& trail, int level)
 {
     Theory::on_before_backtrack(db, trail, level);
@@ -130,6 +149,7 @@ void Bool_theory::initialize(Database& db, Trail& trail)
 
 std::vector<Clause> Bool_theory::propagate(Database& db, Trail& trail)
 {
+    Scoped_timer timer{propagate_timer};
     satisfied.clear();
 
     auto& model = trail.model<bool>(Variable::boolean);
@@ -146,6 +166,7 @@ std::vector<Clause> Bool_theory::propagate(Database& db, Trail& trail)
         {
             model.set_value(lit.var().ord(), !lit.is_negation());
             trail.propagate(lit.var(), reason, trail.decision_level());
+            propagation_counter.add();
         }
         assert(eval(model, lit) == true);
         // reason clause is a unit clause which implies lit
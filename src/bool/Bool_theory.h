@@ -72,6 +72,12 @@ public:
      */
     void on_variable_resize(Variable::Type, int) override;
 
+    /** Add memory used by watch lists to @p usage
+     *
+     * @param usage memory usage of subsystems
+     */
+    void memory_usage(Memory_usage& usage) const override;
+
     /** Set phase of variables decided in `decide()`
      * 
      * @param phase phase of boolean variables decided in `decide()`
@@ -2,7 +2,30 @@
 
 namespace yaga {
 
-void Bounds::resize(int num_vars) { bounds.resize(num_vars); }
+void Bounds::resize(int num_vars)
+{
+    bounds.resize(num_vars);
+    is_updated.resize(num_vars);
+}
+
+void Bounds::clear()
+{
+    for (auto& var_bounds : bounds)
+    {
+        var_bounds.clear();
+    }
+    updated_read.clear();
+    updated_write.clear();
+    is_updated.clear();
+}
+
+void Bounds::updated(int var)
+{
+    if (is_updated.insert(var))
+    {
+        updated_write.push_back(var);
+    }
+}
 
 bool Bounds::depends_on(Bound const& bound, int bool_var) const
 {
@@ -94,7 +117,7 @@ void Bounds::deduce_from_equality(Models const& models, Constraint const& cons)
 
             if (has_changed)
             {
-                updated_write.push_back(prop.unbounded_var);
+                updated(prop.unbounded_var);
             }
         }
         ++i;
@@ -170,7 +193,7 @@ void Bounds::deduce_from_inequality(Models const& models, Constraint const& cons
 
         if (has_changed)
         {
-            updated_write.push_back(unbounded_var);
+            updated(unbounded_var);
         }
     }
 }
@@ -307,18 +330,16 @@ void Bounds::update(Models const& models, Constraint cons)
 
     if (has_changed)
     {
-        updated_write.push_back(var);
+        updated(var);
     }
 }
 
 std::vector<int> const& Bounds::changed()
 {
     std::swap(updated_read, updated_write);
-    // remove duplicated in the read buffer
-    std::sort(updated_read.begin(), updated_read.end());
-    updated_read.erase(std::unique(updated_read.begin(), updated_read.end()), updated_read.end());
-    // clear the write buffer
+    // clear the write buffer (`updated()` keeps it free of duplicates)
     updated_write.clear();
+    is_updated.clear();
     return updated_read;
 }
 
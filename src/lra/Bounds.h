@@ -5,6 +5,7 @@
 #include <cassert>
 #include <vector>
 
+#include "Epoch_set.h"
 #include "Rational.h"
 #include "Linear_constraint.h"
 #include "Trail.h"
@@ -26,6 +27,12 @@ public:
      */
     void resize(int num_vars);
 
+    /** Remove all bounds of all variables.
+     *
+     * This should only be called if no variable is assigned (e.g., on restart).
+     */
+    void clear();
+
     /** Deduce a new bounds from @p cons
      *
      * @param models partial assignment of variables
@@ -93,12 +100,32 @@ public:
      */
     inline Variable_bounds<Rational>& operator[](int var) { return bounds[var]; }
 
+    /** Get heap memory used by bounds of all variables
+     *
+     * @return number of bytes allocated by this object
+     */
+    inline std::size_t memory_usage() const
+    {
+        std::size_t result = bounds.capacity() * sizeof(Variable_bounds<Rational>) +
+                             updated_read.capacity() * sizeof(int) +
+                             updated_write.capacity() * sizeof(int);
+        for (auto const& var_bounds : bounds)
+        {
+            result += var_bounds.memory_usage();
+        }
+        return result;
+    }
+
 private:
     // map lra variable ordinal -> bounds for that variable
     std::vector<Variable_bounds<Rational>> bounds;
     // variables with updated bounds
     std::vector<int> updated_read;
     std::vector<int> updated_write;
+    // set of variables in `updated_write`
+    Epoch_set is_updated;
+    // set of boolean variables used in `count_distinct_bounds()`
+    Epoch_set counted;
     // maximum number of dependencies of a bound (as a percentage of the number of variables)
     float threshold = 1.0;
 
@@ -124,10 +151,13 @@ private:
      */
     template <std::ranges::range Bound_range> int count_distinct_bounds(Bound_range&& bounds)
     {
-        std::vector<int> vars;
-        vars.reserve(bounds.size());
+        int count = 0;
+        counted.clear();
         auto add = [&](auto& self, Bound const& bound) -> void {
-            vars.push_back(bound.reason().lit().var().ord());
+            if (counted.insert(bound.reason().lit().var().ord()))
+            {
+                ++count;
+            }
             for (auto const& other : bound.bounds())
             {
                 self(self, other);
@@ -137,12 +167,15 @@ private:
         {
             add(add, bound);
         }
-
-        // count distinct bounds
-        std::sort(vars.begin(), vars.end());
-        return std::distance(vars.begin(), std::unique(vars.begin(), vars.end()));
+        return count;
     }
 
+    /** Mark that bounds of @p var have changed
+     *
+     * @param var rational variable ordinal
+     */
+    void updated(int var);
+
     /** Check whether @p bound is an equality (=)
      *
      * @param bound checked bound
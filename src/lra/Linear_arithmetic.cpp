@@ -1,8 +1,17 @@
 #include "Linear_arithmetic.h"
 #include "Rational_value.h"
+#include "Statistics.h"
 
 namespace yaga {
 
+namespace {
+
+auto& propagate_timer = Statistics::global().timer("linear_arithmetic.propagate");
+auto& decide_timer = Statistics::global().timer("linear_arithmetic.decide");
+auto& conflict_counter = Statistics::global().counter("linear_arithmetic.conflicts");
+
+} // namespace
+
 void Linear_arithmetic::on_variable_resize(Variable::Type type, int num_vars)
 {
     if (type == Variable::rational)
@@ -11,10 +20,162 @@ void Linear_arithmetic::on_variable_resize(Variable::Type type, int num_vars)
         watched.resize(num_vars);
         cached_values.resize(num_vars);
         occur.resize(num_vars);
+        terms.resize(num_vars);
+        is_summed.resize(num_vars, false);
+        checked.resize(num_vars);
     }
     else if (type == Variable::boolean)
     {
         constraints.resize(num_vars);
+        is_removable.resize(num_vars, false);
+    }
+}
+
+void Linear_arithmetic::on_before_backtrack(Database& db, Trail& trail, int level)
+{
+    Theory::on_before_backtrack(db, trail, level);
+
+    // rational variables are only decided so `summed` is sorted by decision level
+    auto const& model = trail.model<Rational>(Variable::rational);
+    while (!summed.empty() &&
+           trail.decision_level(Variable{summed.back(), Variable::rational}).value() > level)
+    {
+        auto lra_var_ord = summed.back();
+        summed.pop_back();
+        is_summed[lra_var_ord] = false;
+
+        auto const& value = model.value(lra_var_ord);
+        for (auto const& [bool_var_ord, coef, int_coef] : terms[lra_var_ord])
+        {
+            constraints.exclude(bool_var_ord, coef, int_coef, value);
+        }
+    }
+}
+
+void Linear_arithmetic::memory_usage(Memory_usage& usage) const
+{
+    usage.add("linear_arithmetic.watches", memory_of(watched));
+    usage.add("linear_arithmetic.bounds", bounds.memory_usage());
+    usage.add("linear_arithmetic.constraints", constraints.memory_usage());
+    usage.add("linear_arithmetic.occurrences", memory_of(occur) + memory_of(terms));
+    usage.add("linear_arithmetic.other", memory_of(to_check) + memory_of(summed) +
+                                             memory_of(derived) + memory_of(free_vars) +
+                                             memory_of(decided) + is_summed.capacity() / 8 +
+                                             is_removable.capacity() / 8);
+}
+
+void Linear_arithmetic::on_restart(Database& db, Trail& trail)
+{
+    if (options.collect_limit <= 0 || num_derived < options.collect_limit)
+    {
+        return;
+    }
+    assert(trail.empty());
+    assert(summed.empty());
+    num_derived = 0;
+
+    // mark boolean variables which occur in some clause
+    referenced.clear();
+    for (auto clauses : {&db.asserted(), &db.learned()})
+    {
+        for (auto const& clause : *clauses)
+        {
+            for (auto lit : clause)
+            {
+                referenced.insert(lit.var().ord());
+            }
+        }
+    }
+
+    // remove derived constraints which do not occur in any clause
+    bool is_removed = false;
+    auto end = std::remove_if(derived.begin(), derived.end(), [&](int bool_var_ord) {
+        if (!is_removable[bool_var_ord])
+        {
+            return true; // the constraint is used outside of conflict analysis
+        }
+        if (referenced.contains(bool_var_ord))
+        {
+            return false;
+        }
+        is_removable[bool_var_ord] = false;
+        constraints.remove(bool_var_ord);
+        free_vars.push_back(bool_var_ord);
+        is_removed = true;
+        return true;
+    });
+    derived.erase(end, derived.end());
+    if (!is_removed)
+    {
+        return;
+    }
+    constraints.compact();
+
+    // constraints have been moved, so rebuild all structures which store them
+    bounds.clear();
+    to_check.clear();
+    for (auto& list : watched)
+    {
+        list.clear();
+    }
+    for (auto& list : occur)
+    {
+        list.clear();
+    }
+    for (auto& list : terms)
+    {
+        list.clear();
+    }
+
+    auto models = relevant_models(trail);
+    for (auto cons : constraints)
+    {
+        if (cons.empty())
+        {
+            continue; // removed constraint or a boolean variable without a constraint
+        }
+
+        if (options.prop_bounds || options.prop_unassigned)
+        {
+            for (auto var : cons.vars())
+            {
+                occur[var].push_back(cons);
+            }
+        }
+        add_terms(models.owned(), cons);
+        watch(cons, models.owned());
+    }
+}
+
+void Linear_arithmetic::add_terms(Model<Rational> const& model, Constraint const& cons)
+{
+    auto bool_var_ord = cons.lit().var().ord();
+    auto int_coef = constraints.int_coef(cons);
+    for (int i = 0; i < cons.size(); ++i)
+    {
+        auto var_ord = cons.vars()[i];
+        auto const& term = terms[var_ord].emplace_back(bool_var_ord, cons.coef()[i], int_coef[i]);
+        if (is_summed[var_ord])
+        {
+            constraints.include(bool_var_ord, term.coef, term.int_coef, model.value(var_ord));
+        }
+    }
+}
+
+void Linear_arithmetic::add_to_sums(Model<Rational> const& model, int lra_var_ord)
+{
+    if (is_summed[lra_var_ord])
+    {
+        return;
+    }
+
+    is_summed[lra_var_ord] = true;
+    summed.push_back(lra_var_ord);
+
+    auto const& value = model.value(lra_var_ord);
+    for (auto const& [bool_var_ord, coef, int_coef] : terms[lra_var_ord])
+    {
+        constraints.include(bool_var_ord, coef, int_coef, value);
     }
 }
 
@@ -37,6 +198,7 @@ bool Linear_arithmetic::is_effectively_decided(Models const& models, int lra_var
 
 std::vector<Clause> Linear_arithmetic::propagate(Database&, Trail& trail)
 {
+    Scoped_timer timer{propagate_timer};
     auto models = relevant_models(trail);
 
     // find relevant variables which have been assigned at current decision level
@@ -102,17 +264,13 @@ void Linear_arithmetic::watch(Constraint& cons)
 void Linear_arithmetic::watch(Constraint& cons, Model<Rational> const& model)
 {
     // move 2 unassigned variables to the front
-    auto out_var_it = cons.vars().begin();
-    auto out_var_end = cons.size() == 1 ? out_var_it + 1 : out_var_it + 2;
-    auto out_coef_it = cons.coef().begin();
-    auto var_it = out_var_it;
-    auto coef_it = out_coef_it;
-    for (; var_it != cons.vars().end() && out_var_it != out_var_end; ++var_it, ++coef_it)
+    int out = 0;
+    int const out_end = std::min(cons.size(), 2);
+    for (int i = 0; i < cons.size() && out != out_end; ++i)
     {
-        if (!model.is_defined(*var_it))
+        if (!model.is_defined(cons.vars()[i]))
         {
-            std::iter_swap(var_it, out_var_it++);
-            std::iter_swap(coef_it, out_coef_it++);
+            constraints.swap(cons, i, out++);
         }
     }
 
@@ -122,7 +280,7 @@ void Linear_arithmetic::watch(Constraint& cons, Model<Rational> const& model)
 bool Linear_arithmetic::replace_watch(Model<Rational> const& lra_model, Watched_constraint& watch,
                                       int lra_var_ord)
 {
-    auto& cons = watch.constraint;
+    auto const& cons = constraints.at(watch.bool_var_ord);
 
     if (cons.size() <= 1)
     {
@@ -140,11 +298,9 @@ bool Linear_arithmetic::replace_watch(Model<Rational> const& lra_model, Watched_
 
     // move the assigned variable to the second position
     auto rep_var_it = ++cons.vars().begin();
-    auto rep_coef_it = ++cons.coef().begin();
     if (*rep_var_it != lra_var_ord)
     {
-        std::iter_swap(cons.vars().begin(), rep_var_it);
-        std::iter_swap(cons.coef().begin(), rep_coef_it);
+        constraints.swap(cons, 0, 1);
     }
     assert(*rep_var_it == lra_var_ord);
 
@@ -152,30 +308,22 @@ bool Linear_arithmetic::replace_watch(Model<Rational> const& lra_model, Watched_
     if (cons.size() > 2)
     {
         assert(2 <= watch.index && watch.index < cons.size());
-        auto var_it = cons.vars().begin() + watch.index;
-        auto coef_it = cons.coef().begin() + watch.index;
-        auto const end_var_it = var_it;
+        auto const end_index = watch.index;
         do
         {
-            assert(coef_it != cons.coef().end());
-            if (!lra_model.is_defined(*var_it))
+            if (!lra_model.is_defined(cons.vars()[watch.index]))
             {
-                std::iter_swap(rep_var_it, var_it);
-                std::iter_swap(rep_coef_it, coef_it);
+                constraints.swap(cons, 1, watch.index);
                 watched[*rep_var_it].push_back(watch);
                 break;
             }
 
             // move to the next variable
-            ++watch.index;
-            ++coef_it;
-            if (++var_it == cons.vars().end())
+            if (++watch.index == cons.size())
             {
-                var_it = cons.vars().begin() + 2; // skip the watched variables
-                coef_it = cons.coef().begin() + 2;
-                watch.index = 2;
+                watch.index = 2; // skip the watched variables
             }
-        } while (var_it != end_var_it);
+        } while (watch.index != end_index);
     }
 
     return *rep_var_it != lra_var_ord;
@@ -185,11 +333,13 @@ void Linear_arithmetic::replace_watch(Trail& trail, Models& models, int lra_var_
 {
     assert(models.owned().is_defined(lra_var_ord));
 
+    add_to_sums(models.owned(), lra_var_ord);
+
     auto& watchlist = watched[lra_var_ord];
     for (std::size_t i = 0; i < watchlist.size();)
     {
         auto& watch = watchlist[i];
-        auto& cons = watch.constraint;
+        auto const& cons = constraints.at(watch.bool_var_ord);
 
         if (replace_watch(models.owned(), watch, lra_var_ord))
         {
@@ -333,12 +483,11 @@ std::vector<Clause> Linear_arithmetic::finish(Trail& trail)
 
     // check for conflict
     auto models = relevant_models(trail);
-    std::unordered_set<int> checked;
     std::vector<Clause> result;
+    checked.clear();
     for (auto var_ord : to_check)
     {
-        auto [_, is_inserted] = checked.insert(var_ord);
-        if (is_inserted)
+        if (checked.insert(var_ord))
         {
             if (auto conflict = check_bounds(trail, var_ord))
             {
@@ -355,6 +504,7 @@ std::vector<Clause> Linear_arithmetic::finish(Trail& trail)
         }
     }
     to_check.clear();
+    conflict_counter.add(result.size());
     return result;
 }
 
@@ -519,6 +669,7 @@ void Linear_arithmetic::decide(Database&, Trail& trail, Variable var)
         return;
     }
 
+    Scoped_timer timer{decide_timer};
     auto models = relevant_models(trail);
     auto& bnds = bounds[var.ord()];
 
@@ -646,7 +797,7 @@ void Linear_arithmetic::check_watch_consistency([[maybe_unused]] Models const& m
         for ([[maybe_unused]] auto var : cons.vars() | std::views::take(2))
         {
             assert(std::find_if(watched[var].begin(), watched[var].end(), [cons](auto& watch) {
-                       return watch.constraint.lit().var() == cons.lit().var();
+                       return watch.bool_var_ord == cons.lit().var().ord();
                    }) != watched[var].end());
         }
     }
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <optional>
 #include <ranges>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "Bounds.h"
+#include "Epoch_set.h"
 #include "Rational.h"
 #include "Linear_constraints.h"
 #include "Lra_conflict_analysis.h"
@@ -51,6 +53,12 @@ public:
          * A rational variable is effectively decided if it can only be assigned one value.
          */
         bool prop_rational = false;
+
+        /** Minimal number of constraints derived in conflict analysis since the last collection
+         * before derived constraints which do not occur in any clause are removed on restart.
+         * Derived constraints are never removed if it is 0.
+         */
+        int collect_limit = 1000;
     };
 
     virtual ~Linear_arithmetic() = default;
@@ -62,6 +70,30 @@ public:
      */
     void on_variable_resize(Variable::Type type, int num_vars) override;
 
+    /** Remove rational variables unassigned by backtracking from partial sums of constraints
+     *
+     * @param db clause database
+     * @param trail current solver trail before backtracking
+     * @param level decision level to backtrack to
+     */
+    void on_before_backtrack(Database& db, Trail& trail, int level) override;
+
+    /** Remove constraints derived in conflict analysis that do not occur in any clause in @p db
+     * if enough of them have been created since the last collection.
+     *
+     * Boolean variables of removed constraints are reused for new constraints.
+     *
+     * @param db clause database (after learned clauses have been removed)
+     * @param trail current solver trail (empty)
+     */
+    void on_restart(Database& db, Trail& trail) override;
+
+    /** Add memory used by watch lists, bounds, and linear constraints to @p usage
+     *
+     * @param usage memory usage of the solver
+     */
+    void memory_usage(Memory_usage& usage) const override;
+
     /** Add all semantic propagations to the @p trail and update variable bounds
      *
      * @param db clause database
@@ -105,25 +137,31 @@ public:
     Constraint constraint(Trail& trail, Var_range&& vars, Coef_range&& coef,
                           Order_predicate pred, Rational const& rhs)
     {
-        // create the constraint
-        auto cons = constraints.make(std::forward<Var_range>(vars), std::forward<Coef_range>(coef),
-                                     pred, rhs);
+        return make_constraint(trail, std::forward<Var_range>(vars),
+                               std::forward<Coef_range>(coef), pred, rhs, /*is_derived=*/false);
+    }
 
-        // create a new variable in trail if the constraint represents a new variable
-        auto models = relevant_models(trail);
-        if (is_new(models, cons.lit().var()))
-        {
-            if (options.prop_bounds || options.prop_unassigned)
-            {
-                for (auto var : cons.vars())
-                {
-                    occur[var].push_back(cons.lit().is_negation() ? ~cons : cons);
-                }
-            }
-            add_variable(trail, models, cons.lit().var());
-            watch(cons, models.owned());
-        }
-        return cons;
+    /** Create a constraint derived in conflict analysis or return an existing object that
+     * represents the same constraint.
+     *
+     * Unlike constraints created by `constraint()`, new derived constraints are removed on
+     * restart if they do not occur in any clause.
+     *
+     * @tparam Var_range range of LRA variable numbers (ints)
+     * @tparam Coef_range range of coefficients (Value_types)
+     * @param trail current solver trail
+     * @param vars range of LRA variable numbers
+     * @param coef range of coefficients of @p vars
+     * @param pred predicate of the constraint
+     * @param rhs constant on the right-hand-side of the constraint
+     * @return linear constraint
+     */
+    template <std::ranges::range Var_range, std::ranges::range Coef_range>
+    Constraint derive(Trail& trail, Var_range&& vars, Coef_range&& coef, Order_predicate pred,
+                      Rational const& rhs)
+    {
+        return make_constraint(trail, std::forward<Var_range>(vars),
+                               std::forward<Coef_range>(coef), pred, rhs, /*is_derived=*/true);
     }
 
     /** Get current implied bounds for @p lra_var_ord
@@ -180,6 +218,12 @@ public:
      */
     [[nodiscard]] bool is_effectively_decided(Models const& models, int lra_var_ord);
 
+    /** Get a set of literal indices which can be used to remove duplicates from conflict clauses
+     *
+     * @return reusable set of literal indices
+     */
+    inline Epoch_set& conflict_literals() { return conflict_lits; }
+
     /** Get all rational variables with only one allowed value since the last call.
      * 
      * @return list of rational variables that can only be assigned one value.
@@ -192,17 +236,26 @@ public:
     }
 private:
     struct Watched_constraint {
-        // watched constraint
-        Constraint constraint;
-        // index of the next variable to check in `constraint`
+        // boolean variable of the watched constraint (index to `constraints`)
+        int bool_var_ord;
+        // index of the next variable to check in the watched constraint
         int index;
 
         inline Watched_constraint(Constraint const& cons)
-            : constraint(cons), index(std::min<int>(2, cons.size() - 1))
+            : bool_var_ord(cons.lit().var().ord()), index(std::min<int>(2, cons.size() - 1))
         {
         }
     };
 
+    struct Term {
+        // boolean variable of a constraint
+        int bool_var_ord;
+        // coefficient of the variable in the constraint
+        Rational coef;
+        // coefficient of the variable in the integer form of the constraint
+        std::int64_t int_coef;
+    };
+
     // repository of managed linear constraints
     Constraint_repository constraints;
     // map real variable -> list of constraints in which it is watched
@@ -213,13 +266,115 @@ private:
     Model<Rational> cached_values;
     // list of rational variables whose bound has changed at this level
     std::vector<int> to_check;
+    // set of rational variables checked in `finish()`
+    Epoch_set checked;
+    // set of literal indices used to remove duplicate literals from conflict clauses
+    Epoch_set conflict_lits;
     // map real variable -> list of constraints in which it occurs
     std::vector<std::vector<Constraint>> occur;
+    // map real variable -> list of its terms in all constraints
+    std::vector<std::vector<Term>> terms;
+    // stack of rational variables included in partial sums of constraints
+    std::vector<int> summed;
+    // map real variable -> true iff it is included in partial sums of constraints
+    std::vector<bool> is_summed;
+    // boolean variables of constraints derived in conflict analysis
+    std::vector<int> derived;
+    // map boolean variable -> true iff it is in `derived` and it has not been created by
+    // `constraint()`
+    std::vector<bool> is_removable;
+    // number of derived constraints created since the last collection
+    int num_derived = 0;
+    // boolean variables of removed constraints which can be reused
+    std::vector<int> free_vars;
+    // set of boolean variables which occur in some clause (used in `on_restart()`)
+    Epoch_set referenced;
     // parameters of optional features
     Options options;
     // unassigned rational variables with only one allowed value
     std::vector<int> decided;
 
+    /** Create a constraint or return an existing object that represents the same constraint.
+     *
+     * @tparam Var_range range of LRA variable numbers (ints)
+     * @tparam Coef_range range of coefficients (Value_types)
+     * @param trail current solver trail
+     * @param vars range of LRA variable numbers
+     * @param coef range of coefficients of @p vars
+     * @param pred predicate of the constraint
+     * @param rhs constant on the right-hand-side of the constraint
+     * @param is_derived true iff the constraint has been derived in conflict analysis
+     * @return linear constraint
+     */
+    template <std::ranges::range Var_range, std::ranges::range Coef_range>
+    Constraint make_constraint(Trail& trail, Var_range&& vars, Coef_range&& coef,
+                               Order_predicate pred, Rational const& rhs, bool is_derived)
+    {
+        auto models = relevant_models(trail);
+
+        // reuse boolean variable of a removed constraint if it is not assigned
+        auto bool_var_ord = static_cast<int>(constraints.size());
+        if (!free_vars.empty() && !models.boolean().is_defined(free_vars.back()))
+        {
+            bool_var_ord = free_vars.back();
+        }
+
+        // create the constraint
+        auto cons = constraints.make(std::forward<Var_range>(vars), std::forward<Coef_range>(coef),
+                                     pred, rhs, bool_var_ord);
+
+        // create a new variable in trail if the constraint represents a new variable
+        bool is_reused = !free_vars.empty() && cons.lit().var().ord() == free_vars.back();
+        if (is_reused || is_new(models, cons.lit().var()))
+        {
+            if (is_reused)
+            {
+                free_vars.pop_back();
+            }
+            add_variable(trail, models, cons.lit().var());
+
+            if (is_derived)
+            {
+                derived.push_back(cons.lit().var().ord());
+                is_removable[cons.lit().var().ord()] = true;
+                ++num_derived;
+            }
+
+            if (options.prop_bounds || options.prop_unassigned)
+            {
+                for (auto var : cons.vars())
+                {
+                    occur[var].push_back(cons.lit().is_negation() ? ~cons : cons);
+                }
+            }
+            add_terms(models.owned(), cons);
+            watch(cons, models.owned());
+        }
+        else if (!is_derived) // existing constraint is used outside of conflict analysis
+        {
+            is_removable[cons.lit().var().ord()] = false;
+        }
+        return cons;
+    }
+
+    /** Register terms of a new constraint @p cons so that its partial sum is kept up to date.
+     *
+     * Variables in @p cons which are already included in partial sums are added to the partial
+     * sum of @p cons.
+     *
+     * @param model current partial assignment of LRA variables
+     * @param cons new constraint
+     */
+    void add_terms(Model<Rational> const& model, Constraint const& cons);
+
+    /** Add value of a newly assigned variable @p lra_var_ord to partial sums of all constraints
+     * in which it occurs (if it has not been added already).
+     *
+     * @param model current partial assignment of LRA variables
+     * @param lra_var_ord assigned LRA variable
+     */
+    void add_to_sums(Model<Rational> const& model, int lra_var_ord);
+
     /** Start watching LRA variables in @p cons
      *
      * @param cons new constraint
@@ -4,8 +4,13 @@
 #include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
 #include <ostream>
 #include <ranges>
 #include <tuple>
@@ -19,14 +24,41 @@
 
 namespace yaga {
 
+/** Numbers which can be converted from and to 64-bit integers.
+ */
+template <typename T>
+concept Int64_convertible = requires(T const& value, std::int64_t& out) {
+    { value.tryGetLword(out) } -> std::convertible_to<bool>;
+    { T{value.denominator()} };
+    { T{std::int64_t{0}} };
+};
+
 /** Repository of linear constraints.
  *
  * Added constraints are normalized and deduplicated so that there is at most one boolean variable
  * that represents a given constraint or its negation.
+ *
+ * If `Value` is `Int64_convertible`, constraints whose coefficients and constant multiplied by a
+ * common denominator fit into 64-bit integers are also stored in an integer form. Constraints in
+ * the integer form are evaluated using integer arithmetic in models which assign small integers to
+ * their variables. Other constraints and models fall back to arithmetic of `Value`.
  */
 template <typename Value> class Linear_constraints {
 public:
     using Constraint = Linear_constraint<Value>;
+    // integer type used to accumulate products of 64-bit integers without overflow
+    __extension__ typedef __int128 Int128;
+
+    /** Partial evaluation of a constraint in current assignment of variables.
+     */
+    struct Partial_sum {
+        // sum of `coef * value` over variables included in the sum which are not in `int_value`
+        Value value{0};
+        // sum of `scale * coef * value` over variables included in the sum using the integer form
+        Int128 int_value = 0;
+        // number of variables included in `value` or `int_value`
+        int num_vars = 0;
+    };
 
     /** Create a new linear constraint.
      *
@@ -45,16 +77,42 @@ public:
     Constraint make(Var_range&& var_range, Value_range&& coef_range, Order_predicate pred,
                     Value rhs)
     {
-        // normalize the input and add it to the constraints list
+        return make(std::forward<Var_range>(var_range), std::forward<Value_range>(coef_range), pred,
+                    rhs, static_cast<int>(constraints.size()));
+    }
+
+    /** Create a new linear constraint.
+     *
+     * The constraint is normalized. It might be negated (check if `lit().is_negation()` is true).
+     *
+     * If the returned constraint is unique, its boolean variable will be set to @p bool_var_ord.
+     *
+     * @param var_range ordinal numbers of variables in the constraint
+     * @param coef_range coefficients of variables in the constraint
+     * @param pred predicate of the constraint
+     * @param rhs constant on the right-hand-side of the constraint
+     * @param bool_var_ord boolean variable of a removed constraint or the next ordinal number of
+     * boolean variables (i.e., `size()`)
+     * @return new constraint together with literal that represents that constraint
+     */
+    template <std::ranges::range Var_range, std::ranges::range Value_range>
+    Constraint make(Var_range&& var_range, Value_range&& coef_range, Order_predicate pred,
+                    Value rhs, int bool_var_ord)
+    {
+        assert(bool_var_ord <= static_cast<int>(constraints.size()));
+        assert(bool_var_ord == static_cast<int>(constraints.size()) ||
+               constraints[bool_var_ord].empty());
+
+        // normalize the input
         auto mult = find_norm_constant(var_range, coef_range);
         bool is_negation = false;
         Constraint cons;
         if (mult) // constraint with variables
         {
-            auto [lit, range] = add(mult.value(), std::forward<Var_range>(var_range), 
-                                    std::forward<Value_range>(coef_range));
-            cons = constraints.emplace_back(lit, range, norm_pred(mult.value(), pred),
-                                            mult.value() * rhs, this);
+            auto range = add(mult.value(), std::forward<Var_range>(var_range),
+                             std::forward<Value_range>(coef_range));
+            cons = Constraint{Literal{bool_var_ord}, range, norm_pred(mult.value(), pred),
+                              mult.value() * rhs, this};
             is_negation = pred != Order_predicate::eq && mult.value() < Value{0};
         }
         else // constraint without variables
@@ -63,8 +121,7 @@ public:
             is_negation = !pred(Value{0}, rhs);
             rhs = Value{0};
             pred = Order_predicate::eq;
-            Literal lit{static_cast<int>(constraints.size())};
-            cons = constraints.emplace_back(lit, std::pair{0, 0}, pred, rhs, this);
+            cons = Constraint{Literal{bool_var_ord}, std::pair{0, 0}, pred, rhs, this};
             mult = Value{1};
         }
 
@@ -74,20 +131,206 @@ public:
         {
             variables.erase(cons.vars().begin(), cons.vars().end());
             coefficients.erase(cons.coef().begin(), cons.coef().end());
-            constraints.pop_back();
+            int_coefficients.erase(int_coefficients.begin() + cons.pos().first,
+                                   int_coefficients.begin() + cons.pos().second);
+        }
+        else if (bool_var_ord == static_cast<int>(constraints.size()))
+        {
+            constraints.push_back(cons);
+        }
+        else // reuse boolean variable of a removed constraint
+        {
+            constraints[bool_var_ord] = cons;
         }
 
         // negate literal if `*it` represents negation of the input constraint
         auto lit = is_negation ? ~it->lit() : it->lit();
+        if (sums.size() < constraints.size())
+        {
+            sums.resize(constraints.size());
+            int_forms.resize(constraints.size());
+        }
+        if (is_inserted)
+        {
+            int_forms[bool_var_ord] = make_int_form(cons);
+        }
 
         return {lit, it->pos(), it->pred(), it->rhs(), this};
     }
 
+    /** Remove constraint of @p bool_var_ord from the repository.
+     *
+     * The constraint becomes empty and its boolean variable can be passed to `make()` to create
+     * another constraint. Memory of removed constraints is reclaimed by `compact()`.
+     *
+     * @param bool_var_ord boolean variable of a constraint in this repository
+     */
+    void remove(int bool_var_ord)
+    {
+        assert(0 <= bool_var_ord && bool_var_ord < static_cast<int>(constraints.size()));
+        auto& cons = constraints[bool_var_ord];
+        assert(!cons.empty());
+
+        cons_set.erase(cons);
+        num_removed += cons.size();
+        cons = Constraint{};
+        sums[bool_var_ord] = Partial_sum{};
+        int_forms[bool_var_ord] = Int_form{};
+    }
+
+    /** Reclaim memory of constraints removed by `remove()`.
+     *
+     * Values of remaining constraints are moved so that they are stored contiguously. Constraint
+     * objects obtained before this call are invalidated and they have to be obtained again using
+     * `operator[]`.
+     */
+    void compact()
+    {
+        // order non-empty constraints by their position
+        std::vector<int> order;
+        for (int i = 0; i < static_cast<int>(constraints.size()); ++i)
+        {
+            if (!constraints[i].empty())
+            {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+            return constraints[lhs].pos().first < constraints[rhs].pos().first;
+        });
+
+        // move values of constraints to the front
+        int end = 0;
+        for (auto bool_var_ord : order)
+        {
+            auto& cons = constraints[bool_var_ord];
+            auto [first, last] = cons.pos();
+            std::move(variables.begin() + first, variables.begin() + last, variables.begin() + end);
+            std::move(coefficients.begin() + first, coefficients.begin() + last,
+                      coefficients.begin() + end);
+            std::move(int_coefficients.begin() + first, int_coefficients.begin() + last,
+                      int_coefficients.begin() + end);
+            cons.position = {end, end + (last - first)};
+            end += last - first;
+        }
+        variables.erase(variables.begin() + end, variables.end());
+        coefficients.erase(coefficients.begin() + end, coefficients.end());
+        int_coefficients.erase(int_coefficients.begin() + end, int_coefficients.end());
+        num_removed = 0;
+
+        // deduplication set contains copies of constraints with old positions
+        cons_set.clear();
+        for (auto const& cons : constraints)
+        {
+            if (cons.constraints == this) // skip removed constraints and other boolean variables
+            {
+                cons_set.insert(cons);
+            }
+        }
+    }
+
+    /** Get total number of variables in removed constraints whose memory has not been reclaimed
+     * yet by `compact()`.
+     *
+     * @return number of unused values in the repository
+     */
+    inline int garbage() const { return num_removed; }
+
     /** Allocate memory for @p num_bool_vars boolean variables
      *
      * @param num_bool_vars new number of boolean variables
      */
-    void resize(int num_bool_vars) { constraints.resize(num_bool_vars); }
+    void resize(int num_bool_vars)
+    {
+        constraints.resize(num_bool_vars);
+        sums.resize(num_bool_vars);
+        int_forms.resize(num_bool_vars);
+    }
+
+    /** Add a product of coefficient and value of a newly assigned variable to the partial sum of
+     * a constraint.
+     *
+     * Partial sums are not maintained by this class. If the number of variables included in the
+     * partial sum is equal to the number of assigned variables, `eval()` and `implied_value()` use
+     * the partial sum instead of evaluating the whole constraint.
+     *
+     * @param bool_var_ord boolean variable of a constraint
+     * @param coef coefficient of the assigned variable in the constraint
+     * @param int_coef coefficient of the assigned variable in the integer form (see `int_coef()`)
+     * @param value value of the assigned variable
+     */
+    inline void include(int bool_var_ord, Value const& coef, std::int64_t int_coef,
+                        Value const& value)
+    {
+        auto& sum = sums[bool_var_ord];
+        if (auto term = int_term(bool_var_ord, int_coef, value))
+        {
+            sum.int_value += term.value();
+        }
+        else
+        {
+            sum.value += coef * value;
+        }
+        ++sum.num_vars;
+    }
+
+    /** Remove a product of coefficient and value of a variable which is about to be unassigned
+     * from the partial sum of a constraint.
+     *
+     * @param bool_var_ord boolean variable of a constraint
+     * @param coef coefficient of the variable in the constraint
+     * @param int_coef coefficient of the variable in the integer form (see `int_coef()`)
+     * @param value value of the variable previously passed to `include()`
+     */
+    inline void exclude(int bool_var_ord, Value const& coef, std::int64_t int_coef,
+                        Value const& value)
+    {
+        auto& sum = sums[bool_var_ord];
+        assert(sum.num_vars > 0);
+        if (auto term = int_term(bool_var_ord, int_coef, value))
+        {
+            sum.int_value -= term.value();
+        }
+        else
+        {
+            sum.value -= coef * value;
+        }
+        --sum.num_vars;
+    }
+
+    /** Check whether @p cons is stored in the integer form.
+     *
+     * @param cons linear constraint from this repository
+     * @return true iff @p cons is evaluated using integer arithmetic in models which assign small
+     * integers to its variables
+     */
+    inline bool is_int(Constraint const& cons) const { return find_int_form(cons) != nullptr; }
+
+    /** Swap two variables of @p cons together with their coefficients.
+     *
+     * @param cons linear constraint from this repository
+     * @param i index of a variable in @p cons
+     * @param j index of a variable in @p cons
+     */
+    inline void swap(Constraint const& cons, int i, int j)
+    {
+        assert(0 <= i && i < cons.size());
+        assert(0 <= j && j < cons.size());
+        auto first = cons.pos().first;
+        std::swap(variables[first + i], variables[first + j]);
+        std::swap(coefficients[first + i], coefficients[first + j]);
+        std::swap(int_coefficients[first + i], int_coefficients[first + j]);
+    }
+
+    /** Get partial sum of @p cons
+     *
+     * @param cons linear constraint from this repository
+     * @return current partial sum of @p cons
+     */
+    inline Partial_sum const& partial_sum(Constraint const& cons) const
+    {
+        return sums[cons.lit().var().ord()];
+    }
 
     /** Find boolean constraint which implements @p bool_var_ord
      *
@@ -104,6 +347,20 @@ public:
         return constraints[bool_var_ord];
     }
 
+    /** Get constraint which implements @p bool_var_ord without copying it
+     *
+     * Precondition: @p bool_var_ord is a boolean variable of a constraint in this repository.
+     * The reference is invalidated by `make()`, `resize()` and `compact()`.
+     *
+     * @param bool_var_ord ordinal number of a boolean variable
+     * @return reference to the constraint which implements @p bool_var_ord
+     */
+    inline Constraint const& at(int bool_var_ord) const
+    {
+        assert(0 <= bool_var_ord && bool_var_ord < static_cast<int>(constraints.size()));
+        return constraints[bool_var_ord];
+    }
+
     /** Get range of variables of @p cons
      *
      * @param cons linear constraint
@@ -148,6 +405,19 @@ public:
                                      coefficients.begin() + cons.pos().second};
     }
 
+    /** Get range of coefficients of @p cons in the integer form
+     *
+     * Values are unspecified if @p cons is not stored in the integer form (see `is_int()`).
+     *
+     * @param cons linear constraint
+     * @return range of coefficients of @p cons multiplied by the common denominator
+     */
+    inline auto int_coef(Constraint const& cons) const
+    {
+        return std::ranges::subrange{int_coefficients.begin() + cons.pos().first,
+                                     int_coefficients.begin() + cons.pos().second};
+    }
+
     /** Evaluate linear constraint in @p model
      *
      * Precondition: all variables in the @p cons are assigned.
@@ -158,16 +428,20 @@ public:
      */
     inline bool eval(Model<Value> const& model, Constraint const& cons) const
     {
-        auto rhs = cons.rhs();
-        auto [var_it, var_end] = vars(cons);
-        auto [coef_it, coef_end] = coef(cons);
-        for (; var_it != var_end; ++var_it, ++coef_it)
+        auto form = find_int_form(cons);
+        if (auto sum = find_sum(cons); sum && sum->num_vars == cons.size())
         {
-            assert(coef_it != coef_end);
-            assert(model.is_defined(*var_it));
-            rhs -= *coef_it * model.value(*var_it);
+            if (form && sum->value == Value{0})
+            {
+                return cons.lit().is_negation() ^
+                       cons.pred()(Int128{0}, Int128{form->rhs} - sum->int_value);
+            }
+            if (sum->int_value == 0)
+            {
+                return cons.lit().is_negation() ^ cons.pred()(Value{0}, cons.rhs() - sum->value);
+            }
         }
-        return cons.lit().is_negation() ^ cons.pred()(Value{0}, rhs);
+        return eval_model(model, cons, form);
     }
 
     /** Given @p cons with exactly one unassigned variable, evaluate the rest of the constraint.
@@ -181,42 +455,263 @@ public:
      */
     inline Value implied_value(Model<Value> const& model, Constraint const& cons) const
     {
-        auto value = cons.rhs();
-        auto [var_it, var_end] = vars(cons);
-        auto [coef_it, coef_end] = coef(cons);
-        if (var_it == var_end)
+        auto form = find_int_form(cons);
+        if (auto sum = find_sum(cons); sum && sum->num_vars + 1 == cons.size())
         {
-            return value;
-        }
-
-        ++var_it;
-        ++coef_it;
-        for (; var_it != var_end; ++var_it, ++coef_it)
-        {
-            assert(coef_it != coef_end);
-            assert(model.is_defined(*var_it));
-            value -= *coef_it * model.value(*var_it);
+            if (form && sum->value == Value{0})
+            {
+                if (auto value = to_value(*form, Int128{form->rhs} - sum->int_value))
+                {
+                    return value.value();
+                }
+            }
+            else if (sum->int_value == 0)
+            {
+                return cons.rhs() - sum->value;
+            }
         }
-        return value;
+        return implied_value_model(model, cons, form);
     }
 
     inline auto begin() const { return constraints.begin(); }
     inline auto end() const { return constraints.end(); }
     inline auto size() const { return constraints.size(); }
 
+    /** Get heap memory used by this repository
+     *
+     * Memory of the deduplication set is estimated from the number of its nodes and buckets.
+     *
+     * @return number of bytes allocated by constraints in this repository
+     */
+    inline std::size_t memory_usage() const
+    {
+        return variables.capacity() * sizeof(int) + coefficients.capacity() * sizeof(Value) +
+               int_coefficients.capacity() * sizeof(std::int64_t) +
+               constraints.capacity() * sizeof(Constraint) +
+               cons_set.bucket_count() * sizeof(void*) +
+               cons_set.size() * (sizeof(Constraint) + 2 * sizeof(void*)) +
+               sums.capacity() * sizeof(Partial_sum) + int_forms.capacity() * sizeof(Int_form);
+    }
+
 private:
     using Constraint_hash = Linear_constraint_hash<Value>;
     using Constraint_equal = Linear_constraint_equal<Value>;
     using Constraint_set = std::unordered_set<Constraint, Constraint_hash, Constraint_equal>;
 
+    /** Constraint multiplied by a positive integer `scale` so that all its coefficients and the
+     * constant on the right-hand-side are integers.
+     */
+    struct Int_form {
+        // common denominator of coefficients and rhs or 0 if the constraint has no integer form
+        std::int64_t scale = 0;
+        // `scale * rhs`
+        std::int64_t rhs = 0;
+    };
+
     // vector of variables of all linear constraints
     std::vector<int> variables;
     // vector of coefficients of all linear constraints
     std::vector<Value> coefficients;
+    // vector of coefficients of all linear constraints in the integer form (`scale * coef`)
+    std::vector<std::int64_t> int_coefficients;
     // map boolean variable -> linear constraint
     std::vector<Constraint> constraints;
     // set of constraints for deduplication
     Constraint_set cons_set;
+    // map boolean variable -> partial sum of the constraint
+    std::vector<Partial_sum> sums;
+    // map boolean variable -> integer form of the constraint
+    std::vector<Int_form> int_forms;
+    // number of values of removed constraints
+    int num_removed = 0;
+
+    // find partial sum of a constraint from this repository
+    inline Partial_sum const* find_sum(Constraint const& cons) const
+    {
+        auto bool_var_ord = cons.lit().var().ord();
+        if (cons.empty() || bool_var_ord >= static_cast<int>(sums.size()))
+        {
+            return nullptr;
+        }
+        return &sums[bool_var_ord];
+    }
+
+    // evaluate `cons` without partial sums
+    bool eval_model(Model<Value> const& model, Constraint const& cons, Int_form const* form) const
+    {
+        if (form)
+        {
+            if (auto lhs = int_dot(model, cons, 0))
+            {
+                return cons.lit().is_negation() ^
+                       cons.pred()(Int128{0}, Int128{form->rhs} - lhs.value());
+            }
+        }
+
+        auto rhs = cons.rhs();
+        auto [var_it, var_end] = vars(cons);
+        auto [coef_it, coef_end] = coef(cons);
+        for (; var_it != var_end; ++var_it, ++coef_it)
+        {
+            assert(coef_it != coef_end);
+            assert(model.is_defined(*var_it));
+            rhs -= *coef_it * model.value(*var_it);
+        }
+        return cons.lit().is_negation() ^ cons.pred()(Value{0}, rhs);
+    }
+
+    // compute implied value of the first variable of `cons` without partial sums
+    Value implied_value_model(Model<Value> const& model, Constraint const& cons,
+                              Int_form const* form) const
+    {
+        if (form && !cons.empty())
+        {
+            if (auto lhs = int_dot(model, cons, 1))
+            {
+                if (auto value = to_value(*form, Int128{form->rhs} - lhs.value()))
+                {
+                    return value.value();
+                }
+            }
+        }
+
+        auto value = cons.rhs();
+        auto [var_it, var_end] = vars(cons);
+        auto [coef_it, coef_end] = coef(cons);
+        if (var_it == var_end)
+        {
+            return value;
+        }
+
+        ++var_it;
+        ++coef_it;
+        for (; var_it != var_end; ++var_it, ++coef_it)
+        {
+            assert(coef_it != coef_end);
+            assert(model.is_defined(*var_it));
+            value -= *coef_it * model.value(*var_it);
+        }
+        return value;
+    }
+
+    // find integer form of a constraint from this repository or nullptr if it has none
+    inline Int_form const* find_int_form(Constraint const& cons) const
+    {
+        auto bool_var_ord = cons.lit().var().ord();
+        if (cons.constraints != this || bool_var_ord >= static_cast<int>(int_forms.size()) ||
+            int_forms[bool_var_ord].scale == 0)
+        {
+            return nullptr;
+        }
+        return &int_forms[bool_var_ord];
+    }
+
+    // compute the integer form of a normalized constraint and store its integer coefficients
+    Int_form make_int_form(Constraint const& cons)
+    {
+        if constexpr (Int64_convertible<Value>)
+        {
+            // find common denominator of all coefficients and rhs
+            std::int64_t scale = 1;
+            auto add_denominator = [&](Value const& value) {
+                std::int64_t den = 0;
+                if (!Value{value.denominator()}.tryGetLword(den))
+                {
+                    return false;
+                }
+                return !__builtin_mul_overflow(scale / std::gcd(scale, den), den, &scale);
+            };
+            if (!add_denominator(cons.rhs()) ||
+                !std::ranges::all_of(coef(cons), add_denominator))
+            {
+                return {};
+            }
+
+            Int_form form{scale, 0};
+            Value int_scale{scale};
+            if (!Value{int_scale * cons.rhs()}.tryGetLword(form.rhs))
+            {
+                return {};
+            }
+            auto out_it = int_coefficients.begin() + cons.pos().first;
+            for (auto const& c : coef(cons))
+            {
+                if (!Value{int_scale * c}.tryGetLword(*out_it++))
+                {
+                    return {};
+                }
+            }
+            return form;
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    // compute `scale * coef * value` of a variable in the integer form if it does not overflow
+    inline std::optional<std::int64_t> int_term(int bool_var_ord, std::int64_t int_coef,
+                                                Value const& value) const
+    {
+        if constexpr (Int64_convertible<Value>)
+        {
+            std::int64_t int_value = 0;
+            std::int64_t term = 0;
+            if (int_forms[bool_var_ord].scale != 0 && value.tryGetLword(int_value) &&
+                !__builtin_mul_overflow(int_coef, int_value, &term))
+            {
+                return term;
+            }
+        }
+        return {};
+    }
+
+    // compute dot product of integer coefficients of `cons` and values of its variables starting
+    // from `first`. Returns none if some value is not an integer or a product overflows.
+    inline std::optional<Int128> int_dot(Model<Value> const& model, Constraint const& cons,
+                                         int first) const
+    {
+        Int128 result = 0;
+        for (int i = cons.pos().first + first; i < cons.pos().second; ++i)
+        {
+            assert(model.is_defined(variables[i]));
+            if constexpr (Int64_convertible<Value>)
+            {
+                std::int64_t int_value = 0;
+                std::int64_t product = 0;
+                if (!model.value(variables[i]).tryGetLword(int_value) ||
+                    __builtin_mul_overflow(int_coefficients[i], int_value, &product))
+                {
+                    return {};
+                }
+                result += product;
+            }
+            else
+            {
+                return {};
+            }
+        }
+        return result;
+    }
+
+    // convert `value / scale` to Value if `value` fits into a 64-bit integer
+    inline std::optional<Value> to_value(Int_form const& form, Int128 value) const
+    {
+        if constexpr (Int64_convertible<Value>)
+        {
+            if (value >= std::numeric_limits<std::int64_t>::min() &&
+                value <= std::numeric_limits<std::int64_t>::max())
+            {
+                Value result{static_cast<std::int64_t>(value)};
+                if (form.scale != 1)
+                {
+                    result /= Value{form.scale};
+                }
+                return result;
+            }
+        }
+        return {};
+    }
 
     // find a constant by which the constraint will be multiplied in order to normalize coefficients
     template <std::ranges::range Var_range, std::ranges::range Coef_range>
@@ -263,11 +758,10 @@ private:
 
     // copy constraint values multiplied by normalization constant `mult`
     template <std::ranges::range Var_range, std::ranges::range Coef_range>
-    inline std::pair<Literal, std::pair<int, int>> add(Value const& mult, Var_range&& var_range,
-                                                       Coef_range&& coef_range)
+    inline std::pair<int, int> add(Value const& mult, Var_range&& var_range,
+                                   Coef_range&& coef_range)
     {
         auto size = std::distance(std::begin(var_range), std::end(var_range));
-        Literal lit{static_cast<int>(constraints.size())};
         std::pair<int, int> range{static_cast<int>(variables.size()),
                                   static_cast<int>(variables.size() + size)};
 
@@ -293,13 +787,14 @@ private:
         variables.erase(out_var_it, variables.end());
         coefficients.erase(out_coef_it, coefficients.end());
         range.second = static_cast<int>(variables.size());
+        int_coefficients.resize(range.second, 0);
 
         // normalize coefficients of the constraint
         for (auto& c : coefficients | std::views::drop(range.first))
         {
             c *= mult;
         }
-        return {lit, range};
+        return range;
     }
 };
 
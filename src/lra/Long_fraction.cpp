@@ -18,20 +18,32 @@ Jan Kofron (Charles University, Prague)
 namespace yaga {
 
     mpq_ptr Long_fraction::mpqPool::alloc() {
+        std::lock_guard lock{mutex};
         mpq_ptr r;
         if (!pool.empty()) {
             r = pool.top();
             pool.pop();
         } else {
-            r = store.emplace().get_mpq_t();
+            r = store.emplace_back().get_mpq_t();
         }
         return r;
     }
 
     void Long_fraction::mpqPool::release(mpq_ptr ptr) {
+        std::lock_guard lock{mutex};
         pool.push(ptr);
     }
 
+    std::size_t Long_fraction::mpqPool::memory_usage() const {
+        std::lock_guard lock{mutex};
+        std::size_t result = store.size() * sizeof(mpq_class) + pool.size() * sizeof(mpq_ptr);
+        for (auto const& value : store) {
+            auto q = value.get_mpq_t();
+            result += (mpq_numref(q)->_mp_alloc + mpq_denref(q)->_mp_alloc) * sizeof(mp_limb_t);
+        }
+        return result;
+    }
+
     Long_fraction::Long_fraction(const char *s, const int base) {
         mpq = pool.alloc();
         mpq_set_str(mpq, s, base);
@@ -68,6 +80,19 @@ namespace yaga {
         }
     }
 
+    Long_fraction::Long_fraction(lword x)  {
+        if (x < WORD_MIN || x > WORD_MAX) {
+            mpq = pool.alloc();
+            mpz_set_si(mpq_numref(mpq), x);
+            mpz_set_ui(mpq_denref(mpq), 1);
+            state = State::MPQ_ALLOCATED_AND_VALID;
+        } else {
+            num = static_cast<word>(x);
+            den = 1;
+            state = State::WORD_VALID;
+        }
+    }
+
 
 
     void Long_fraction::reset() {
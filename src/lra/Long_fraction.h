@@ -19,6 +19,8 @@ Jan Kofron (Charles University, Prague)
 #include <gmpxx.h>
 #include <cassert>
 #include <climits>
+#include <deque>
+#include <mutex>
 #include <stack>
 #include <vector>
 #include <cstdint>
@@ -81,13 +83,20 @@ inline ulword absVal(lword x) {
 
 class Long_fraction
 {
+    // Shared by all threads (e.g., the parser and the internalization worker with
+    // --pipeline), so every operation is guarded by a mutex. A thread-local pool
+    // would not work since numbers allocated on one thread outlive it or are
+    // released on another thread.
     class mpqPool
     {
-        std::stack<mpq_class> store; // uses deque as storage to avoid realloc
+        mutable std::mutex mutex;
+        std::deque<mpq_class> store; // uses deque as storage to avoid realloc
         std::stack<mpq_ptr, std::vector<mpq_ptr>> pool;
     public:
         mpq_ptr alloc();
         void release(mpq_ptr);
+        // number of bytes allocated by the pool including limbs of all allocated numbers
+        std::size_t memory_usage() const;
     };
     State state;
     word num{0};
@@ -134,6 +143,7 @@ public:
     constexpr Long_fraction       () : state{State::WORD_VALID}, num(0), den(1) {}
     constexpr Long_fraction       (word x) : state{State::WORD_VALID}, num(x), den(1) {}
     Long_fraction                 (uint32_t x);
+    explicit Long_fraction        (lword x);
 
     inline Long_fraction(word n, uword d);
     // The string must be in the format accepted by mpq_set_str, e.g., "1/2"
@@ -233,6 +243,11 @@ public:
     void print(std::ostream &) const;
     std::string get_str() const;
 
+    // number of bytes allocated by the shared pool of mpq numbers (the pool is
+    // locked, but limbs of numbers owned by other threads are read without
+    // synchronization, so call this only while no other thread does arithmetic)
+    static std::size_t pool_memory_usage() { return pool.memory_usage(); }
+
     inline double get_d  () const;
 
     inline bool operator==(const Long_fraction& b) const;
@@ -295,6 +310,21 @@ public:
         }
     }
 
+    // Store this number to `out` iff it is an integer which fits into lword
+    bool tryGetLword(lword& out) const {
+        if (wordPartValid()) {
+            if (den != 1)
+                return false;
+            out = num;
+            return true;
+        }
+        assert(mpqPartValid());
+        if (!isInteger() || !mpz_fits_slong_p(mpq_numref(mpq)))
+            return false;
+        out = mpz_get_si(mpq_numref(mpq));
+        return true;
+    }
+
     bool isInteger() const {
         if (wordPartValid())
             return den == 1;
@@ -650,7 +680,9 @@ inline Long_fraction::Long_fraction(word n, uword d) : state{State::WORD_VALID}
     } else {
         uword common = gcd<uword>(absVal(n), d);
         if (common > 1) {
-            num = n / common;
+            // divide the absolute value since common may not fit in word
+            word abs_num = static_cast<word>(absVal(n) / common);
+            num = n < 0 ? -abs_num : abs_num;
             den = d / common;
         } else {
             num = n;
@@ -123,8 +123,8 @@ Fm_elimination::Constraint Fm_elimination::finish(Trail& trail)
         return trail.decision_level(lhs_var).value() > trail.decision_level(rhs_var).value();
     });
 
-    auto cons = lra->constraint(trail, std::views::keys(poly.variables),
-                                std::views::values(poly.variables), pred, -poly.constant);
+    auto cons = lra->derive(trail, std::views::keys(poly.variables),
+                            std::views::values(poly.variables), pred, -poly.constant);
     auto models = lra->relevant_models(trail);
     if (!models.boolean().is_defined(cons.lit().var().ord()))
     {
@@ -154,8 +154,12 @@ Fm_elimination Lra_conflict_analysis::eliminate(Models const& models, Bounds& bo
 Clause& Lra_conflict_analysis::finish()
 {
     // remove duplicate literals from the conflict clause
-    std::sort(conflict().begin(), conflict().end(), Literal_comparer{});
-    conflict().erase(std::unique(conflict().begin(), conflict().end()), conflict().end());
+    auto& lits = lra->conflict_literals();
+    lits.clear();
+    auto end = std::remove_if(conflict().begin(), conflict().end(), [&](Literal lit) {
+        return !lits.insert(lit.var().ord() * 2 + static_cast<int>(lit.is_negation()));
+    });
+    conflict().erase(end, conflict().end());
     return clause;
 }
 
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <functional>
 #include <limits>
 #include <optional>
@@ -185,6 +186,20 @@ public:
         return false;
     }
 
+    /** Get heap memory used by this bound
+     *
+     * @return number of bytes allocated by bounds on which this bound depends
+     */
+    inline std::size_t memory_usage() const
+    {
+        std::size_t result = deps.capacity() * sizeof(Implied_value<Value>);
+        for (auto const& dep : deps)
+        {
+            result += dep.memory_usage();
+        }
+        return result;
+    }
+
 private:
     // bounded theory variable ordinal number
     int bound_var;
@@ -274,6 +289,15 @@ public:
     using Lower_bound_comparer = Bound_comparer<Value, std::greater<Value>>;
     using Upper_bound_comparer = Bound_comparer<Value, std::less<Value>>;
 
+    /** Remove all bounds and disallowed values
+     */
+    inline void clear()
+    {
+        ub.clear();
+        lb.clear();
+        disallowed.clear();
+    }
+
     /** Get current tightest implied upper bound
      *
      * @param models partial assignment of variables
@@ -434,6 +458,24 @@ public:
                check_upper_bound(models, value);
     }
 
+    /** Get heap memory used by stacks of bounds and inequalities of this variable
+     *
+     * @return number of bytes allocated by this object
+     */
+    inline std::size_t memory_usage() const
+    {
+        std::size_t result = 0;
+        for (auto values : {&ub, &lb, &disallowed})
+        {
+            result += values->capacity() * sizeof(Implied_value_type);
+            for (auto const& value : *values)
+            {
+                result += value.memory_usage();
+            }
+        }
+        return result;
+    }
+
 private:
     // stack with upper bounds
     std::vector<Implied_value_type> ub;
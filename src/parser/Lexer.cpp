@@ -0,0 +1,56 @@
+#include "Lexer.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace yaga::parser {
+
+void Lexer::parseError(std::string_view msg) { throw std::logic_error(std::string(msg)); }
+
+bool Lexer::eat_token_choice(Token t, Token f)
+{
+    Token tt = next_token();
+    if (tt == t)
+    {
+        return true;
+    }
+    else if (tt != f)
+    {
+        unexpected_token_error(tt);
+    }
+    return false;
+}
+
+void Lexer::eat_token(Token t)
+{
+    Token tt = next_token();
+    if (t != tt) {
+        unexpected_token_error(tt);
+    }
+}
+
+Token Lexer::next_token()
+{
+    if (pending_token)
+    {
+        Token t = pending_token.value();
+        pending_token.reset();
+        return t;
+    }
+    return lex_scan();
+}
+
+void Lexer::push_back_token(Token t)
+{
+    assert(!pending_token);
+    pending_token = t;
+}
+
+void Lexer::unexpected_token_error(Token)
+{
+    std::string val{token_string()};
+    throw std::logic_error("Unexpected token encountered: " + val);
+}
+
+} // namespace yaga::parser
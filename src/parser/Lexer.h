@@ -0,0 +1,67 @@
+#ifndef YAGA_LEXER_H
+#define YAGA_LEXER_H
+
+#include "smt2_tokens.h"
+
+#include <optional>
+#include <string_view>
+
+namespace yaga::parser {
+
+/**
+ * Stream of SMT-LIBv2 tokens consumed by the parsers.
+ *
+ * Implementations only provide the scanner (`lex_scan()`) and the text of the last scanned token.
+ */
+class Lexer {
+
+protected:
+    virtual Token lex_scan() = 0;
+
+public:
+    virtual ~Lexer() = default;
+
+    void unexpected_token_error(Token token);
+
+    void parseError(std::string_view msg);
+
+    /**
+     * Consumes the next token; errors if it is not the token t
+     * @param t the expected token
+     */
+    void eat_token(Token t);
+
+    /**
+     * Consumes the next token; returns true if it was token t, false if it was token f; error otherwise
+     * @param t first possible token
+     * @param f second possible token
+     * @return true if the consumed token was t, false if it was f
+     */
+    bool eat_token_choice(Token t, Token f);
+
+    /**
+     * Consumes and returns the next token
+     * @return the next token
+     */
+    Token next_token();
+
+    /**
+     * Returns the last consumed token back so that the next call to `next_token()` returns it again
+     * @param t the last consumed token
+     */
+    void push_back_token(Token t);
+
+    /**
+     * Gets the string representation of the last consumed token. The view is only valid until the
+     * next token is consumed.
+     */
+    virtual std::string_view token_string() = 0;
+
+private:
+    // token returned back by `push_back_token()`
+    std::optional<Token> pending_token;
+};
+
+} // namespace yaga::parser
+
+#endif // YAGA_LEXER_H
@@ -0,0 +1,242 @@
+#include "Mmap_lexer.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace yaga::parser {
+
+namespace {
+
+// reserved words of SMT-LIBv2 sorted by their text so that they can be found by binary search
+constexpr auto reserved_words = [] {
+    std::array<std::pair<std::string_view, Token>, 30> words{{
+        {"!", Token::ATTRIBUTE_TOK},
+        {"_", Token::INDEX_TOK},
+        {"as", Token::AS_TOK},
+        {"assert", Token::ASSERT_TOK},
+        {"check-sat", Token::CHECK_SAT_TOK},
+        {"check-sat-assuming", Token::CHECK_SAT_ASSUMING_TOK},
+        {"declare-const", Token::DECLARE_CONST_TOK},
+        {"declare-fun", Token::DECLARE_FUN_TOK},
+        {"declare-sort", Token::DECLARE_SORT_TOK},
+        {"define-const", Token::DEFINE_CONST_TOK},
+        {"define-fun", Token::DEFINE_FUN_TOK},
+        {"define-sort", Token::DEFINE_SORT_TOK},
+        {"echo", Token::ECHO_TOK},
+        {"exit", Token::EXIT_TOK},
+        {"get-assertions", Token::GET_ASSERTIONS_TOK},
+        {"get-assignment", Token::GET_ASSIGNMENT_TOK},
+        {"get-info", Token::GET_INFO_TOK},
+        {"get-model", Token::GET_MODEL_TOK},
+        {"get-option", Token::GET_OPTION_TOK},
+        {"get-unsat-core", Token::GET_UNSAT_CORE_TOK},
+        {"get-value", Token::GET_VALUE_TOK},
+        {"let", Token::LET_TOK},
+        {"match", Token::MATCH_TOK},
+        {"par", Token::PAR_TOK},
+        {"pop", Token::POP_TOK},
+        {"push", Token::PUSH_TOK},
+        {"reset", Token::RESET_TOK},
+        {"set-info", Token::SET_INFO_TOK},
+        {"set-logic", Token::SET_LOGIC_TOK},
+        {"set-option", Token::SET_OPTION_TOK},
+    }};
+    std::ranges::sort(words);
+    return words;
+}();
+
+// character classes of simple symbols
+constexpr auto symbol_chars = [] {
+    std::array<bool, 256> is_symbol_char{};
+    for (unsigned char c : std::string_view{"~!@$%^&*+=<>.?/_-0123456789"})
+    {
+        is_symbol_char[c] = true;
+    }
+    for (int c = 'a'; c <= 'z'; ++c)
+    {
+        is_symbol_char[c] = true;
+        is_symbol_char[c - 'a' + 'A'] = true;
+    }
+    return is_symbol_char;
+}();
+
+inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool is_symbol_char(char c) { return symbol_chars[static_cast<unsigned char>(c)]; }
+
+inline bool is_symbol_start(char c) { return is_symbol_char(c) && !is_digit(c); }
+
+inline bool is_hex_digit(char c)
+{
+    return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+} // namespace
+
+Mmap_lexer::Mmap_lexer(std::string const& file_name)
+{
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), file_name);
+    }
+
+    struct stat file_stat{};
+    if (::fstat(fd, &file_stat) < 0)
+    {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), file_name);
+    }
+
+    mapping_size = static_cast<std::size_t>(file_stat.st_size);
+    if (mapping_size > 0) // empty files cannot be mapped
+    {
+        mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            int error = errno;
+            mapping = nullptr;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), file_name);
+        }
+        ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+    }
+    ::close(fd); // the mapping remains valid
+
+    next = static_cast<char const*>(mapping);
+    end = next + mapping_size;
+}
+
+Mmap_lexer::Mmap_lexer(std::string_view input) : next(input.data()), end(input.data() + input.size())
+{
+}
+
+Mmap_lexer::~Mmap_lexer()
+{
+    if (mapping != nullptr)
+    {
+        ::munmap(mapping, mapping_size);
+    }
+}
+
+void Mmap_lexer::skip_whitespace()
+{
+    while (next < end)
+    {
+        char c = *next;
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\n')
+        {
+            ++next;
+        }
+        else if (c == ';') // skip comment until newline
+        {
+            next = std::find(next, end, '\n');
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+void Mmap_lexer::skip_symbol_chars()
+{
+    while (next < end && is_symbol_char(*next))
+    {
+        ++next;
+    }
+}
+
+Token Mmap_lexer::lex_scan()
+{
+    skip_whitespace();
+    char const* begin = next;
+    if (next == end)
+    {
+        return make_token(begin, Token::EOF_TOK);
+    }
+
+    char c = *next++;
+    if (c == '(')
+    {
+        return make_token(begin, Token::LPAREN_TOK);
+    }
+    if (c == ')')
+    {
+        return make_token(begin, Token::RPAREN_TOK);
+    }
+    if (is_digit(c))
+    {
+        next = std::find_if_not(next, end, is_digit);
+        if (next + 1 < end && *next == '.' && is_digit(next[1]))
+        {
+            next = std::find_if_not(next + 1, end, is_digit);
+            return make_token(begin, Token::DECIMAL_LITERAL);
+        }
+        return make_token(begin, Token::INTEGER_LITERAL);
+    }
+    if (is_symbol_start(c))
+    {
+        skip_symbol_chars();
+        make_token(begin, Token::SYMBOL);
+        auto it = std::ranges::lower_bound(reserved_words, token, {},
+                                           &std::pair<std::string_view, Token>::first);
+        return it != reserved_words.end() && it->first == token ? it->second : Token::SYMBOL;
+    }
+    if (c == ':' && next < end && is_symbol_start(*next))
+    {
+        skip_symbol_chars();
+        return make_token(begin, Token::KEYWORD);
+    }
+    if (c == '|')
+    {
+        auto closing = std::find_if(next, end, [](char c) { return c == '|' || c == '\\'; });
+        if (closing != end && *closing == '|')
+        {
+            next = closing + 1;
+            return make_token(begin, Token::QUOTED_SYMBOL);
+        }
+    }
+    else if (c == '"')
+    {
+        // `""` is an escaped quote inside of a string literal
+        for (auto quote = std::find(next, end, '"'); quote != end; quote = std::find(next, end, '"'))
+        {
+            next = quote + 1;
+            if (next == end || *next != '"')
+            {
+                return make_token(begin, Token::STRING_LITERAL);
+            }
+            ++next;
+        }
+    }
+    else if (c == '#' && next < end && (*next == 'x' || *next == 'b'))
+    {
+        bool is_hex = *next == 'x';
+        auto digits_end = is_hex ? std::find_if_not(next + 1, end, is_hex_digit)
+                                 : std::find_if_not(next + 1, end, [](char c) {
+                                       return c == '0' || c == '1';
+                                   });
+        if (digits_end != next + 1)
+        {
+            next = digits_end;
+            return make_token(begin, is_hex ? Token::HEX_LITERAL : Token::BINARY_LITERAL);
+        }
+    }
+
+    next = begin + 1;
+    make_token(begin, Token::NONE);
+    parseError("Error finding token");
+    return Token::NONE;
+}
+
+} // namespace yaga::parser
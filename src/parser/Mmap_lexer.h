@@ -0,0 +1,77 @@
+#ifndef YAGA_MMAP_LEXER_H
+#define YAGA_MMAP_LEXER_H
+
+#include "Lexer.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace yaga::parser {
+
+/**
+ * Hand-written lexer which scans a contiguous buffer in memory (usually a file mapped to memory
+ * using `mmap`). Tokens are views into the buffer, so they are never copied.
+ *
+ * It recognizes the same tokens as the flex lexer in `smt2_lexer.ll`.
+ */
+class Mmap_lexer : public Lexer {
+public:
+    /** Map file @p file_name to memory and scan its content
+     *
+     * @param file_name path to a regular file
+     * @throws std::system_error if the file cannot be opened or mapped to memory
+     */
+    explicit Mmap_lexer(std::string const& file_name);
+
+    /** Scan @p input
+     *
+     * @param input content to scan (it has to outlive the lexer)
+     */
+    explicit Mmap_lexer(std::string_view input);
+
+    ~Mmap_lexer() override;
+
+    Mmap_lexer(Mmap_lexer const&) = delete;
+    Mmap_lexer& operator=(Mmap_lexer const&) = delete;
+
+    Token lex_scan() override;
+
+    inline std::string_view token_string() override { return token; }
+
+private:
+    // memory mapped by `mmap` (nullptr if the input is not owned by this lexer)
+    void* mapping = nullptr;
+    // size of `mapping` in bytes
+    std::size_t mapping_size = 0;
+    // next character to scan
+    char const* next = nullptr;
+    // end of the input
+    char const* end = nullptr;
+    // the last scanned token
+    std::string_view token;
+
+    /** Skip whitespace characters and comments
+     */
+    void skip_whitespace();
+
+    /** Scan a sequence of characters allowed in simple symbols
+     */
+    void skip_symbol_chars();
+
+    /** Create token from characters in range [@p begin, `next`)
+     *
+     * @param begin first character of the token
+     * @param type type of the token
+     * @return @p type
+     */
+    inline Token make_token(char const* begin, Token type)
+    {
+        token = std::string_view{begin, static_cast<std::size_t>(next - begin)};
+        return type;
+    }
+};
+
+} // namespace yaga::parser
+
+#endif // YAGA_MMAP_LEXER_H
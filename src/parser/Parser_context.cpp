@@ -1,5 +1,7 @@
 #include "Parser_context.h"
 
+#include <algorithm>
+
 #include "Solver_wrapper.h"
 #include "Term_manager.h"
 #include "Terms.h"
@@ -9,6 +11,13 @@
 
 namespace yaga::parser {
 
+Parser_context::Parser_context(terms::Term_manager& term_manager, Options const& options)
+    : term_manager(term_manager), solver(term_manager, options),
+      true_symbol(term_manager.symbols().intern("true")),
+      false_symbol(term_manager.symbols().intern("false"))
+{
+}
+
 void Parser_context::add_let_bindings(let_bindings_t&& bindings)
 {
     let_records.push_frame();
@@ -20,13 +29,13 @@ void Parser_context::add_let_bindings(let_bindings_t&& bindings)
 
 void Parser_context::pop_let_bindings() { let_records.pop_frame(); }
 
-term_t Parser_context::get_term_for_symbol(std::string const& symbol)
+term_t Parser_context::get_term_for_symbol(symbol_t symbol)
 {
-    if (symbol == "true")
+    if (symbol == true_symbol)
     {
         return terms::true_term;
     }
-    if (symbol == "false")
+    if (symbol == false_symbol)
     {
         return terms::false_term;
     }
@@ -37,16 +46,16 @@ term_t Parser_context::get_term_for_symbol(std::string const& symbol)
     }
     if (defined_functions.has(symbol))
     {
-        auto defined = defined_functions.get(symbol);
+        auto const& defined = defined_functions.get(symbol);
         assert(defined.signature.args.empty());
         return defined.body;
     }
-    auto t = term_manager.get_term_by_name(symbol);
+    auto t = term_manager.get_term_by_symbol(symbol);
     assert(t.has_value());
     return t.value();
 }
 
-type_t Parser_context::get_type_for_symbol(std::string const& symbol)
+type_t Parser_context::get_type_for_symbol(std::string_view symbol)
 {
     if (symbol == "Bool") {
         return terms::types::bool_type;
@@ -57,9 +66,104 @@ type_t Parser_context::get_type_for_symbol(std::string const& symbol)
     throw std::logic_error("Requested unknown type");
 }
 
-Solver_answer Parser_context::check_sat(std::vector<term_t> const& assertions)
+terms::Symbol_table& Parser_context::symbols()
+{
+    return term_manager.symbols();
+}
+
+void Parser_context::assert_term(term_t term)
+{
+    // only track the assertion if it has been named in this command
+    if (produce_unsat_cores && std::ranges::find(recently_named, term) != recently_named.end())
+    {
+        solver.assert_tracked(term);
+    }
+    else
+    {
+        solver.assert_term(term);
+    }
+    recently_named.clear();
+}
+
+void Parser_context::name_term(symbol_t name, term_t term)
+{
+    store_defined_fun(name, term, {}, term_manager.get_type(term));
+    named_terms.insert({term, name});
+    recently_named.push_back(term);
+}
+
+std::vector<std::string> Parser_context::unsat_core()
+{
+    std::vector<std::string> names;
+    auto core = solver.unsat_core();
+    for (term_t term : core.assertions)
+    {
+        assert(named_terms.contains(term));
+        names.emplace_back(term_manager.symbols().name(named_terms.at(term)));
+    }
+
+    // assumptions of `check-sat-assuming` are literals
+    for (term_t term : core.assumptions)
+    {
+        if (auto name = term_manager.get_term_name(term_manager.positive_term(term)))
+        {
+            names.push_back(term_manager.is_negated(term) ? "(not " + std::string{*name} + ")" 
+                                                          : std::string{*name});
+        }
+    }
+    return names;
+}
+
+Solver_answer Parser_context::check_sat(std::span<term_t const> assumptions)
+{
+    return solver.check(assumptions);
+}
+
+void Parser_context::push(int num_levels)
+{
+    for (int i = 0; i < num_levels; ++i)
+    {
+        level_limits.emplace_back(declared_terms.size(), defined_names.size());
+        solver.push();
+    }
+}
+
+void Parser_context::pop(int num_levels)
 {
-    return solver.check(assertions);
+    assert(num_levels <= this->num_levels());
+    for (int i = 0; i < num_levels; ++i)
+    {
+        auto [num_declared, num_defined] = level_limits.back();
+        level_limits.pop_back();
+        remove_symbols(num_declared, num_defined);
+        solver.pop();
+    }
+}
+
+void Parser_context::reset()
+{
+    level_limits.clear();
+    remove_symbols(0, 0);
+    solver.reset();
+}
+
+void Parser_context::remove_symbols(std::size_t num_declared, std::size_t num_defined)
+{
+    for (; declared_terms.size() > num_declared; declared_terms.pop_back())
+    {
+        term_manager.remove_term_name(declared_terms.back());
+    }
+
+    for (; defined_names.size() > num_defined; defined_names.pop_back())
+    {
+        auto name = defined_names.back();
+        if (auto it = named_terms.find(defined_functions.get(name).body); 
+            it != named_terms.end() && it->second == name)
+        {
+            named_terms.erase(it);
+        }
+        defined_functions.erase(name);
+    }
 }
 
 void Parser_context::model(Default_model_visitor& visitor)
@@ -67,30 +171,31 @@ void Parser_context::model(Default_model_visitor& visitor)
     solver.model(visitor);
 }
 
-term_t Parser_context::declare_uninterpreted_constant(terms::type_t sort, std::string const& name)
+term_t Parser_context::declare_uninterpreted_constant(terms::type_t sort, symbol_t name)
 {
     term_t term = term_manager.mk_uninterpreted_constant(sort);
     term_manager.set_term_name(term, name);
+    declared_terms.push_back(term);
     return term;
 }
 
-term_t Parser_context::mk_numeral(std::string const& numeric_string)
+term_t Parser_context::mk_numeral(std::string_view numeric_string)
 {
     return term_manager.mk_integer_constant(numeric_string);
 }
 
-term_t Parser_context::mk_decimal(std::string const& decimal_string)
+term_t Parser_context::mk_decimal(std::string_view decimal_string)
 {
     return term_manager.mk_rational_constant(decimal_string);
 }
 
-term_t Parser_context::resolve_term(std::string const& name, std::vector<term_t>&& args)
+term_t Parser_context::resolve_term(symbol_t name, std::vector<term_t>&& args)
 {
     if (defined_functions.has(name))
     {
         return resolve_defined_function(name, args);
     }
-    return term_manager.mk_term(name, args);
+    return term_manager.mk_term(term_manager.symbols().name(name), args);
 }
 
 std::vector<term_t> Parser_context::bind_vars(std::span<Sorted_var> sorted_vars)
@@ -105,10 +210,11 @@ std::vector<term_t> Parser_context::bind_vars(std::span<Sorted_var> sorted_vars)
     }
     return ret;
 }
-void Parser_context::store_defined_fun(std::string const& name, term_t definition,
+void Parser_context::store_defined_fun(symbol_t name, term_t definition,
                                        std::vector<term_t> && formal_args, type_t return_sort)
 {
     defined_functions.insert(name, Function_template(name, std::move(formal_args), return_sort, definition));
+    defined_names.push_back(name);
 }
 
 void Parser_context::push_binding_scope()
@@ -123,7 +229,7 @@ void Parser_context::pop_binding_scope()
 
 term_t resolve(Function_template const& function_template, std::span<term_t> args, terms::Term_manager& term_manager);
 
-term_t Parser_context::resolve_defined_function(std::string const& name, std::span<term_t> args)
+term_t Parser_context::resolve_defined_function(symbol_t name, std::span<term_t> args)
 {
     auto const& function_template = defined_functions.get(name);
     return resolve(function_template, args, term_manager);
@@ -1,16 +1,19 @@
 #ifndef YAGA_PARSER_CONTEXT_H
 #define YAGA_PARSER_CONTEXT_H
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "Options.h"
 #include "Solver_answer.h"
 #include "Solver_wrapper.h"
+#include "Symbol_table.h"
 
 namespace yaga::terms {
 class Term_manager;
@@ -20,43 +23,27 @@ namespace yaga::parser {
 
 using term_t = terms::term_t;
 using type_t = terms::type_t;
-using let_bindings_t = std::vector<std::pair<std::string, term_t>>;
+using symbol_t = terms::symbol_t;
+using let_bindings_t = std::vector<std::pair<symbol_t, term_t>>;
 
 struct Sorted_var
 {
-    std::string var_name;
+    symbol_t var_name;
     type_t type;
 };
 
-class Let_binder {
-    term_t current_value;
-    std::vector<term_t> shadowed_values;
-public:
-    Let_binder(term_t t) : current_value(t) {}
-    Let_binder(Let_binder const&) = delete;
-    Let_binder& operator=(Let_binder const&) = delete;
-    Let_binder(Let_binder&&) = default;
-    Let_binder& operator=(Let_binder&&) = default;
-    term_t get_value() const { return current_value; }
-    bool has_shadow_value() const { return !shadowed_values.empty(); }
-    void restore_shadowed_value() { current_value = shadowed_values.back(); shadowed_values.pop_back(); }
-    void add_value(term_t val) {
-        shadowed_values.push_back(current_value);
-        current_value = val;
-    }
-};
-
 class Let_records {
-    std::unordered_map<std::string, Let_binder> let_binders;
-    std::vector<std::string> known_binders;
+    // map symbol -> term bound to it (null_term if the symbol is not bound)
+    std::vector<term_t> bound_terms;
+    // bound symbols with terms which were bound to them before (to restore shadowed bindings)
+    std::vector<std::pair<symbol_t, term_t>> known_binders;
     std::vector<std::size_t> frame_limits;
 
-    bool has(std::string const & name) const { return let_binders.find(name) != let_binders.end(); }
 public:
-    std::optional<term_t> get(std::string const& let_symbol) const {
-        auto it = let_binders.find(let_symbol);
-        if (it != let_binders.end()) {
-            return it->second.get_value();
+    std::optional<term_t> get(symbol_t let_symbol) const {
+        if (static_cast<std::size_t>(let_symbol) < bound_terms.size() &&
+            bound_terms[let_symbol] != terms::null_term) {
+            return bound_terms[let_symbol];
         }
         return {};
     }
@@ -67,30 +54,25 @@ public:
         auto limit = frame_limits.back();
         frame_limits.pop_back();
         while (known_binders.size() > limit) {
-            std::string binder = std::move(known_binders.back());
+            auto [binder, shadowed_value] = known_binders.back();
             known_binders.pop_back();
-            assert(this->has(binder));
-            auto& values = let_binders.at(binder);
-            if (values.has_shadow_value()) {
-                values.restore_shadowed_value();
-            } else {
-                let_binders.erase(binder);
-            }
+            assert(bound_terms[binder] != terms::null_term);
+            bound_terms[binder] = shadowed_value;
         }
     }
 
-    void add_binding(std::string const& name, term_t term) {
-        if (not this->has(name)) {
-            let_binders.insert({name, Let_binder(term)});
-        } else {
-            let_binders.at(name).add_value(term);
+    void add_binding(symbol_t name, term_t term) {
+        if (static_cast<std::size_t>(name) >= bound_terms.size()) {
+            bound_terms.resize(std::max<std::size_t>(name + 1, 2 * bound_terms.size()),
+                               terms::null_term);
         }
-        known_binders.push_back(name);
+        known_binders.emplace_back(name, bound_terms[name]);
+        bound_terms[name] = term;
     }
 };
 
 struct Function_signature {
-    std::string name;
+    symbol_t name;
     std::vector<term_t> args;
     type_t return_type;
 };
@@ -99,54 +81,112 @@ struct Function_template {
     Function_signature signature;
     term_t body;
 
-    Function_template(std::string name, std::vector<term_t> args, type_t ret_type, term_t body)
-    : signature{std::move(name), std::move(args), ret_type}, body(body) {}
+    Function_template(symbol_t name, std::vector<term_t> args, type_t ret_type, term_t body)
+    : signature{name, std::move(args), ret_type}, body(body) {}
 };
 
 class Defined_functions {
-    std::unordered_map<std::string, Function_template> defined_functions;
+    // map symbol -> function defined with that name
+    std::vector<std::optional<Function_template>> defined_functions;
 
 public:
-    bool has(std::string const & name) const
+    bool has(symbol_t name) const
     {
-        return defined_functions.find(name) != defined_functions.end();
+        return static_cast<std::size_t>(name) < defined_functions.size() &&
+               defined_functions[name].has_value();
     }
 
-    void insert(std::string const & name, Function_template && templ)
+    void insert(symbol_t name, Function_template && templ)
     {
         assert(not has(name));
-        defined_functions.insert({name, std::move(templ)});
+        if (static_cast<std::size_t>(name) >= defined_functions.size())
+        {
+            defined_functions.resize(name + 1);
+        }
+        defined_functions[name].emplace(std::move(templ));
+    }
+
+    Function_template const& get(symbol_t name) const
+    {
+        assert(has(name));
+        return defined_functions[name].value();
     }
 
-    Function_template const& get(std::string const& name) const
+    void erase(symbol_t name)
     {
-        return defined_functions.at(name);
+        assert(has(name));
+        defined_functions[name].reset();
     }
 };
 
 class Parser_context {
 public:
-    Parser_context(terms::Term_manager& term_manager, Options const& options) 
-        : term_manager(term_manager), solver(term_manager, options) {}
+    Parser_context(terms::Term_manager& term_manager, Options const& options);
 
     void add_let_bindings(let_bindings_t&& bindings);
 
     void pop_let_bindings();
 
-    term_t resolve_term(std::string const& name, std::vector<term_t>&& args);
+    term_t resolve_term(symbol_t name, std::vector<term_t>&& args);
+
+    term_t get_term_for_symbol(symbol_t symbol);
+
+    type_t get_type_for_symbol(std::string_view symbol);
+
+    void assert_term(term_t term);
+
+    /** Get table of interned symbols shared with the term manager
+     *
+     * @return table of interned symbols
+     */
+    terms::Symbol_table& symbols();
+
+    Solver_answer check_sat(std::span<term_t const> assumptions = {});
+
+    /** Name a term using the `:named` attribute. The name can be used as a constant afterwards.
+     *
+     * @param name name of the term
+     * @param term named term
+     */
+    void name_term(symbol_t name, term_t term);
+
+    /** Get names of assertions and assumptions in an unsat core of the last `check_sat()`
+     *
+     * @return names of assertions and assumptions in an unsat core
+     */
+    std::vector<std::string> unsat_core();
+
+    /** Enable or disable tracking of named assertions for unsat cores.
+     *
+     * @param value true iff named assertions should be tracked
+     */
+    inline void set_produce_unsat_cores(bool value) { produce_unsat_cores = value; }
 
-    term_t get_term_for_symbol(std::string const& symbol);
+    /** Check whether named assertions are tracked for unsat cores
+     *
+     * @return true iff named assertions are tracked
+     */
+    inline bool is_produce_unsat_cores() const { return produce_unsat_cores; }
 
-    type_t get_type_for_symbol(std::string const& symbol);
+    /*
+     * Assertion levels
+     */
+    void push(int num_levels);
+    void pop(int num_levels);
+    void reset();
 
-    Solver_answer check_sat(std::vector<term_t> const& assertions);
+    /** Get number of assertion levels which can be popped
+     *
+     * @return number of pushed assertion levels
+     */
+    inline int num_levels() const { return static_cast<int>(level_limits.size()); }
 
     void model(Default_model_visitor& visitor);
 
-    term_t declare_uninterpreted_constant(terms::type_t sort, std::string const& name);
+    term_t declare_uninterpreted_constant(terms::type_t sort, symbol_t name);
 
-    term_t mk_numeral(std::string const& numeric_string);
-    term_t mk_decimal(std::string const& decimal_string);
+    term_t mk_numeral(std::string_view numeric_string);
+    term_t mk_decimal(std::string_view decimal_string);
 
     /*
      * Bindings
@@ -156,7 +196,7 @@ public:
 
     std::vector<term_t> bind_vars(std::span<Sorted_var> sorted_vars);
 
-    void store_defined_fun(std::string const& name, term_t definition, std::vector<term_t> && formal_args, type_t ret_sort);
+    void store_defined_fun(symbol_t name, term_t definition, std::vector<term_t> && formal_args, type_t ret_sort);
 
 
 private:
@@ -164,11 +204,37 @@ private:
 
     Defined_functions defined_functions;
 
+    // declared constants in order of declaration
+    std::vector<term_t> declared_terms;
+
+    // names of defined functions in order of definition
+    std::vector<symbol_t> defined_names;
+
+    // map named term -> its name
+    std::unordered_map<term_t, symbol_t> named_terms;
+
+    // terms named since the last `assert_term()`
+    std::vector<term_t> recently_named;
+
+    // true iff named assertions are tracked for unsat cores
+    bool produce_unsat_cores = false;
+
+    // number of declared constants and defined functions when an assertion level was pushed
+    std::vector<std::pair<std::size_t, std::size_t>> level_limits;
+
     terms::Term_manager& term_manager;
 
     Solver_wrapper solver;
 
-    term_t resolve_defined_function(std::string const& name, std::span<term_t> args);
+    // symbols of boolean constants
+    symbol_t true_symbol;
+    symbol_t false_symbol;
+
+    term_t resolve_defined_function(symbol_t name, std::span<term_t> args);
+
+    // remove declarations and definitions which are not in the first @p num_declared and
+    // @p num_defined symbols
+    void remove_symbols(std::size_t num_declared, std::size_t num_defined);
 };
 
 }
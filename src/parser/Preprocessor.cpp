@@ -0,0 +1,274 @@
+#include "Preprocessor.h"
+#include "Terms.h"
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+
+namespace yaga::parser
+{
+
+using term_t = terms::term_t;
+
+Preprocessor::Preprocessor(terms::Term_manager& term_manager, Options const& options)
+    : term_manager(term_manager), options(options), simplify_config(term_manager, substitutions),
+      rewriter(term_manager, simplify_config)
+{
+}
+
+term_t Preprocessor::rewrite(term_t term)
+{
+    return rewriter.rewrite(term);
+}
+
+term_t Preprocessor::simplify(term_t term)
+{
+    auto start = Clock::now();
+    deadline = start + std::chrono::milliseconds{options.simplify_time_limit};
+    // the first rewrite substitutes all eliminated variables so it is necessary
+    for (term_t next = rewrite(term); next != term && !is_over_budget(); next = rewrite(term))
+    {
+        term = next;
+    }
+    time_spent += Clock::now() - start;
+    return term;
+}
+
+std::vector<term_t> Preprocessor::preprocess(std::vector<term_t> assertions,
+                                             std::function<bool(term_t)> const& is_internalized,
+                                             bool is_first_level)
+{
+    auto start = Clock::now();
+    deadline = start + std::chrono::milliseconds{options.simplify_time_limit};
+
+    // top-level literals which define substitutions of boolean constants
+    std::vector<term_t> result;
+    std::vector<term_t> next;
+    bool is_changed = true;
+    while (is_changed)
+    {
+        is_changed = false;
+        next.clear();
+        for (term_t assertion : assertions)
+        {
+            term_t rewritten = rewrite(assertion);
+            is_changed |= rewritten != assertion;
+            split(rewritten, next);
+        }
+        std::swap(assertions, next);
+
+        if (is_over_budget())
+        {
+            // all substitutions have been applied, the rest is optional
+            break;
+        }
+
+        if (is_first_level)
+        {
+            bool is_eliminated = false;
+            std::erase_if(assertions, [&](term_t assertion) {
+                term_t var = term_manager.positive_term(assertion);
+                if (term_manager.get_kind(var) == terms::Kind::UNINTERPRETED_TERM &&
+                    !substitutions.contains(var))
+                {
+                    // keep the literal but replace its other occurrences by a constant
+                    substitutions.emplace(var, term_manager.is_negated(assertion)
+                                                   ? terms::false_term
+                                                   : terms::true_term);
+                    result.push_back(assertion);
+                    is_changed = true;
+                    return true;
+                }
+                if (derive_substitution(assertion, is_internalized))
+                {
+                    is_eliminated = true;
+                    return true;
+                }
+                return false;
+            });
+
+            if (is_eliminated)
+            {
+                close_substitutions();
+                is_changed = true;
+            }
+        }
+    }
+    result.insert(result.end(), assertions.begin(), assertions.end());
+
+    // process shorter assertions first so that they can subsume longer disjunctions
+    auto length = [&](term_t term) -> std::size_t {
+        bool is_clause = !term_manager.is_negated(term) &&
+                         term_manager.get_kind(term) == terms::Kind::OR_TERM;
+        return is_clause ? term_manager.get_args(term).size() : 1;
+    };
+    std::ranges::stable_sort(result, std::less<>{}, length);
+
+    std::erase_if(result, [&](term_t term) {
+        if (term == terms::true_term || is_subsumed(term))
+        {
+            ++num_removed_assertions;
+            return true;
+        }
+        add_asserted(term);
+        return false;
+    });
+
+    time_spent += Clock::now() - start;
+    return result;
+}
+
+void Preprocessor::split(term_t term, std::vector<term_t>& out) const
+{
+    std::vector<term_t> stack{term};
+    while (!stack.empty())
+    {
+        term_t current = stack.back();
+        stack.pop_back();
+        if (term_manager.is_negated(current) &&
+            term_manager.get_kind(current) == terms::Kind::OR_TERM)
+        {
+            // not(or(a, b)) is a conjunction of not(a) and not(b)
+            auto args = term_manager.get_args(current);
+            for (auto it = args.rbegin(); it != args.rend(); ++it)
+            {
+                stack.push_back(terms::opposite_term(*it));
+            }
+        }
+        else if (current != terms::true_term)
+        {
+            out.push_back(current);
+        }
+    }
+}
+
+bool Preprocessor::derive_substitution(term_t term,
+                                       std::function<bool(term_t)> const& is_internalized)
+{
+    auto kind = term_manager.get_kind(term);
+    if (term_manager.is_negated(term) ||
+        (kind != terms::Kind::ARITH_EQ_ATOM && kind != terms::Kind::ARITH_BINEQ_ATOM))
+    {
+        return false;
+    }
+
+    // term is `poly = 0`
+    auto args = term_manager.get_args(term);
+    auto poly = kind == terms::Kind::ARITH_EQ_ATOM
+                    ? term_manager.term_to_poly(args[0])
+                    : term_manager.term_to_poly(term_manager.mk_arithmetic_minus(args[0], args[1]));
+
+    std::optional<term_t> var;
+    for (auto const& mono : poly)
+    {
+        if (mono.var == term_t::Undef)
+        {
+            continue;
+        }
+
+        if (!term_manager.is_uninterpreted_constant(mono.var) ||
+            substitutions.contains(mono.var))
+        {
+            return false; // definition would contain an ITE or an eliminated variable
+        }
+
+        if (!var && !is_internalized(mono.var))
+        {
+            var = mono.var;
+        }
+    }
+
+    if (!var)
+    {
+        return false;
+    }
+
+    // c * x + p = 0 is equivalent to x = -p / c
+    Rational coeff = poly.remove_var(var.value());
+    poly.divide_by(-coeff);
+    substitutions.emplace(var.value(), term_manager.poly_to_term(poly));
+    eliminated_vars.push_back(var.value());
+    return true;
+}
+
+void Preprocessor::close_substitutions()
+{
+    for (auto it = eliminated_vars.rbegin(); it != eliminated_vars.rend(); ++it)
+    {
+        auto& definition = substitutions.at(*it);
+        definition = rewrite(definition);
+    }
+}
+
+bool Preprocessor::is_subsumed(term_t term) const
+{
+    if (asserted.contains(term))
+    {
+        return true;
+    }
+
+    if (term_manager.is_negated(term) || term_manager.get_kind(term) != terms::Kind::OR_TERM)
+    {
+        return false;
+    }
+
+    // arguments of disjunctions are sorted
+    auto args = term_manager.get_args(term);
+    for (term_t arg : args)
+    {
+        if (asserted.contains(arg))
+        {
+            return true;
+        }
+
+        if (auto it = clauses_by_first_arg.find(arg); it != clauses_by_first_arg.end())
+        {
+            for (term_t clause : it->second)
+            {
+                if (std::ranges::includes(args, term_manager.get_args(clause)))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void Preprocessor::add_asserted(term_t term)
+{
+    asserted.insert(term);
+    asserted_trail.push_back(term);
+    if (!term_manager.is_negated(term) && term_manager.get_kind(term) == terms::Kind::OR_TERM)
+    {
+        clauses_by_first_arg[term_manager.get_args(term)[0]].push_back(term);
+    }
+}
+
+void Preprocessor::push()
+{
+    asserted_limits.push_back(asserted_trail.size());
+}
+
+void Preprocessor::pop()
+{
+    assert(!asserted_limits.empty());
+    for (; asserted_trail.size() > asserted_limits.back(); asserted_trail.pop_back())
+    {
+        term_t term = asserted_trail.back();
+        asserted.erase(term);
+        if (!term_manager.is_negated(term) && term_manager.get_kind(term) == terms::Kind::OR_TERM)
+        {
+            auto it = clauses_by_first_arg.find(term_manager.get_args(term)[0]);
+            assert(it != clauses_by_first_arg.end() && it->second.back() == term);
+            it->second.pop_back();
+            if (it->second.empty())
+            {
+                clauses_by_first_arg.erase(it);
+            }
+        }
+    }
+    asserted_limits.pop_back();
+}
+
+}
@@ -0,0 +1,174 @@
+#ifndef YAGA_PREPROCESSOR_H
+#define YAGA_PREPROCESSOR_H
+
+#include <chrono>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Options.h"
+#include "Term_manager.h"
+#include "Term_rewriter.h"
+#include "Term_simplifier.h"
+#include "Term_types.h"
+
+namespace yaga::parser
+{
+
+/** Simplification of assertions before they are internalized.
+ *
+ * The pipeline consists of:
+ *  - local rewriting (`terms::SimplifyConfig`) which folds constants, normalizes arithmetic atoms
+ *    and flattens/lifts ITE terms,
+ *  - splitting of top-level conjunctions,
+ *  - substitution of top-level equalities `x = t` (arithmetic variables which have not been
+ *    internalized yet are eliminated) and top-level boolean literals,
+ *  - removal of duplicate assertions and disjunctions subsumed by other assertions.
+ *
+ * The rewriting runs to a fixed point or until the time limit from `Options` is exhausted.
+ * Substitutions are only derived from assertions in the first assertion level.
+ */
+class Preprocessor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Preprocessor(terms::Term_manager& term_manager, Options const& options);
+
+    /** Simplify a single term using substitutions derived so far.
+     *
+     * @param term boolean term
+     * @return equivalent term with all eliminated variables substituted
+     */
+    terms::term_t simplify(terms::term_t term);
+
+    /** Simplify a batch of (untracked) assertions of the current assertion level.
+     *
+     * @param assertions boolean terms asserted in the current assertion level
+     * @param is_internalized predicate which returns true iff a term has been internalized
+     * @param is_first_level true iff there are no pushed assertion levels
+     * @return simplified assertions which have to be internalized
+     */
+    std::vector<terms::term_t> preprocess(std::vector<terms::term_t> assertions,
+                                          std::function<bool(terms::term_t)> const& is_internalized,
+                                          bool is_first_level);
+
+    /** Push a new assertion level
+     */
+    void push();
+
+    /** Forget assertions of the last assertion level
+     */
+    void pop();
+
+    /** Get variables eliminated by substitution in the order in which they have been eliminated
+     *
+     * @return list of eliminated uninterpreted constants
+     */
+    inline std::span<terms::term_t const> eliminated() const { return eliminated_vars; }
+
+    /** Get term which replaced an eliminated variable
+     *
+     * @param var variable from `eliminated()`
+     * @return term equal to @p var which does not contain any eliminated variables
+     */
+    inline terms::term_t definition(terms::term_t var) const { return substitutions.at(var); }
+
+    /** Get total time spent in the preprocessor
+     *
+     * @return total time spent in `simplify()` and `preprocess()`
+     */
+    inline Clock::duration total_time() const { return time_spent; }
+
+    /** Get total number of assertions removed as duplicate or subsumed
+     *
+     * @return number of removed assertions
+     */
+    inline int num_removed() const { return num_removed_assertions; }
+
+    /** Get total number of eliminated variables
+     *
+     * @return number of variables replaced by an equal term
+     */
+    inline int num_eliminated() const { return static_cast<int>(eliminated_vars.size()); }
+
+private:
+    terms::Term_manager& term_manager;
+    Options const& options;
+    // uninterpreted constant -> term which replaces it
+    terms::subst_map_t substitutions;
+    // local simplifications (uses `substitutions`)
+    terms::SimplifyConfig simplify_config;
+    // rewriter reused by all calls of `rewrite()` so that its memory is allocated only once
+    terms::Rewriter<terms::SimplifyConfig> rewriter;
+    // eliminated arithmetic variables in the order of elimination
+    std::vector<terms::term_t> eliminated_vars;
+    // untracked assertions in all assertion levels
+    std::unordered_set<terms::term_t> asserted;
+    // stack of `asserted` terms (to remove them in `pop()`)
+    std::vector<terms::term_t> asserted_trail;
+    // size of `asserted_trail` when a level was pushed
+    std::vector<std::size_t> asserted_limits;
+    // first argument -> asserted disjunctions with that first argument
+    std::unordered_map<terms::term_t, std::vector<terms::term_t>> clauses_by_first_arg;
+    // end of the time budget of the current call
+    Clock::time_point deadline;
+    // statistics
+    Clock::duration time_spent{0};
+    int num_removed_assertions = 0;
+
+    /** Rewrite @p term once using substitutions and local simplifications
+     *
+     * @param term term to rewrite
+     * @return rewritten term
+     */
+    terms::term_t rewrite(terms::term_t term);
+
+    /** Append @p term to @p out. Top-level conjunctions are split to conjuncts.
+     *
+     * @param term boolean term
+     * @param out list of assertions
+     */
+    void split(terms::term_t term, std::vector<terms::term_t>& out) const;
+
+    /** Derive a substitution from a top-level assertion if possible
+     *
+     * The variable has to be an arithmetic variable which has not been internalized yet and
+     * its definition must not contain ITE terms or variables which have already been eliminated.
+     *
+     * @param term asserted term
+     * @param is_internalized predicate which returns true iff a term has been internalized
+     * @return true iff @p term defines an eliminated variable and it can be removed
+     */
+    bool derive_substitution(terms::term_t term,
+                             std::function<bool(terms::term_t)> const& is_internalized);
+
+    /** Substitute eliminated variables in definitions of other eliminated variables
+     *
+     * Definition of a variable only contains variables which have been eliminated later, so
+     * definitions are closed in the reverse order of elimination.
+     */
+    void close_substitutions();
+
+    /** Check whether @p term is implied by an untracked assertion in an active level
+     *
+     * @param term asserted term
+     * @return true iff @p term is asserted or a subset of @p term is asserted (if @p term is a
+     * disjunction)
+     */
+    bool is_subsumed(terms::term_t term) const;
+
+    /** Remember an untracked assertion of the current level
+     *
+     * @param term asserted term
+     */
+    void add_asserted(terms::term_t term);
+
+    inline bool is_over_budget() const { return Clock::now() >= deadline; }
+};
+
+}
+
+#endif // YAGA_PREPROCESSOR_H
@@ -1,9 +1,13 @@
 #include "Smt2_parser.h"
 
+#include <filesystem>
 #include <stdexcept>
 #include <fstream>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "Mmap_lexer.h"
 #include "Smt2_term_parser.h"
 #include "Term_manager.h"
 #include "Term_types.h"
@@ -75,32 +79,42 @@ public:
 };
 
 class Smt2_command_context {
-    std::istream& input;
     std::ostream& output;
-    smt2_lexer lexer;
+    Lexer& lexer;
 
     Smt2_term_parser term_parser;
     Parser_context parser_context;
     terms::Term_manager& term_manager;
-    std::vector<term_t> assertions;
     std::optional<Solver_answer> last_answer;
 
     bool parse_command();
 
     void parse_error(std::string const& msg);
 
+    /** Parse optional numeral of `(push <numeral>?)` or `(pop <numeral>?)` and the closing
+     * parenthesis of the command.
+     *
+     * @return parsed numeral or 1 if it is omitted
+     */
+    int parse_num_levels();
+
     void print_answer(Solver_answer answer);
 
+    /** Print an error message to the output stream
+     *
+     * @param msg error message
+     */
+    void print_error(std::string_view msg);
+
 public:
-    Smt2_command_context(std::istream& input, std::ostream& output, terms::Term_manager& term_manager, Options const& opts)
-        : input(input), output(output), term_parser(lexer, parser_context), parser_context(term_manager, opts), term_manager(term_manager)
+    Smt2_command_context(Lexer& lexer, std::ostream& output, terms::Term_manager& term_manager, Options const& opts)
+        : output(output), lexer(lexer), term_parser(lexer, parser_context), parser_context(term_manager, opts), term_manager(term_manager)
     {}
     void execute();
 };
 
 void Smt2_command_context::execute()
 {
-    lexer.yyrestart(input);
     while(parse_command()) { /* empty */ }
 }
 
@@ -119,7 +133,7 @@ bool Smt2_command_context::parse_command()
     case Token::ASSERT_TOK:
     {
         term_t term = term_parser.parse_term();
-        assertions.push_back(term);
+        parser_context.assert_term(term);
     }
     break;
 
@@ -127,7 +141,16 @@ bool Smt2_command_context::parse_command()
     // (check-sat)
     case Token::CHECK_SAT_TOK:
     {
-        last_answer = parser_context.check_sat(assertions);
+        last_answer = parser_context.check_sat();
+        print_answer(*last_answer);
+    }
+    break;
+
+    // (check-sat-assuming (<prop_literal>*))
+    case Token::CHECK_SAT_ASSUMING_TOK:
+    {
+        auto assumptions = term_parser.parse_term_list();
+        last_answer = parser_context.check_sat(assumptions);
         print_answer(*last_answer);
     }
     break;
@@ -137,7 +160,7 @@ bool Smt2_command_context::parse_command()
     case Token::DECLARE_CONST_TOK:
     case Token::DECLARE_FUN_TOK:
     {
-        std::string name = term_parser.parse_symbol();
+        auto name = term_parser.parse_symbol();
         std::vector<terms::type_t> sorts;
         if (tok == Token::DECLARE_FUN_TOK)
         {
@@ -246,7 +269,25 @@ bool Smt2_command_context::parse_command()
     // (get-unsat-core)
     case Token::GET_UNSAT_CORE_TOK:
     {
-        UNIMPLEMENTED;
+        if (!parser_context.is_produce_unsat_cores())
+        {
+            print_error("unsat core generation is not enabled (use :produce-unsat-cores)");
+        }
+        else if (last_answer != Solver_answer::UNSAT)
+        {
+            print_error("(get-unsat-core) is only available if the last check returns unsat");
+        }
+        else
+        {
+            output << "(";
+            bool is_first = true;
+            for (auto const& name : parser_context.unsat_core())
+            {
+                output << (is_first ? "" : " ") << name;
+                is_first = false;
+            }
+            output << ")\n";
+        }
     }
     break;
     // (get-value (<term>*))
@@ -259,19 +300,29 @@ bool Smt2_command_context::parse_command()
     // (pop <numeral>?)
     case Token::POP_TOK:
     {
-        UNIMPLEMENTED;
+        int num_levels = parse_num_levels();
+        if (num_levels > parser_context.num_levels())
+        {
+            print_error("cannot pop more assertion levels than were pushed");
+        }
+        else
+        {
+            parser_context.pop(num_levels);
+            last_answer.reset();
+        }
+        return true; // the closing parenthesis has been consumed by parse_num_levels()
     }
-    break;
     // (push <numeral>?)
     case Token::PUSH_TOK:
     {
-        UNIMPLEMENTED;
+        parser_context.push(parse_num_levels());
+        return true; // the closing parenthesis has been consumed by parse_num_levels()
     }
-    break;
     // (reset)
     case Token::RESET_TOK:
     {
-        UNIMPLEMENTED;
+        parser_context.reset();
+        last_answer.reset();
     }
     break;
     // (set-info <attribute>)
@@ -287,7 +338,7 @@ bool Smt2_command_context::parse_command()
     // (set-logic <symbol>)
     case Token::SET_LOGIC_TOK:
     {
-        std::string name = term_parser.parse_symbol();
+        auto name = parser_context.symbols().name(term_parser.parse_symbol());
         if (name != "QF_LRA")
         {
             std::cerr << "Unsupported logic " << name << std::endl;
@@ -300,9 +351,11 @@ bool Smt2_command_context::parse_command()
     {
         std::string keyword = term_parser.parse_keyword();
         std::string value = term_parser.parse_sexpr();
-        // TODO: Do something with the values
-        (void)keyword;
-        (void)value;
+        if (keyword == "produce-unsat-cores")
+        {
+            parser_context.set_produce_unsat_cores(value == "true");
+        }
+        // TODO: Do something with other values
         break;
     }
     break;
@@ -317,10 +370,31 @@ bool Smt2_command_context::parse_command()
     lexer.eat_token(Token::RPAREN_TOK);
     return true;
 }
+int Smt2_command_context::parse_num_levels()
+{
+    Token tok = lexer.next_token();
+    if (tok == Token::RPAREN_TOK)
+    {
+        return 1;
+    }
+    else if (tok != Token::INTEGER_LITERAL)
+    {
+        lexer.unexpected_token_error(tok);
+    }
+    int num_levels = std::stoi(std::string{lexer.token_string()});
+    lexer.eat_token(Token::RPAREN_TOK);
+    return num_levels;
+}
+
 void Smt2_command_context::parse_error(std::string const&)
 {
     UNIMPLEMENTED;
 }
+void Smt2_command_context::print_error(std::string_view msg)
+{
+    output << "(error \"" << msg << "\")\n";
+}
+
 void Smt2_command_context::print_answer(Solver_answer answer)
 {
     switch (answer)
@@ -343,6 +417,14 @@ void Smt2_command_context::print_answer(Solver_answer answer)
 
 void Smt2_parser::parse_file(std::string const& file_name)
 {
+    // pipes and other special files cannot be mapped to memory
+    if (options.mmap_input && std::filesystem::is_regular_file(file_name))
+    {
+        Mmap_lexer lexer{file_name};
+        parse(lexer, std::cout);
+        return;
+    }
+
     std::ifstream file_stream;
     file_stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
     file_stream.open(file_name);
@@ -351,9 +433,22 @@ void Smt2_parser::parse_file(std::string const& file_name)
 }
 
 void Smt2_parser::parse(std::istream& input, std::ostream& output)
+{
+    smt2_lexer lexer;
+    lexer.yyrestart(input);
+    parse(lexer, output);
+}
+
+void Smt2_parser::parse(std::string_view input, std::ostream& output)
+{
+    Mmap_lexer lexer{input};
+    parse(lexer, output);
+}
+
+void Smt2_parser::parse(Lexer& lexer, std::ostream& output)
 {
     terms::Term_manager tm;
-    Smt2_command_context ctx(input, output, tm, options);
+    Smt2_command_context ctx(lexer, output, tm, options);
     ctx.execute();
 }
 
@@ -2,9 +2,11 @@
 #define YAGA_SMT2_PARSER_H
 
 #include <string>
+#include <string_view>
 #include <istream>
 #include <ostream>
 
+#include "Lexer.h"
 #include "Options.h"
 
 namespace yaga::parser {
@@ -13,14 +15,33 @@ class Smt2_parser {
 public:
     void parse_file(std::string const& file_name);
 
+    /** Parse and execute commands read from a stream using the flex lexer
+     *
+     * @param input input stream
+     * @param output output stream for responses to the commands
+     */
     void parse(std::istream& input, std::ostream& output);
 
+    /** Parse and execute commands from a string in memory (tokens are not copied)
+     *
+     * @param input SMT-LIBv2 script
+     * @param output output stream for responses to the commands
+     */
+    void parse(std::string_view input, std::ostream& output);
+
     /** Set new options
      * 
      * @param opts new solver options
      */
     inline void set_options(Options const& opts) { options = opts; }
 private:
+    /** Parse and execute commands using @p lexer
+     *
+     * @param lexer source of tokens
+     * @param output output stream for responses to the commands
+     */
+    void parse(Lexer& lexer, std::ostream& output);
+
     // parsed command line options for the solver
     Options options;
 };
@@ -1,7 +1,6 @@
 #include "Smt2_term_parser.h"
 
 #include <cassert>
-#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -51,9 +50,10 @@ enum class ParseCtx
 term_t Smt2_term_parser::parse_term() {
     using arg_list_t = std::vector<term_t>;
     std::vector<std::tuple<ParseCtx, OpInfo, arg_list_t>> ctx_stack;
-    std::vector<std::vector<std::pair<std::string, term_t>>> letBinders;
+    std::vector<let_bindings_t> letBinders;
     bool needs_context_update = false;
-    std::optional<term_t> ret{};
+    // the last parsed term (Undef if there is none)
+    term_t ret = term_t::Undef;
     do {
         Token token = lexer.next_token();
         switch (token) {
@@ -86,8 +86,12 @@ term_t Smt2_term_parser::parse_term() {
             }
             break;
             case Token::MATCH_TOK:
-            case Token::ATTRIBUTE_TOK:
                 UNIMPLEMENTED;
+            case Token::ATTRIBUTE_TOK:
+            {
+                ctx_stack.push_back({ParseCtx::TERM_ANNOTATE_BODY, OpInfo{}, {}});
+            }
+            break;
             case Token::SYMBOL:
             case Token::QUOTED_SYMBOL:
             {
@@ -119,8 +123,7 @@ term_t Smt2_term_parser::parse_term() {
         case Token::SYMBOL:
         case Token::QUOTED_SYMBOL:
         {
-            std::string name = token_to_symbol(token);
-            ret = get_term_for_symbol(name);
+            ret = get_term_for_symbol(token_to_symbol(token));
         }
         break;
         case Token::INTEGER_LITERAL:
@@ -155,7 +158,7 @@ term_t Smt2_term_parser::parse_term() {
             break;
         }
 
-        while (!ctx_stack.empty() && (ret.has_value() || needs_context_update))
+        while (!ctx_stack.empty() && (ret != term_t::Undef || needs_context_update))
         {
             needs_context_update = false;
             auto ctx = get<ParseCtx>(ctx_stack.back());
@@ -163,20 +166,20 @@ term_t Smt2_term_parser::parse_term() {
             {
             case ParseCtx::NEXT_ARG: {
                 // we are parsing the argument list, store the current term and continue
-                assert(ret.has_value());
-                get<arg_list_t>(ctx_stack.back()).push_back(ret.value());
-                ret.reset();
+                assert(ret != term_t::Undef);
+                get<arg_list_t>(ctx_stack.back()).push_back(ret);
+                ret = term_t::Undef;
             }
             break;
             case ParseCtx::LET_NEXT_BIND: {
                 // if we parsed a term, process it as a binding
-                if (ret.has_value())
+                if (ret != term_t::Undef)
                 {
                     assert(!letBinders.empty());
                     auto& let_binder = letBinders.back();
                     // add binding from the symbol to ret
-                    let_binder.emplace_back(get<OpInfo>(ctx_stack.back()).name, ret.value());
-                    ret.reset();
+                    let_binder.emplace_back(get<OpInfo>(ctx_stack.back()).name, ret);
+                    ret = term_t::Undef;
                     // close the current binding
                     lexer.eat_token(Token::RPAREN_TOK);
                 }
@@ -208,29 +211,50 @@ term_t Smt2_term_parser::parse_term() {
                 parser_context.pop_let_bindings();
             }
             break;
+            case ParseCtx::TERM_ANNOTATE_BODY: {
+                // the annotated term is the returned term, parse attributes until RPAREN
+                assert(ret != term_t::Undef);
+                for (Token attr = lexer.next_token(); attr != Token::RPAREN_TOK; 
+                     attr = lexer.next_token())
+                {
+                    if (attr != Token::KEYWORD)
+                    {
+                        lexer.unexpected_token_error(attr);
+                    }
+                    if (lexer.token_string() == ":named")
+                    {
+                        parser_context.name_term(parse_symbol(), ret);
+                    }
+                    else // ignore value of other attributes
+                    {
+                        parse_sexpr();
+                    }
+                }
+                ctx_stack.pop_back();
+            }
+            break;
             default:
                 UNIMPLEMENTED;
             }
         }
     } while (!ctx_stack.empty());
-    assert(ret.has_value());
-    return ret.value();
+    assert(ret != term_t::Undef);
+    return ret;
 }
 
-std::string Smt2_term_parser::token_to_symbol(Token token)
+terms::symbol_t Smt2_term_parser::token_to_symbol(Token token)
 {
+    auto& symbols = parser_context.symbols();
     switch (token)
     {
     case Token::SYMBOL:
-        return lexer.token_string();
+        return symbols.intern(lexer.token_string());
     case Token::QUOTED_SYMBOL:
     {
-        std::string symbol = lexer.token_string();
-        assert(symbol[0] == '|' && symbol.back() == '|');
+        auto symbol = lexer.token_string();
+        assert(symbol.size() >= 2 && symbol.front() == '|' && symbol.back() == '|');
         // strip off the quotes
-        symbol = symbol.erase(0, 1);
-        symbol = symbol.erase(symbol.size() - 1, 1);
-        return symbol;
+        return symbols.intern(symbol.substr(1, symbol.size() - 2));
     }
     default:
         lexer.unexpected_token_error(token);
@@ -239,11 +263,10 @@ std::string Smt2_term_parser::token_to_symbol(Token token)
     throw std::logic_error("UNREACHABLE!");
 }
 
-std::string Smt2_term_parser::parse_symbol()
+terms::symbol_t Smt2_term_parser::parse_symbol()
 {
     Token tok = lexer.next_token();
-    std::string id = token_to_symbol(tok);
-    return id;
+    return token_to_symbol(tok);
 }
 
 term_t Smt2_term_parser::make_term(OpInfo const& op_info, std::vector<term_t>&& args)
@@ -251,7 +274,7 @@ term_t Smt2_term_parser::make_term(OpInfo const& op_info, std::vector<term_t>&&
     return parser_context.resolve_term(op_info.name, std::move(args));
 }
 
-term_t Smt2_term_parser::get_term_for_symbol(std::string const& symbol)
+term_t Smt2_term_parser::get_term_for_symbol(terms::symbol_t symbol)
 {
     return parser_context.get_term_for_symbol(symbol);
 }
@@ -261,16 +284,15 @@ type_t Smt2_term_parser::parse_sort()
     if (tok != Token::SYMBOL) {
         lexer.unexpected_token_error(tok);
     }
-    auto sort_name = token_to_symbol(tok);
-    return parser_context.get_type_for_symbol(sort_name);
+    return parser_context.get_type_for_symbol(lexer.token_string());
 }
 
 std::string Smt2_term_parser::parse_keyword()
 {
     lexer.eat_token(Token::KEYWORD);
-    std::string value = lexer.token_string();
+    auto value = lexer.token_string();
     assert(!value.empty() && value[0] == ':');
-    return value.erase(0,1);
+    return std::string{value.substr(1)};
 }
 
 std::string Smt2_term_parser::parse_sexpr()
@@ -278,7 +300,7 @@ std::string Smt2_term_parser::parse_sexpr()
     // TODO: Check the token?
     Token tok = lexer.next_token();
     (void)tok;
-    return lexer.token_string();
+    return std::string{lexer.token_string()};
 }
 
 std::vector<Sorted_var> Smt2_term_parser::parse_sorted_var_list()
@@ -296,4 +318,17 @@ std::vector<Sorted_var> Smt2_term_parser::parse_sorted_var_list()
     return vars;
 }
 
+std::vector<term_t> Smt2_term_parser::parse_term_list()
+{
+    std::vector<term_t> terms;
+    lexer.eat_token(Token::LPAREN_TOK);
+    // parse terms until RPAREN
+    for (Token token = lexer.next_token(); token != Token::RPAREN_TOK; token = lexer.next_token())
+    {
+        lexer.push_back_token(token);
+        terms.push_back(parse_term());
+    }
+    return terms;
+}
+
 } // namespace yaga::parser
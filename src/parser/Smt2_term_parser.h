@@ -1,10 +1,11 @@
 #ifndef YAGA_SMT2_TERM_PARSER_H
 #define YAGA_SMT2_TERM_PARSER_H
 
+#include <string>
 #include <vector>
 
 #include "Parser_context.h"
-#include "smt2_lexer.h"
+#include "Lexer.h"
 #include "Term_types.h"
 
 namespace yaga::parser
@@ -15,26 +16,26 @@ using type_t = terms::type_t;
 
 struct OpInfo
 {
-    std::string name;
+    terms::symbol_t name{};
 };
 
 class Smt2_term_parser {
-    smt2_lexer & lexer;
+    Lexer & lexer;
     Parser_context & parser_context;
 
-    std::string token_to_symbol(Token token);
+    terms::symbol_t token_to_symbol(Token token);
 
     term_t make_term(OpInfo const&, std::vector<term_t>&&);
 
-    term_t get_term_for_symbol(std::string const&);
+    term_t get_term_for_symbol(terms::symbol_t);
 
 public:
-    explicit Smt2_term_parser(smt2_lexer & lexer, Parser_context & ctx)
+    explicit Smt2_term_parser(Lexer & lexer, Parser_context & ctx)
         : lexer(lexer), parser_context(ctx) {}
 
     term_t parse_term();
 
-    std::string parse_symbol();
+    terms::symbol_t parse_symbol();
 
     type_t parse_sort();
 
@@ -42,6 +43,8 @@ public:
     std::string parse_sexpr();
 
     std::vector<Sorted_var> parse_sorted_var_list();
+
+    std::vector<term_t> parse_term_list();
 };
 
 } // namespace yaga::parser
@@ -1,4 +1,11 @@
 #include "Solver_wrapper.h"
+#include "Statistics.h"
+#include "Terms.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <unordered_set>
 
 namespace yaga::parser
 {
@@ -21,19 +28,109 @@ class Internalizer_config : public terms::Default_visitor_config
 {
     terms::Term_manager const& term_manager;
     Yaga& solver;
-    std::unordered_map<terms::term_t, int> internal_rational_vars;
+    // map term index -> ordinal number of the rational variable which represents the term
+    std::vector<std::optional<int>> internal_rational_vars;
 
     // HACK: We need to store literals
     // x >= 0 (positive in term representation) is internalized as ~(x < 0), which is negative
-    std::unordered_map<terms::term_t, Literal> internal_bool_vars; // Only positive terms should be added to this map!
+    // map term index -> literal which represents the positive term
+    std::vector<std::optional<Literal>> internal_bool_vars;
+
+    // uninterpreted constants in the order in which they have been internalized
+    std::vector<std::pair<terms::term_t, Variable>> uninterpreted_vars;
+
+    // map term index -> bit mask of polarities in which the OR term has been encoded
+    // (`positive_polarity` and/or `negative_polarity`)
+    std::vector<std::uint8_t> encoded_polarities;
+    // map term index -> number of internalized terms which refer to the OR term
+    std::vector<int> num_parents;
+
+    static constexpr std::uint8_t positive_polarity = 1;
+    static constexpr std::uint8_t negative_polarity = 2;
 
     Linear_polynomial internalize_poly(terms::term_t t);
     inline int internal_rational_var(terms::term_t t) const
     {
-        assert(internal_rational_vars.find(t) != internal_rational_vars.end());
-        return internal_rational_vars.at(t);
+        auto index = static_cast<std::size_t>(term_manager.index_of(t));
+        assert(index < internal_rational_vars.size() && internal_rational_vars[index].has_value());
+        return internal_rational_vars[index].value();
+    }
+
+    inline Literal internal_bool_var(terms::term_t t) const
+    {
+        auto possibly_literal = get_literal_for(t);
+        assert(possibly_literal.has_value());
+        return possibly_literal.value();
+    }
+
+    /** Remember that @p t is represented by a rational variable @p var_ord
+     *
+     * @param t internalized arithmetic term
+     * @param var_ord ordinal number of a rational variable
+     */
+    inline void set_rational_var(terms::term_t t, int var_ord)
+    {
+        auto index = static_cast<std::size_t>(term_manager.index_of(t));
+        if (index >= internal_rational_vars.size())
+        {
+            internal_rational_vars.resize(index + 1);
+        }
+        assert(!internal_rational_vars[index].has_value());
+        internal_rational_vars[index] = var_ord;
+    }
+
+    /** Remember that the positive term of @p t is represented by @p lit
+     *
+     * @param t internalized boolean term
+     * @param lit literal which represents the positive term of @p t
+     */
+    inline void set_bool_var(terms::term_t t, Literal lit)
+    {
+        auto index = static_cast<std::size_t>(term_manager.index_of(t));
+        if (index >= internal_bool_vars.size())
+        {
+            internal_bool_vars.resize(index + 1);
+        }
+        assert(!internal_bool_vars[index].has_value());
+        internal_bool_vars[index] = lit;
+    }
+
+    /** Get literal which represents @p t including its polarity
+     *
+     * @param t internalized boolean term
+     * @return literal which represents @p t
+     */
+    inline Literal literal_of(terms::term_t t) const
+    {
+        Literal lit = internal_bool_var(t);
+        return term_manager.is_negated(t) ? ~lit : lit;
+    }
+
+    /** Get polarity bit of @p t in `encoded_polarities`
+     *
+     * @param t boolean term
+     * @return `negative_polarity` if @p t is negated, `positive_polarity` otherwise
+     */
+    inline std::uint8_t polarity_of(terms::term_t t) const
+    {
+        return term_manager.is_negated(t) ? negative_polarity : positive_polarity;
     }
 
+    /** Increment number of parents of @p t if it is an OR term
+     *
+     * @param t boolean term
+     */
+    void add_parent(terms::term_t t);
+
+    /** Check whether definition of @p child can be inlined in definition of @p parent
+     *
+     * @param parent OR term which is being encoded
+     * @param child argument of @p parent with polarity in which it occurs in @p parent
+     * @return true iff @p child is an OR term with the same polarity as @p parent which is not
+     * shared with any other term and which has not been encoded in this polarity yet
+     */
+    bool is_inlined(terms::term_t parent, terms::term_t child) const;
+
     inline Variable new_bool_var()
     {
         return solver.make(Variable::boolean);
@@ -56,81 +153,324 @@ public:
 
     std::optional<Literal> get_literal_for(terms::term_t t) const;
 
-    /** Get a range of boolean variables (pairs of `term_t` and `Literal`)
-     * 
-     * @return range of internalized boolean variables
+    /** Get rational variable which represents an arithmetic term
+     *
+     * @param t arithmetic term
+     * @return ordinal number of the rational variable or none if @p t has not been internalized
      */
-    inline std::ranges::view auto bool_vars() const 
-    { 
-        return std::ranges::views::all(internal_bool_vars); 
+    inline std::optional<int> get_rational_var_for(terms::term_t t) const
+    {
+        auto index = static_cast<std::size_t>(term_manager.index_of(t));
+        return index < internal_rational_vars.size() ? internal_rational_vars[index] : std::nullopt;
+    }
+
+    /** Check whether @p t has been internalized
+     *
+     * @param t boolean or arithmetic term
+     * @return true iff @p t is represented by a literal or a rational variable
+     */
+    inline bool is_internalized(terms::term_t t) const
+    {
+        return get_literal_for(t).has_value() || get_rational_var_for(t).has_value();
     }
 
-    /** Get a range of rational variables (pairs of `term_t` and variable ordinal integer)
+    /** Assert clauses which guarantee that @p t holds if its literal is true.
+     *
+     * Only implications required by the polarity of @p t (and, recursively, by polarities of its
+     * subterms) are asserted (Plaisted-Greenbaum encoding). Nested OR terms of the same polarity
+     * which are not shared with other terms are inlined. Each OR term is encoded at most once in
+     * each polarity, so the encoding is extended lazily if a term is used in a new polarity.
+     *
+     * @param t internalized boolean term (possibly negated)
+     */
+    void encode(terms::term_t t);
+
+    /** Get uninterpreted constants (pairs of `term_t` and `Variable`) internalized so far
      * 
-     * @return range of internalized rational variables
+     * @return range of internalized uninterpreted constants
      */
-    inline std::ranges::view auto rational_vars() const 
+    inline std::ranges::view auto user_vars() const 
     { 
-        return std::ranges::views::all(internal_rational_vars); 
+        return std::ranges::views::all(uninterpreted_vars); 
     }
 };
 
 Solver_wrapper::Solver_wrapper(terms::Term_manager& term_manager, Options const& opts)
-    : term_manager(term_manager), options(opts), solver(logic::qf_lra, options) {}
+    : term_manager(term_manager), options(opts), solver(logic::qf_lra, options),
+      internalizer_config(std::make_unique<Internalizer_config>(term_manager, solver)),
+      internalizer(std::make_unique<terms::Visitor<Internalizer_config>>(term_manager,
+                                                                         *internalizer_config)),
+      preprocessor(std::make_unique<Preprocessor>(term_manager, options))
+{
+    if (options.pipeline)
+    {
+        worker = std::thread{[this] { run_worker(); }};
+    }
+}
 
-Solver_answer Solver_wrapper::check(std::vector<term_t> const& assertions)
+Solver_wrapper::~Solver_wrapper()
 {
-    if (std::ranges::any_of(assertions, [](term_t t) { return t == terms::false_term; }))
+    if (worker.joinable())
     {
-        return Solver_answer::UNSAT;
+        {
+            std::lock_guard lock{queue_mutex};
+            is_stopped = true;
+        }
+        queue_changed.notify_all();
+        worker.join();
     }
+}
 
-    // Cnfize and assert clauses to the solver
+void Solver_wrapper::reset()
+{
+    drain();
     solver.init(logic::qf_lra, options);
-    Internalizer_config internalizer_config{term_manager, solver};
-    terms::Visitor<Internalizer_config> internalizer(term_manager, internalizer_config);
-    internalizer.visit(assertions);
+    activation_literals.clear();
+    tracked_assertions.clear();
+    tracked_limits.clear();
+    last_assumptions.clear();
+    pending_assertions.clear();
+    pending_tracked.clear();
+    internalizer_config = std::make_unique<Internalizer_config>(term_manager, solver);
+    internalizer = std::make_unique<terms::Visitor<Internalizer_config>>(term_manager,
+                                                                         *internalizer_config);
+    preprocessor = std::make_unique<Preprocessor>(term_manager, options);
+}
 
-    // add top level assertions to the solver
-    for (term_t assertion : assertions)
+Literal Solver_wrapper::internalize(term_t term)
+{
+    // Cnfize new subterms and assert their definitions to the solver
+    internalizer->visit(std::span<term_t const>{&term, 1});
+    internalizer_config->encode(term);
+
+    auto possibly_literal = internalizer_config->get_literal_for(term_manager.positive_term(term));
+    assert(possibly_literal.has_value());
+    Literal literal = possibly_literal.value();
+    if (term_manager.is_negated(term))
+    {
+        literal.negate();
+    }
+    return literal;
+}
+
+void Solver_wrapper::assert_literal(Literal literal)
+{
+    if (activation_literals.empty())
     {
-        if (assertion == terms::true_term) { continue; }
-        auto possibly_literal = internalizer_config.get_literal_for(term_manager.positive_term(assertion));
-        assert(possibly_literal.has_value());
-        Literal literal = possibly_literal.value();
-        if (term_manager.is_negated(assertion))
-        {
-            literal.negate();
-        }
         solver.assert_clause(literal);
     }
+    else // the assertion only holds if the current level is active
+    {
+        solver.assert_clause(~activation_literals.back(), literal);
+    }
+}
+
+void Solver_wrapper::assert_tracked_literal(Literal literal, term_t term)
+{
+    Literal tracking = solver.make_bool();
+    solver.assert_clause(~tracking, literal);
+    tracked_assertions.emplace_back(tracking, term);
+}
+
+void Solver_wrapper::assert_term(term_t term)
+{
+    if (options.pipeline)
+    {
+        enqueue(term, /* is_tracked = */ false);
+    }
+    else if (options.simplify)
+    {
+        pending_assertions.push_back(term);
+    }
+    else
+    {
+        assert_literal(internalize(term));
+    }
+}
 
-    // remember term-variable mapping
-    variables.clear();
-    for (auto& [term, lit] : internalizer_config.bool_vars())
+void Solver_wrapper::assert_tracked(term_t term)
+{
+    if (options.pipeline)
     {
-        if (term_manager.get_kind(term) == terms::Kind::UNINTERPRETED_TERM)
-        {
-            variables.insert({term, lit.var()});
-        }
+        enqueue(term, /* is_tracked = */ true);
     }
-    for (auto& [term, var_ord] : internalizer_config.rational_vars())
+    else if (options.simplify)
     {
-        if (term_manager.get_kind(term) == terms::Kind::UNINTERPRETED_TERM)
+        pending_tracked.push_back(term);
+    }
+    else
+    {
+        assert_tracked_literal(internalize(term), term);
+    }
+}
+
+void Solver_wrapper::flush()
+{
+    auto assertions = preprocessor->preprocess(
+        std::move(pending_assertions),
+        [&](term_t t) { return internalizer_config->is_internalized(t); },
+        activation_literals.empty());
+    pending_assertions.clear();
+    for (term_t assertion : assertions)
+    {
+        assert_literal(internalize(assertion));
+    }
+
+    // tracked assertions are simplified but never removed so that they can occur in unsat cores
+    for (term_t term : pending_tracked)
+    {
+        assert_tracked_literal(internalize(preprocessor->simplify(term)), term);
+    }
+    pending_tracked.clear();
+}
+
+void Solver_wrapper::enqueue(term_t term, bool is_tracked)
+{
+    std::unique_lock lock{queue_mutex};
+    queued_assertions.emplace_back(term, is_tracked);
+    // wake the thread up only once per batch so that the parser is not slowed down by it
+    if (queued_assertions.size() == min_batch_size)
+    {
+        lock.unlock();
+        queue_changed.notify_all();
+    }
+}
+
+void Solver_wrapper::drain()
+{
+    if (worker.joinable())
+    {
+        std::unique_lock lock{queue_mutex};
+        is_draining = true;
+        queue_changed.notify_all();
+        queue_changed.wait(lock, [&] { return queued_assertions.empty() && !is_worker_busy; });
+        is_draining = false;
+    }
+}
+
+void Solver_wrapper::run_worker()
+{
+    std::vector<std::pair<term_t, bool>> batch;
+    std::unique_lock lock{queue_mutex};
+    for (;;)
+    {
+        queue_changed.wait(lock, [&] {
+            return queued_assertions.size() >= min_batch_size ||
+                   (is_draining && !queued_assertions.empty()) || is_stopped;
+        });
+        if (is_stopped)
         {
-            variables.insert({term, Variable{var_ord, Variable::rational}});
+            return;
         }
+
+        // take all queued assertions so that the parser is not blocked while they are processed
+        std::swap(batch, queued_assertions);
+        is_worker_busy = true;
+        lock.unlock();
+        // terms in the batch have been created before they were queued and they never move
+        for (auto [term, is_tracked] : batch)
+        {
+            if (is_tracked)
+            {
+                assert_tracked_literal(internalize(term), term);
+            }
+            else
+            {
+                assert_literal(internalize(term));
+            }
+        }
+        batch.clear();
+        lock.lock();
+        is_worker_busy = false;
+        queue_changed.notify_all();
+    }
+}
+
+void Solver_wrapper::push()
+{
+    drain();
+    flush();
+    activation_literals.push_back(solver.make_bool());
+    tracked_limits.push_back(tracked_assertions.size());
+    preprocessor->push();
+}
+
+void Solver_wrapper::pop()
+{
+    assert(!activation_literals.empty());
+    drain();
+    // assertions which have not been internalized yet belong to the popped level
+    pending_assertions.clear();
+    pending_tracked.clear();
+    preprocessor->pop();
+    // the popped level won't be activated again so all clauses derived from it are satisfied
+    std::vector<Literal> retired{~activation_literals.back()};
+    activation_literals.pop_back();
+    for (; tracked_assertions.size() > tracked_limits.back(); tracked_assertions.pop_back())
+    {
+        retired.push_back(~tracked_assertions.back().first);
     }
+    tracked_limits.pop_back();
+    solver.solver().remove_clauses(retired);
+}
 
-    auto res = solver.solver().check();
+Solver_answer Solver_wrapper::check(std::span<term_t const> assumptions)
+{
+    drain();
+    flush();
+    last_assumptions.assign(tracked_assertions.begin(), tracked_assertions.end());
+    num_last_tracked = tracked_assertions.size();
+    for (term_t assumption : assumptions)
+    {
+        term_t simplified = options.simplify ? preprocessor->simplify(assumption) : assumption;
+        last_assumptions.emplace_back(internalize(simplified), assumption);
+    }
+    is_core_minimized = false;
+
+    // activate all assertion levels
+    std::vector<Literal> literals{activation_literals.begin(), activation_literals.end()};
+    for (auto [literal, _] : last_assumptions)
+    {
+        literals.push_back(literal);
+    }
+
+    Solver::Budget budget;
+    budget.conflicts = options.conflict_limit;
+    budget.memory = options.memory_limit;
+    if (options.timeout > 0)
+    {
+        // at least 1ms so that the budget is not treated as unlimited
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        budget.time = std::max(std::chrono::milliseconds{options.timeout} - elapsed,
+                               std::chrono::milliseconds{1});
+    }
+    solver.solver().set_budget(budget);
+    auto res = solver.solver().check(literals);
 
     if (options.print_stats)
     {
-        std::cout << "Conflicts = " << solver.solver().num_conflicts() << "\n";
-        std::cout << "Conflict clauses = " << solver.solver().num_conflict_clauses() << "\n";
-        std::cout << "Learned clauses = " << solver.solver().num_learned_clauses() << "\n";
-        std::cout << "Decisions = " << solver.solver().num_decisions() << "\n";
-        std::cout << "Restarts = " << solver.solver().num_restarts() << "\n";
+        // one JSON object per check
+        auto const& stats = solver.solver();
+        std::cout << "{\"conflicts\":" << stats.num_conflicts()
+                  << ",\"conflict_clauses\":" << stats.num_conflict_clauses()
+                  << ",\"learned_clauses\":" << stats.num_learned_clauses()
+                  << ",\"decisions\":" << stats.num_decisions()
+                  << ",\"restarts\":" << stats.num_restarts();
+        if (options.simplify)
+        {
+            std::chrono::duration<double> time = preprocessor->total_time();
+            std::cout << ",\"simplification_time\":" << time.count()
+                      << ",\"eliminated_vars\":" << preprocessor->num_eliminated()
+                      << ",\"removed_assertions\":" << preprocessor->num_removed();
+        }
+        auto memory = stats.memory_usage();
+        memory.add("term_table", term_manager.memory_usage());
+        std::cout << ",\"memory\":";
+        memory.print_json(std::cout);
+        std::cout << ",\"statistics\":";
+        Statistics::global().print_json(std::cout);
+        std::cout << "}\n";
     }
 
     if (res == Solver::Result::sat)
@@ -141,15 +481,41 @@ Solver_answer Solver_wrapper::check(std::vector<term_t> const& assertions)
     {
         return Solver_answer::UNSAT;
     }
-    assert(false);
     return Solver_answer::UNKNOWN;
 }
 
+Unsat_core Solver_wrapper::unsat_core()
+{
+    drain();
+    if (options.minimize_cores && !is_core_minimized)
+    {
+        solver.solver().minimize_failed_assumptions(activation_literals);
+        is_core_minimized = true;
+    }
+
+    std::unordered_set<Literal, Literal_hash> failed{
+        solver.solver().failed_assumptions().begin(), 
+        solver.solver().failed_assumptions().end()
+    };
+    Unsat_core core;
+    for (std::size_t i = 0; i < last_assumptions.size(); ++i)
+    {
+        auto [literal, term] = last_assumptions[i];
+        if (failed.erase(literal) > 0) // report each failed literal only once
+        {
+            auto& terms = i < num_last_tracked ? core.assertions : core.assumptions;
+            terms.push_back(term);
+        }
+    }
+    return core;
+}
+
 void Solver_wrapper::model(Default_model_visitor& visitor)
 {
+    drain();
     auto& bool_model = solver.solver().trail().model<bool>(Variable::boolean);
     auto& lra_model = solver.solver().trail().model<Rational>(Variable::rational);
-    for (auto& [term, var] : variables)
+    for (auto [term, var] : internalizer_config->user_vars())
     {
         if (var.type() == Variable::boolean)
         {
@@ -166,6 +532,33 @@ void Solver_wrapper::model(Default_model_visitor& visitor)
             }
         }
     }
+
+    // values of variables which have been eliminated by the preprocessor
+    std::unordered_set<term_t> unconstrained;
+    auto value_of = [&](term_t var) -> Rational {
+        auto var_ord = internalizer_config->get_rational_var_for(var);
+        if (var_ord && lra_model.is_defined(var_ord.value()))
+        {
+            return lra_model.value(var_ord.value());
+        }
+
+        // variable only occurs in definitions of eliminated variables
+        if (!var_ord && unconstrained.insert(var).second)
+        {
+            visitor.visit(var, Rational{0});
+        }
+        return 0;
+    };
+
+    for (term_t var : preprocessor->eliminated())
+    {
+        Rational value = 0;
+        for (auto const& mono : term_manager.term_to_poly(preprocessor->definition(var)))
+        {
+            value += mono.var == term_t::Undef ? mono.coeff : mono.coeff * value_of(mono.var);
+        }
+        visitor.visit(var, value);
+    }
 }
 
 Linear_polynomial Internalizer_config::internalize_poly(term_t t)
@@ -250,9 +643,7 @@ void Internalizer_config::visit(term_t t)
                     : solver.linear_constraint(internal_poly.vars, internal_poly.coef,
                                         Order_predicate::Type::leq, -internal_poly.constant);
         Literal lit = negated ? ~constraint_literal : constraint_literal;
-        term_t positive_term = term_manager.positive_term(t);
-        assert(internal_bool_vars.find(positive_term) == internal_bool_vars.end());
-        internal_bool_vars.insert({positive_term, lit});
+        set_bool_var(t, lit);
         return;
     }
     case terms::Kind::ARITH_EQ_ATOM: {
@@ -260,9 +651,7 @@ void Internalizer_config::visit(term_t t)
         auto internal_poly = internalize_poly(poly_term);
         Literal lit = solver.linear_constraint(internal_poly.vars, internal_poly.coef, Order_predicate::Type::eq, -internal_poly.constant);
         assert(!lit.is_negation());
-        term_t positive_term = term_manager.positive_term(t);
-        assert(internal_bool_vars.find(positive_term) == internal_bool_vars.end());
-        internal_bool_vars.insert({positive_term, lit});
+        set_bool_var(t, lit);
         return;
     }
     case terms::Kind::ARITH_BINEQ_ATOM: {
@@ -283,56 +672,32 @@ void Internalizer_config::visit(term_t t)
         }();
         Literal lit = solver.linear_constraint(poly.vars, poly.coef, Order_predicate::Type::eq, -poly.constant);
         assert(!lit.is_negation());
-        term_t positive_term = term_manager.positive_term(t);
-        assert(internal_bool_vars.find(positive_term) == internal_bool_vars.end());
-        internal_bool_vars.insert({positive_term, lit});
+        set_bool_var(t, lit);
         return;
     }
     case terms::Kind::UNINTERPRETED_TERM:
         if (term_manager.get_type(t) == terms::types::bool_type)
         {
             Variable bool_var = solver.make(Variable::boolean);
-            t = term_manager.positive_term(t);
-            auto [_, inserted] = internal_bool_vars.insert({t, Literal(bool_var.ord())});
-            assert(inserted); (void)(inserted);
+            set_bool_var(t, Literal(bool_var.ord()));
+            uninterpreted_vars.emplace_back(term_manager.positive_term(t), bool_var);
         }
         else if (term_manager.get_type(t) == terms::types::real_type)
         {
             Variable rational_var = solver.make(Variable::rational);
-            auto [_, inserted] = internal_rational_vars.insert({t, rational_var.ord()});
-            assert(inserted); (void)(inserted);
+            set_rational_var(t, rational_var.ord());
+            uninterpreted_vars.emplace_back(t, rational_var);
         }
         return;
     case terms::Kind::OR_TERM:
     {
-        auto args = term_manager.get_args(t);
-        assert(args.size() >= 2);
-        term_t positive_term = term_manager.positive_term(t);
-        assert(internal_bool_vars.find(positive_term) == internal_bool_vars.end());
-        Variable var = new_bool_var();
-        Literal lit = Literal(var.ord());
-        internal_bool_vars.insert({positive_term, lit});
-        std::vector<Literal> arg_literals;
-        arg_literals.reserve(args.size());
-        for (term_t arg : args)
+        assert(term_manager.get_args(t).size() >= 2);
+        // clauses which define the term are asserted by `encode()` once its polarity is known
+        set_bool_var(t, Literal(new_bool_var().ord()));
+        for (term_t arg : term_manager.get_args(t))
         {
-            term_t pos_arg = term_manager.positive_term(arg);
-            assert(internal_bool_vars.find(pos_arg) != internal_bool_vars.end());
-            auto arg_lit = internal_bool_vars.at(pos_arg);
-            if (term_manager.is_negated(arg))
-            {
-                arg_lit.negate();
-            }
-            arg_literals.push_back(arg_lit);
+            add_parent(arg);
         }
-        // binary clauses
-        for (auto arg_lit : arg_literals)
-        {
-            solver.assert_clause(lit, ~arg_lit);
-        }
-        // big clause
-        arg_literals.push_back(~lit);
-        solver.assert_clause(std::move(arg_literals));
         return;
     }
     case terms::Kind::ITE_TERM:
@@ -346,8 +711,7 @@ void Internalizer_config::visit(term_t t)
             term_t true_branch = args[1];
             term_t false_branch = args[2];
             auto var = new_real_var();
-            assert(internal_rational_vars.find(t) == internal_rational_vars.end());
-            internal_rational_vars.insert({t, var.ord()});
+            set_rational_var(t, var.ord());
             auto true_poly = internalize_poly(true_branch);
             auto false_poly = internalize_poly(false_branch);
             // Let v = ite(c, t, f). Then we assert that c => (t = v) and ~c => (f = v)
@@ -357,8 +721,11 @@ void Internalizer_config::visit(term_t t)
             auto true_constraint = solver.linear_constraint(true_poly.vars, true_poly.coef, Order_predicate::Type::eq, -true_poly.constant);;
             auto false_constraint = solver.linear_constraint(false_poly.vars, false_poly.coef, Order_predicate::Type::eq, -false_poly.constant);
             assert(!term_manager.is_negated(cond_term)); // MB: ITE are normalized to have positive condition
-            assert(internal_bool_vars.find(cond_term) != internal_bool_vars.end());
-            Literal l = internal_bool_vars.at(cond_term);
+            Literal l = internal_bool_var(cond_term);
+            // the condition is used in both polarities
+            add_parent(cond_term);
+            encode(cond_term);
+            encode(terms::opposite_term(cond_term));
             solver.assert_clause(l, false_constraint);
             solver.assert_clause(~l, true_constraint);
         }
@@ -367,10 +734,15 @@ void Internalizer_config::visit(term_t t)
 
     case terms::Kind::CONSTANT_TERM:
     {
+        t = term_manager.positive_term(t);
         if (t != terms::true_term)
         {
             throw std::logic_error("Unhandled internalize case!");
         }
+        // represent true by a literal which is asserted as a unit clause
+        Literal lit = Literal(new_bool_var().ord());
+        solver.assert_clause(lit);
+        set_bool_var(t, lit);
         return;
     }
 
@@ -385,8 +757,115 @@ void Internalizer_config::visit(term_t t)
 
 std::optional<Literal> Internalizer_config::get_literal_for(term_t t) const
 {
-    auto it = internal_bool_vars.find(t);
-    return it == internal_bool_vars.end() ? std::optional<Literal>{} : it->second;
+    auto index = static_cast<std::size_t>(term_manager.index_of(t));
+    return index < internal_bool_vars.size() ? internal_bool_vars[index] : std::nullopt;
+}
+
+void Internalizer_config::add_parent(term_t t)
+{
+    if (term_manager.get_kind(t) != terms::Kind::OR_TERM)
+    {
+        return;
+    }
+
+    auto index = static_cast<std::size_t>(term_manager.index_of(t));
+    if (index >= num_parents.size())
+    {
+        num_parents.resize(index + 1, 0);
+    }
+    ++num_parents[index];
+}
+
+bool Internalizer_config::is_inlined(term_t parent, term_t child) const
+{
+    if (term_manager.get_kind(child) != terms::Kind::OR_TERM ||
+        term_manager.is_negated(child) != term_manager.is_negated(parent))
+    {
+        return false;
+    }
+
+    auto index = static_cast<std::size_t>(term_manager.index_of(child));
+    return index < num_parents.size() && num_parents[index] <= 1 &&
+           (index >= encoded_polarities.size() ||
+            (encoded_polarities[index] & polarity_of(child)) == 0);
+}
+
+void Internalizer_config::encode(term_t t)
+{
+    // terms which have to be implied by their literal
+    std::vector<term_t> worklist{t};
+    // arguments of the encoded term (including arguments of inlined terms)
+    std::vector<term_t> stack;
+    std::vector<Literal> arg_literals;
+    while (!worklist.empty())
+    {
+        term_t term = worklist.back();
+        worklist.pop_back();
+        if (term_manager.get_kind(term) != terms::Kind::OR_TERM)
+        {
+            continue; // atoms are represented by a variable without a definition
+        }
+
+        auto index = static_cast<std::size_t>(term_manager.index_of(term));
+        if (index >= encoded_polarities.size())
+        {
+            encoded_polarities.resize(index + 1, 0);
+        }
+        if (encoded_polarities[index] & polarity_of(term))
+        {
+            continue;
+        }
+        encoded_polarities[index] |= polarity_of(term);
+
+        // `or(a, b)` is implied by `~lit or a or b` and `~or(a, b)` is implied by `~lit or ~a`
+        // and `~lit or ~b`, i.e., arguments are negated together with the term
+        auto push_args = [&](term_t parent) {
+            auto args = term_manager.get_args(parent);
+            for (auto it = args.rbegin(); it != args.rend(); ++it)
+            {
+                stack.push_back(term_manager.is_negated(parent) ? terms::opposite_term(*it) : *it);
+            }
+        };
+
+        arg_literals.clear();
+        push_args(term);
+        while (!stack.empty())
+        {
+            term_t arg = stack.back();
+            stack.pop_back();
+            if (is_inlined(term, arg))
+            {
+                push_args(arg);
+            }
+            else
+            {
+                arg_literals.push_back(literal_of(arg));
+                worklist.push_back(arg);
+            }
+        }
+
+        // inlined terms can share arguments
+        std::ranges::sort(arg_literals, Literal_comparer{});
+        auto [end, _] = std::ranges::unique(arg_literals);
+        arg_literals.erase(end, arg_literals.end());
+
+        Literal lit = literal_of(term);
+        if (term_manager.is_negated(term)) // conjunction of arguments
+        {
+            for (auto arg_lit : arg_literals)
+            {
+                solver.assert_clause(~lit, arg_lit);
+            }
+        }
+        else if (std::ranges::adjacent_find(arg_literals, [](auto lhs, auto rhs) {
+                     return lhs.var() == rhs.var();
+                 }) == arg_literals.end()) // disjunction of arguments which is not a tautology
+        {
+            std::vector<Literal> clause{~lit};
+            clause.insert(clause.end(), arg_literals.begin(), arg_literals.end());
+            solver.assert_clause(std::move(clause));
+        }
+    }
 }
 
 } // namespace yaga::parser
\ No newline at end of file
@@ -1,10 +1,17 @@
 #ifndef YAGA_SOLVER_WRAPPER_H
 #define YAGA_SOLVER_WRAPPER_H
 
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
+#include <thread>
 #include <vector>
 #include <ranges>
 
+#include "Preprocessor.h"
 #include "Solver_answer.h"
 #include "Term_manager.h"
 #include "Term_types.h"
@@ -38,16 +45,170 @@ public:
     virtual void visit(terms::term_t, bool) {}
 };
 
+class Internalizer_config;
+
+/** Tracked assertions and assumptions which are inconsistent with the other assertions.
+ */
+struct Unsat_core {
+    // terms asserted by `Solver_wrapper::assert_tracked()`
+    std::vector<terms::term_t> assertions;
+    // terms passed to `Solver_wrapper::check()` as assumptions
+    std::vector<terms::term_t> assumptions;
+};
+
 class Solver_wrapper
 {
     terms::Term_manager& term_manager;
     Options const& options;
     Yaga solver;
-    std::unordered_map<terms::term_t, Variable> variables;
+    // persistent cache of internalized terms shared by all assertions
+    std::unique_ptr<Internalizer_config> internalizer_config;
+    std::unique_ptr<terms::Visitor<Internalizer_config>> internalizer;
+    // activation literal of each assertion level (except for the first level)
+    std::vector<Literal> activation_literals;
+    // assertions which can occur in an unsat core (assumed literal and the asserted term)
+    std::vector<std::pair<Literal, terms::term_t>> tracked_assertions;
+    // number of tracked assertions when an assertion level was pushed
+    std::vector<std::size_t> tracked_limits;
+    // tracked assertions followed by user assumptions of the last check
+    std::vector<std::pair<Literal, terms::term_t>> last_assumptions;
+    // number of tracked assertions in the last check
+    std::size_t num_last_tracked = 0;
+    // true iff failed assumptions of the last check have already been minimized
+    bool is_core_minimized = false;
+    // time when this solver was created (the `timeout` option is measured from this point)
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    // simplification of assertions (if enabled in options)
+    std::unique_ptr<Preprocessor> preprocessor;
+    // assertions of the current level which have not been simplified and internalized yet
+    std::vector<terms::term_t> pending_assertions;
+    // tracked assertions of the current level which have not been internalized yet
+    std::vector<terms::term_t> pending_tracked;
+    // assertions waiting for the internalization thread (the term and whether it is tracked)
+    std::vector<std::pair<terms::term_t, bool>> queued_assertions;
+    // protects `queued_assertions`, `is_worker_busy`, `is_draining` and `is_stopped`
+    std::mutex queue_mutex;
+    // notified when assertions are queued, when the worker is done with a batch or when it stops
+    std::condition_variable queue_changed;
+    // true iff the internalization thread is processing a batch of assertions
+    bool is_worker_busy = false;
+    // true iff a thread waits in `drain()` so that assertions have to be processed immediately
+    bool is_draining = false;
+    // true iff the internalization thread should terminate
+    bool is_stopped = false;
+    // number of queued assertions which wakes up the internalization thread
+    static constexpr std::size_t min_batch_size = 256;
+    // thread which internalizes queued assertions (only if the `pipeline` option is set)
+    std::thread worker;
+
+    /** Internalize @p term and return its literal
+     *
+     * @param term boolean term
+     * @return literal which represents @p term in the solver
+     */
+    Literal internalize(terms::term_t term);
+
+    /** Assert @p literal at the current assertion level
+     *
+     * @param literal internalized assertion
+     */
+    void assert_literal(Literal literal);
+
+    /** Assert @p literal guarded by a fresh tracking literal
+     *
+     * @param literal internalized assertion
+     * @param term term which is reported in `unsat_core()`
+     */
+    void assert_tracked_literal(Literal literal, terms::term_t term);
+
+    /** Simplify and internalize pending assertions of the current level
+     */
+    void flush();
+
+    /** Pass @p term to the internalization thread
+     *
+     * @param term boolean term
+     * @param is_tracked true iff @p term should be asserted as a tracked assertion
+     */
+    void enqueue(terms::term_t term, bool is_tracked);
+
+    /** Wait until the internalization thread asserts all queued assertions.
+     *
+     * Solver state other than the queue can only be accessed by the calling thread after this
+     * function returns (until another assertion is queued).
+     */
+    void drain();
+
+    /** Internalize and assert queued assertions until the wrapper is destroyed.
+     *
+     * This is the main loop of the internalization thread.
+     */
+    void run_worker();
+
 public:
     Solver_wrapper(terms::Term_manager& term_manager, Options const& options);
+    ~Solver_wrapper();
 
-    Solver_answer check(std::vector<terms::term_t> const& assertions);
+    /** Internalize and assert @p term at the current assertion level.
+     *
+     * If simplification is enabled, the assertion is internalized together with other assertions
+     * of the current level in the next `check()` or `push()`. If the `pipeline` option is set,
+     * the assertion is internalized by a background thread without simplification.
+     *
+     * @param term boolean term
+     */
+    void assert_term(terms::term_t term);
+
+    /** Internalize and assert @p term at the current assertion level so that it can be reported
+     * in `unsat_core()`.
+     *
+     * The assertion is guarded by a fresh literal which is assumed in each `check()`.
+     *
+     * @param term boolean term
+     */
+    void assert_tracked(terms::term_t term);
+
+    /** Push a new assertion level.
+     *
+     * Assertions in the new level are guarded by a fresh activation literal which is assumed in
+     * each `check()`.
+     */
+    void push();
+
+    /** Pop the last assertion level.
+     *
+     * Asserted and learned clauses which depend on assertions from the popped level are removed.
+     * Internalized terms and their definitions are kept.
+     */
+    void pop();
+
+    /** Remove all assertions, learned clauses and internalized terms.
+     */
+    void reset();
+
+    /** Get number of pushed assertion levels
+     *
+     * @return number of `push()` calls without a matching `pop()`
+     */
+    inline int num_levels() const { return static_cast<int>(activation_literals.size()); }
+
+    /** Check satisfiability of all assertions in all assertion levels.
+     *
+     * @param assumptions boolean terms which are assumed to be true in this check
+     * @return result of the check
+     */
+    Solver_answer check(std::span<terms::term_t const> assumptions = {});
+
+    /** Get tracked assertions and assumptions which are responsible for the last `unsat` answer
+     * of `check()`.
+     *
+     * If the `minimize_cores` option is set, the core is shrunk to a minimal set using the
+     * incremental solver.
+     *
+     * @return subset of tracked assertions and assumptions of the last `check()` which is
+     * inconsistent with the other (untracked) assertions
+     */
+    Unsat_core unsat_core();
 
     /** Get model generated by the last `check()` call.
      * 
@@ -40,6 +40,7 @@ using namespace yaga::parser;
 "as"                return Token::AS_TOK;
 "!"                 return Token::ATTRIBUTE_TOK;
 "check-sat"         return Token::CHECK_SAT_TOK;
+"check-sat-assuming" return Token::CHECK_SAT_ASSUMING_TOK;
 "declare-const"     return Token::DECLARE_CONST_TOK;
 "declare-fun"       return Token::DECLARE_FUN_TOK;
 "declare-sort"      return Token::DECLARE_SORT_TOK;
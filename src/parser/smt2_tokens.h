@@ -11,6 +11,7 @@ enum class Token : int
     ATTRIBUTE_TOK,
     BINARY_LITERAL,
     CHECK_SAT_TOK,
+    CHECK_SAT_ASSUMING_TOK,
     DECIMAL_LITERAL,
     DECLARE_CONST_TOK,
     DECLARE_FUN_TOK,
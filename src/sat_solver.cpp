@@ -1,22 +1,27 @@
 #include <algorithm>
 #include <chrono>
-#include <cctype>
-#include <fstream>
+#include <deque>
+#include <exception>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include "Bool_theory.h"
+#include "Dimacs_reader.h"
 #include "Evsids.h"
 #include "Restart.h"
+#include "Sat_preprocessor.h"
 #include "Solver.h"
+#include "Statistics.h"
+#include "Trace.h"
 
 using namespace yaga;
 
-bool is_satisfying(Trail const& trail, Database const& db)
+bool is_satisfying(Trail const& trail, std::deque<Clause> const& clauses)
 {
     auto const& model = trail.model<bool>(Variable::boolean);
-    return std::all_of(db.asserted().begin(), db.asserted().end(), [&](auto const& clause) {
+    return std::all_of(clauses.begin(), clauses.end(), [&](auto const& clause) {
         return std::any_of(clause.begin(), clause.end(), [&](auto lit) {
             return model.is_defined(lit.var().ord()) &&
                    model.value(lit.var().ord()) == !lit.is_negation();
@@ -26,9 +31,67 @@ bool is_satisfying(Trail const& trail, Database const& db)
 
 int main(int argc, char** argv)
 {
-    if (argc != 2)
+    bool preprocess = true;
+    bool probing = true;
+    bool vivification = true;
+    bool print_stats = false;
+    // the timeout is measured from the start of the program
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::milliseconds timeout{0};
+    Solver::Budget budget;
+    std::string path;
+    for (int i = 1; i < argc; ++i)
     {
-        std::cerr << "Usage: ./sat [input-path.cnf]" << std::endl;
+        std::string arg{argv[i]};
+        if (arg == "--no-preprocess")
+        {
+            preprocess = false;
+        }
+        else if (arg == "--no-probing")
+        {
+            probing = false;
+        }
+        else if (arg == "--no-vivification")
+        {
+            vivification = false;
+        }
+        else if (arg == "--print-stats")
+        {
+            print_stats = true;
+        }
+        else if (arg == "--timeout" && i + 1 < argc)
+        {
+            timeout = std::chrono::milliseconds{static_cast<long>(std::stod(argv[++i]) * 1000)};
+        }
+        else if (arg == "--conflict-limit" && i + 1 < argc)
+        {
+            budget.conflicts = std::stoll(argv[++i]);
+        }
+        else if (arg == "--memory-limit" && i + 1 < argc)
+        {
+            budget.memory = std::stoll(argv[++i]);
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            Tracer::global().dump_at_exit(argv[++i]);
+        }
+        else if (path.empty() && !arg.starts_with("--"))
+        {
+            path = arg;
+        }
+        else
+        {
+            path.clear();
+            break;
+        }
+    }
+
+    if (path.empty())
+    {
+        std::cerr << "Usage: ./sat [--no-preprocess] [--no-probing] [--no-vivification] "
+                     "[--print-stats] [--trace <path>] [--timeout <s>] [--conflict-limit <n>] "
+                     "[--memory-limit <MB>] [input-path.cnf[.gz|.xz]]"
+                  << std::endl;
         return -1;
     }
 
@@ -36,101 +99,57 @@ int main(int argc, char** argv)
     solver.set_theory<Bool_theory>();
     solver.set_variable_order<Evsids>();
     solver.set_restart_policy<Glucose_restart>();
-
-    std::string path{argv[1]};
-    std::ifstream input{path};
-    bool is_initialized = false;
-    int num_vars = 0;
-    int num_clauses = 0;
-    Clause buffer;
-    std::string line;
-    while (std::getline(input, line))
+    if (probing)
     {
-        line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](auto c) {
-            return !std::isspace(c);
-        }));
-
-        std::istringstream stream{line};
-        if (line.starts_with('c'))
-        {
-            continue;
-        }
-        else if (line.starts_with("p cnf"))
-        {
-            if (is_initialized)
-            {
-                std::cerr << "Error: duplicate DIMACS problem line 'p cnf ...'\n";
-                return -1;
-            }
-            is_initialized = true;
-            stream.seekg(5);
-            if (!(stream >> num_vars >> num_clauses))
-            {
-                std::cerr << "Error: failed to parse the DIMACS problem line." 
-                    << " Expected: 'p cnf [num_vars] [num_clauses]'\n";
-                return -1;
-            }
-            solver.trail().set_model<bool>(Variable::boolean, num_vars);
-        }
-        else
-        {
-            int var;
-            while (stream >> var)
-            {
-                if (!is_initialized)
-                {
-                    std::cerr << "Error: clause before DIMACS problem line.\n";
-                    return -1;
-                }
-                else if (var > num_vars || var < -num_vars)
-                {
-                    std::cerr << "Error: unkown literal " << var << "\n";
-                    return -1;
-                }
-
-                if (var == 0)
-                {
-                    if (num_clauses > 0 && buffer.empty())
-                    {
-                        std::cout << "UNSAT\n";
-                        return 0;
-                    }
+        solver.enable_probing();
+    }
 
-                    if (num_clauses > 0)
-                    {
-                        solver.db().assert_clause(std::move(buffer));
-                    }
-                    buffer.clear();
-                    --num_clauses;
-                }
-                else
-                {
-                    buffer.emplace_back(var < 0 ? ~Literal{-var - 1} : Literal{var - 1});
-                }
-            }
-        }
+    if (vivification)
+    {
+        solver.enable_vivification();
     }
 
-    if (!is_initialized)
+    Dimacs_stats input;
+    try
+    {
+        input = Dimacs_reader{path}.read(solver);
+    }
+    catch (std::exception const& e)
     {
-        std::cerr << "Error: missing DIMANCS problem line. " 
-            << "Expected 'p cnf [num_vars] [num_clauses]'\n";
+        std::cerr << "Error: " << e.what() << "\n";
         return -1;
     }
 
-    if (num_clauses > 0)
+    if (input.has_empty_clause)
     {
-        std::cerr << "Error: insufficient number of clauses.\n";
-        return -1;
+        std::cout << "UNSAT\n";
+        return 0;
+    }
+
+    // the model is checked against the original clauses
+    auto original = solver.db().asserted();
+    Sat_preprocessor preprocessor;
+    if (preprocess && !preprocessor.simplify(solver.db(), input.num_vars))
+    {
+        std::cout << "UNSAT\n";
+        return 0;
     }
 
     auto begin = std::chrono::steady_clock::now();
+    if (timeout.count() > 0)
+    {
+        // at least 1ms so that the budget is not treated as unlimited
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(begin - start);
+        budget.time = std::max(timeout - elapsed, std::chrono::milliseconds{1});
+    }
+    solver.set_budget(budget);
     auto result = solver.check();
     auto end = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin);
     if (result == Solver::Result::sat)
     {
-        if (is_satisfying(solver.trail(), solver.db()))
+        preprocessor.extend(solver.trail().model<bool>(Variable::boolean));
+        if (is_satisfying(solver.trail(), original))
         {
             std::cout << "SAT\n";
         }
@@ -140,16 +159,60 @@ int main(int argc, char** argv)
             return -2;
         }
     }
-    else
+    else if (result == Solver::Result::unsat)
     {
         std::cout << "UNSAT\n";
     }
+    else
+    {
+        std::cout << "UNKNOWN\n";
+    }
+
+    // statistics are printed as `name = value` lines and as a JSON object with `--print-stats`
+    std::ostringstream json;
+    json << "{\"result\":\""
+         << (result == Solver::Result::sat     ? "sat"
+             : result == Solver::Result::unsat ? "unsat"
+                                               : "unknown")
+         << "\"";
+    auto print = [&](std::string_view name, std::string_view key, auto value) {
+        std::cout << name << " = " << value << "\n";
+        json << ",\"" << key << "\":" << value;
+    };
+    auto seconds = [](auto duration) { return std::chrono::duration<double>(duration).count(); };
 
     std::cout << "\n";
-    std::cout << "time[s] = " << (duration.count() / 1e9) << "\n";
-    std::cout << "conflicts = " << solver.num_conflicts() << "\n";
-    std::cout << "decisions = " << solver.num_decisions() << "\n";
-    std::cout << "restarts = " << solver.num_restarts() << "\n";
+    print("parse time[s]", "parse_time", seconds(input.time));
+    print("parse[MB/s]", "parse_mbps", input.megabytes_per_second());
+    print("preprocess time[s]", "preprocess_time", seconds(preprocessor.total_time()));
+    print("eliminated vars", "eliminated_vars", preprocessor.num_eliminated());
+    print("removed clauses", "removed_clauses",
+          preprocessor.num_clauses_before() - preprocessor.num_clauses_after());
+    Probing disabled_probing;
+    auto const& probing_pass = solver.probing() ? *solver.probing() : disabled_probing;
+    print("probing time[s]", "probing_time", seconds(probing_pass.total_time()));
+    print("failed literals", "failed_literals", probing_pass.num_failed());
+    print("equivalent vars", "equivalent_vars", probing_pass.num_substituted());
+    Vivification disabled_vivification;
+    auto const& vivification_pass =
+        solver.vivification() ? *solver.vivification() : disabled_vivification;
+    print("vivification time[s]", "vivification_time", seconds(vivification_pass.total_time()));
+    print("vivified clauses", "vivified_clauses", vivification_pass.num_vivified());
+    print("vivification removed literals", "vivification_removed_literals",
+          vivification_pass.num_removed());
+    print("time[s]", "time", duration.count() / 1e9);
+    print("conflicts", "conflicts", solver.num_conflicts());
+    print("decisions", "decisions", solver.num_decisions());
+    print("restarts", "restarts", solver.num_restarts());
+
+    if (print_stats)
+    {
+        json << ",\"memory\":";
+        solver.memory_usage().print_json(json);
+        json << ",\"statistics\":";
+        Statistics::global().print_json(json);
+        std::cout << json.str() << "}\n";
+    }
 
     return result == Solver::Result::sat ? 1 : 0;
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "Smt2_parser.h"
 #include "Options.h"
+#include "Trace.h"
 
 using namespace yaga;
 
@@ -14,10 +15,21 @@ void print_help()
 {
     std::cerr << "Usage: ./smt [options] [input-path.smt2]" << std::endl;
     std::cerr << "Options:\n";
-    std::cerr << "   --print-stats: print solver counters like the number of conflicts.\n";
+    std::cerr << "   --print-stats: print solver counters, timers and histograms as JSON after each check.\n";
     std::cerr << "   --prop-rational: decide rational variables with only one allowed value first.\n";
     std::cerr << "   --deduce-bounds: derive new bounds in LRA using Fourier-Motzkin elimination.\n";
     std::cerr << "   --phase [positive|negative|cache]: value selection strategy for Boolean variables.\n";
+    std::cerr << "   --minimize-cores: shrink unsat cores to a minimal set.\n";
+    std::cerr << "   --no-simplify: do not simplify assertions before they are internalized.\n";
+    std::cerr << "   --simplify-time-limit <ms>: time limit for simplification of assertions.\n";
+    std::cerr << "   --no-mmap: read the input through a stream instead of mapping it to memory.\n";
+    std::cerr << "   --pipeline: internalize assertions in a background thread while parsing.\n";
+    std::cerr << "   --trace <path>: write a timeline of solver events to path at exit (Chrome\n"
+                 "     trace_event JSON if path ends with .json, binary format otherwise).\n";
+    std::cerr << "   --timeout <s>: answer unknown if the input is not solved in s seconds.\n";
+    std::cerr << "   --conflict-limit <n>: answer unknown if a check exceeds n conflicts.\n";
+    std::cerr << "   --memory-limit <MB>: answer unknown if the solver uses more than MB megabytes\n"
+                 "     (learned clauses are removed when it gets close to the limit).\n";
 }
 
 int main(int argc, char** argv)
@@ -39,6 +51,57 @@ int main(int argc, char** argv)
         {
             options.print_stats = true;
         }
+        else if (arg == "--minimize-cores")
+        {
+            options.minimize_cores = true;
+        }
+        else if (arg == "--no-simplify")
+        {
+            options.simplify = false;
+        }
+        else if (arg == "--no-mmap")
+        {
+            options.mmap_input = false;
+        }
+        else if (arg == "--pipeline")
+        {
+            options.pipeline = true;
+        }
+        else if (arg == "--simplify-time-limit")
+        {
+            if (i + 1 < argc)
+            {
+                options.simplify_time_limit = std::stoi(argv[++i]);
+            }
+        }
+        else if (arg == "--timeout")
+        {
+            if (i + 1 < argc)
+            {
+                options.timeout = static_cast<int>(std::stod(argv[++i]) * 1000);
+            }
+        }
+        else if (arg == "--conflict-limit")
+        {
+            if (i + 1 < argc)
+            {
+                options.conflict_limit = std::stoll(argv[++i]);
+            }
+        }
+        else if (arg == "--memory-limit")
+        {
+            if (i + 1 < argc)
+            {
+                options.memory_limit = std::stoll(argv[++i]);
+            }
+        }
+        else if (arg == "--trace")
+        {
+            if (i + 1 < argc)
+            {
+                Tracer::global().dump_at_exit(argv[++i]);
+            }
+        }
         else if (arg == "--phase")
         {
             if (i + 1 < argc)
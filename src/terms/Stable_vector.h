@@ -0,0 +1,128 @@
+#ifndef YAGA_STABLE_VECTOR_H
+#define YAGA_STABLE_VECTOR_H
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace yaga::terms {
+
+/** Append-only sequence whose elements are never moved.
+ *
+ * Elements are stored in segments of geometrically growing size (the first segment has
+ * `2^first_size_log` elements and each next segment is twice as large as the previous one).
+ * Segments are never reallocated, so references to elements stay valid when new elements are
+ * appended. Moreover, a thread can read elements which have been published to it (e.g., through
+ * a queue protected by a mutex) while a single writer appends new elements.
+ *
+ * @tparam T type of elements
+ * @tparam first_size_log binary logarithm of the size of the first segment
+ */
+template<typename T, std::size_t first_size_log = 10> class Stable_vector {
+    static constexpr std::size_t first_size = std::size_t{1} << first_size_log;
+    static constexpr std::size_t max_segments = 48;
+
+    // allocated segments (null if a segment has not been allocated yet)
+    std::array<T*, max_segments> segments{};
+    // number of elements
+    std::size_t count = 0;
+
+    /** Find segment and offset of the element at position @p index
+     *
+     * @param index position of an element
+     * @return index of the segment and index of the element in that segment
+     */
+    static inline std::pair<std::size_t, std::size_t> locate(std::size_t index)
+    {
+        auto pos = index + first_size;
+        auto segment = static_cast<std::size_t>(std::bit_width(pos)) - 1 - first_size_log;
+        return {segment, pos - (first_size << segment)};
+    }
+
+public:
+    Stable_vector() = default;
+    Stable_vector(Stable_vector const&) = delete;
+    Stable_vector& operator=(Stable_vector const&) = delete;
+
+    ~Stable_vector()
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::destroy_at(&(*this)[i]);
+        }
+
+        std::allocator<T> alloc;
+        for (std::size_t segment = 0; segment < max_segments && segments[segment]; ++segment)
+        {
+            alloc.deallocate(segments[segment], first_size << segment);
+        }
+    }
+
+    /** Append a new element
+     *
+     * @param value value of the new element
+     * @return reference to the new element
+     */
+    T& push_back(T const& value)
+    {
+        auto [segment, offset] = locate(count);
+        assert(segment < max_segments);
+        if (offset == 0 && !segments[segment])
+        {
+            segments[segment] = std::allocator<T>{}.allocate(first_size << segment);
+        }
+        T* element = std::construct_at(segments[segment] + offset, value);
+        ++count;
+        return *element;
+    }
+
+    /** Get element at position @p index
+     *
+     * @param index position of an element smaller than `size()`
+     * @return reference to the element
+     */
+    inline T const& operator[](std::size_t index) const
+    {
+        auto [segment, offset] = locate(index);
+        return segments[segment][offset];
+    }
+
+    inline T& operator[](std::size_t index)
+    {
+        auto [segment, offset] = locate(index);
+        return segments[segment][offset];
+    }
+
+    /** Get number of elements
+     *
+     * @return number of elements appended so far
+     */
+    inline std::size_t size() const { return count; }
+
+    /** Check whether there are no elements
+     *
+     * @return true iff `size() == 0`
+     */
+    inline bool empty() const { return count == 0; }
+
+    /** Get number of elements for which memory has been allocated
+     *
+     * @return total size of all allocated segments
+     */
+    inline std::size_t capacity() const
+    {
+        std::size_t result = 0;
+        for (std::size_t segment = 0; segment < max_segments && segments[segment]; ++segment)
+        {
+            result += first_size << segment;
+        }
+        return result;
+    }
+};
+
+} // namespace yaga::terms
+
+#endif // YAGA_STABLE_VECTOR_H
@@ -0,0 +1,96 @@
+#ifndef YAGA_SYMBOL_TABLE_H
+#define YAGA_SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace yaga::terms {
+
+/**
+ * Handle of an interned symbol (index in the symbol table)
+ */
+using symbol_t = int32_t;
+
+/**
+ * Table of interned symbols (names of terms, functions, let binders, ...).
+ *
+ * Each distinct name is stored once and identified by a dense index, so users of the symbols
+ * can map them to values using vectors instead of hash maps keyed by strings. Symbols are never
+ * removed from the table.
+ */
+class Symbol_table {
+public:
+    /**
+     * Get symbol of @p name. The name is copied to the table if it has not been interned yet.
+     *
+     * @param name name of the symbol
+     * @return handle of the symbol with name @p name
+     */
+    symbol_t intern(std::string_view name)
+    {
+        if (auto it = symbols.find(name); it != symbols.end())
+        {
+            return it->second;
+        }
+        auto symbol = static_cast<symbol_t>(names.size());
+        symbols.emplace(names.emplace_back(name), symbol);
+        return symbol;
+    }
+
+    /**
+     * Find symbol of @p name without interning it
+     *
+     * @param name name of the symbol
+     * @return handle of the symbol with name @p name or none if it has not been interned
+     */
+    std::optional<symbol_t> find(std::string_view name) const
+    {
+        auto it = symbols.find(name);
+        return it != symbols.end() ? std::make_optional(it->second) : std::nullopt;
+    }
+
+    /**
+     * @param symbol handle of an interned symbol
+     * @return name of @p symbol
+     */
+    std::string_view name(symbol_t symbol) const { return names[symbol]; }
+
+    /**
+     * @return number of interned symbols
+     */
+    std::size_t size() const { return names.size(); }
+
+    /**
+     * Estimate memory of names and of the map from names to symbols
+     *
+     * @return number of bytes allocated by this table
+     */
+    std::size_t memory_usage() const
+    {
+        std::size_t result = symbols.bucket_count() * sizeof(void*) +
+                             symbols.size() * (sizeof(std::pair<std::string_view, symbol_t>) +
+                                               2 * sizeof(void*));
+        for (auto const& name : names)
+        {
+            // short strings are stored inside of the string object
+            auto object = reinterpret_cast<char const*>(&name);
+            bool is_inline = name.data() >= object && name.data() < object + sizeof(std::string);
+            result += sizeof(std::string) + (is_inline ? 0 : name.capacity() + 1);
+        }
+        return result;
+    }
+
+private:
+    // names of interned symbols (a deque so that views of the names remain valid)
+    std::deque<std::string> names;
+    // map name -> symbol (keys are views of strings in `names`)
+    std::unordered_map<std::string_view, symbol_t> symbols;
+};
+
+} // namespace yaga::terms
+
+#endif // YAGA_SYMBOL_TABLE_H
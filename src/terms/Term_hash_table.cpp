@@ -1,115 +1,96 @@
 #include "Term_hash_table.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "Terms.h"
 
 namespace yaga::terms {
 
-term_t Term_hash_table::get_composite_term(Composite_term_proxy const& proxy)
+Term_hash_table::Term_hash_table() : entries(initial_capacity, Entry{0, null_term}) {}
+
+template <typename Proxy, typename Construct>
+term_t Term_hash_table::get_term(Proxy const& proxy, Construct&& construct)
 {
-    auto it = terms.find(proxy);
-    if (it != terms.end())
+    std::size_t mask = entries.size() - 1;
+    std::size_t slot = proxy.hash & mask;
+    for (; entries[slot].term != null_term; slot = (slot + 1) & mask)
     {
-        return it->term;
+        if (entries[slot].hash == proxy.hash && equal(proxy, entries[slot].term))
+        {
+            return entries[slot].term;
+        }
     }
-    term_t new_term = proxy.term_table.construct_composite(proxy.kind, proxy.type, proxy.args);
-    auto [tit, inserted] = terms.insert({proxy.hash, new_term});
-    assert(inserted);
-    return tit->term;
-}
 
-term_t Term_hash_table::get_rational_term(Rational_proxy const& proxy)
-{
-    auto it = terms.find(proxy);
-    if (it != terms.end())
+    term_t new_term = construct();
+    entries[slot] = Entry{proxy.hash, new_term};
+    // keep the load factor at most 1/2 so that probe sequences stay short
+    if (2 * ++num_entries > entries.size())
     {
-        return it->term;
+        grow();
     }
-    term_t new_term = proxy.term_table.construct_rational(proxy.kind, proxy.type, proxy.value);
-    auto [tit, inserted] = terms.insert({proxy.hash, new_term});
-    assert(inserted);
-    return tit->term;
+    return new_term;
 }
 
-term_t Term_hash_table::get_constant_term(Constant_term_proxy const& proxy)
+void Term_hash_table::grow()
 {
-    auto it = terms.find(proxy);
-    if (it != terms.end())
+    std::vector<Entry> old_entries(2 * entries.size(), Entry{0, null_term});
+    std::swap(entries, old_entries);
+    std::size_t mask = entries.size() - 1;
+    for (auto const& entry : old_entries)
     {
-        return it->term;
+        if (entry.term != null_term)
+        {
+            std::size_t slot = entry.hash & mask;
+            while (entries[slot].term != null_term)
+            {
+                slot = (slot + 1) & mask;
+            }
+            entries[slot] = entry;
+        }
     }
-    term_t new_term = proxy.term_table.construct_constant(proxy.kind, proxy.type, proxy.index);
-    auto [tit, inserted] = terms.insert({proxy.hash, new_term});
-    assert(inserted);
-    return tit->term;
 }
 
-bool Term_hash_table::KeyEqual::operator()(Composite_term_proxy const& proxy,
-                                           Term_hash_table::Entry const& entry) const
+term_t Term_hash_table::get_composite_term(Composite_term_proxy const& proxy)
 {
-    assert(proxy.hash == entry.hash);
-    auto& term_table = proxy.term_table;
-    if (term_table.get_kind(entry.term) != proxy.kind)
-    {
-        return false;
-    }
-    if (term_table.get_type(entry.term) != proxy.type)
-    {
-        return false;
-    }
-    auto const& other_descriptor = term_table.get_descriptor(entry.term);
-    auto const& other_composite_descriptor =
-        static_cast<composite_term_descriptor_t const&>(other_descriptor);
-    if (other_composite_descriptor.size() != proxy.args.size())
-    {
-        return false;
-    }
-    return std::ranges::equal(other_composite_descriptor.args(), proxy.args);
+    return get_term(proxy, [&]() {
+        return proxy.term_table.construct_composite(proxy.kind, proxy.type, proxy.args);
+    });
+}
+
+term_t Term_hash_table::get_rational_term(Rational_proxy const& proxy)
+{
+    return get_term(proxy, [&]() {
+        return proxy.term_table.construct_rational(proxy.kind, proxy.type, proxy.value);
+    });
 }
 
-bool Term_hash_table::KeyEqual::operator()(Constant_term_proxy const& proxy, Entry const& entry) const
+term_t Term_hash_table::get_constant_term(Constant_term_proxy const& proxy)
 {
-    assert(proxy.hash == entry.hash);
-    auto& term_table = proxy.term_table;
-    if (term_table.get_kind(entry.term) != proxy.kind)
-    {
-        return false;
-    }
-    if (term_table.get_type(entry.term) != proxy.type)
-    {
-        return false;
-    }
+    return get_term(proxy, [&]() {
+        return proxy.term_table.construct_constant(proxy.kind, proxy.type, proxy.index);
+    });
+}
 
-    auto const& other_descriptor = term_table.get_descriptor(entry.term);
-    auto const& other_constant_descriptor =
-        static_cast<constant_term_descriptor_t const&>(other_descriptor);
-    return other_constant_descriptor.index() == proxy.index;
+bool Term_hash_table::equal(Composite_term_proxy const& proxy, term_t term)
+{
+    auto const& term_table = proxy.term_table;
+    return term_table.get_kind(term) == proxy.kind && term_table.get_type(term) == proxy.type &&
+           std::ranges::equal(term_table.get_args(term), proxy.args);
 }
 
-bool Term_hash_table::KeyEqual::operator()(Rational_proxy const& proxy,
-                                           Term_hash_table::Entry const& entry) const
+bool Term_hash_table::equal(Constant_term_proxy const& proxy, term_t term)
 {
-    assert(proxy.hash == entry.hash);
-    auto& term_table = proxy.term_table;
-    if (term_table.get_kind(entry.term) != proxy.kind)
-    {
-        return false;
-    }
-    if (term_table.get_type(entry.term) != proxy.type)
-    {
-        return false;
-    }
-    auto const& other_descriptor = term_table.get_descriptor(entry.term);
-    auto const& other_rational_descriptor =
-        static_cast<rational_term_descriptor_t const&>(other_descriptor);
-    return other_rational_descriptor.value() == proxy.value;
+    auto const& term_table = proxy.term_table;
+    return term_table.get_kind(term) == proxy.kind && term_table.get_type(term) == proxy.type &&
+           term_table.constant_index(term) == proxy.index;
 }
 
-bool Term_hash_table::KeyEqual::operator()(Term_hash_table::Entry const& first,
-                                           Term_hash_table::Entry const& second) const
+bool Term_hash_table::equal(Rational_proxy const& proxy, term_t term)
 {
-    return first.hash == second.hash && first.term == second.term;
+    auto const& term_table = proxy.term_table;
+    return term_table.get_kind(term) == proxy.kind && term_table.get_type(term) == proxy.type &&
+           term_table.arithmetic_constant_value(term) == proxy.value;
 }
 
-} // namespace yaga::terms
\ No newline at end of file
+} // namespace yaga::terms
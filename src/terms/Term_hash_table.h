@@ -4,7 +4,7 @@
 #include "Term_types.h"
 
 #include <span>
-#include <unordered_set>
+#include <vector>
 
 #include <Rational.h>
 
@@ -47,33 +47,55 @@ struct Rational_proxy : public Term_hash_proxy
         Term_hash_proxy(Kind::ARITH_CONSTANT, types::real_type, hash, termTable), value(value) {}
 };
 
+/**
+ * Hash table used for hash consing of terms.
+ *
+ * The table uses open addressing with linear probing. Each slot stores the hash of a term and its
+ * handle, so the table can grow without recomputing hashes. Terms are never removed.
+ */
 class Term_hash_table {
 public:
+    Term_hash_table();
+
     [[nodiscard]] term_t get_composite_term(Composite_term_proxy const& proxy);
     [[nodiscard]] term_t get_rational_term(Rational_proxy const& proxy);
     [[nodiscard]] term_t get_constant_term(Constant_term_proxy const& proxy);
 
+    // number of bytes allocated by slots of the table
+    std::size_t memory_usage() const { return entries.capacity() * sizeof(Entry); }
+
 private:
     struct Entry {
         uint64_t hash;
         term_t term;
     };
 
-    struct Hash {
-        using is_transparent = void;
-        uint64_t operator()(Entry const& entry) const { return entry.hash; }
-        uint64_t operator()(Term_hash_proxy const& proxy) const { return proxy.hash; }
-    };
-
-    struct KeyEqual {
-        using is_transparent = void;
-        bool operator()(Entry const& proxy, Entry const& entry) const;
-        bool operator()(Composite_term_proxy const& proxy, Entry const& entry) const;
-        bool operator()(Constant_term_proxy const& proxy, Entry const& entry) const;
-        bool operator()(Rational_proxy const& proxy, Entry const& entry) const;
-    };
-
-    std::unordered_set<Entry, Hash, KeyEqual> terms;
+    // initial number of slots (must be a power of 2)
+    static constexpr std::size_t initial_capacity = 1024;
+
+    // slots of the table (empty slots contain `null_term`)
+    std::vector<Entry> entries;
+    // number of used slots
+    std::size_t num_entries = 0;
+
+    /**
+     * Find a term equal to @p proxy in the table or create it if there is no such term
+     *
+     * @param proxy description of the term
+     * @param construct function which creates a new term described by @p proxy
+     * @return handle of the term described by @p proxy
+     */
+    template <typename Proxy, typename Construct>
+    term_t get_term(Proxy const& proxy, Construct&& construct);
+
+    /**
+     * Double the number of slots and reinsert all terms
+     */
+    void grow();
+
+    static bool equal(Composite_term_proxy const& proxy, term_t term);
+    static bool equal(Constant_term_proxy const& proxy, term_t term);
+    static bool equal(Rational_proxy const& proxy, term_t term);
 };
 
 } // namespace yaga::terms
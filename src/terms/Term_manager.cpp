@@ -1,6 +1,7 @@
 #include "Term_manager.h"
 
 #include <algorithm>
+#include <charconv>
 #include <numeric>
 
 #include "Arithmetic_polynomial.h"
@@ -17,21 +18,46 @@ Term_manager::Term_manager()
 
 Term_manager::~Term_manager() = default;
 
-void Term_manager::set_term_name(term_t t, std::string const& name)
+Symbol_table& Term_manager::symbols()
+{
+    return term_table->symbols();
+}
+
+void Term_manager::set_term_name(term_t t, symbol_t name)
 {
     term_table->set_term_name(t, name);
 }
 
+void Term_manager::set_term_name(term_t t, std::string_view name)
+{
+    term_table->set_term_name(t, term_table->symbols().intern(name));
+}
+
+void Term_manager::remove_term_name(term_t t)
+{
+    term_table->remove_term_name(t);
+}
+
 std::optional<std::string_view> Term_manager::get_term_name(term_t t) const
 {
     return term_table->get_term_name(t);
 }
 
-std::optional<term_t> Term_manager::get_term_by_name(std::string const& name)
+std::optional<term_t> Term_manager::get_term_by_name(std::string_view name) const
 {
     return term_table->get_term_by_name(name);
 }
 
+std::optional<term_t> Term_manager::get_term_by_symbol(symbol_t symbol) const
+{
+    return term_table->get_term_by_symbol(symbol);
+}
+
+std::size_t Term_manager::memory_usage() const
+{
+    return term_table->memory_usage();
+}
+
 type_t Term_manager::get_type(term_t term) const
 {
     return term_table->get_type(term);
@@ -143,7 +169,7 @@ term_t Term_manager::mk_term(Kind kind, std::span<term_t> args)
     }
 }
 
-term_t Term_manager::mk_term(std::string const& op, std::span<term_t> args)
+term_t Term_manager::mk_term(std::string_view op, std::span<term_t> args)
 {
     if (op == ">=")
     {
@@ -320,31 +346,52 @@ term_t Term_manager::mk_xor(term_t t1, term_t t2)
 }
 
 
-term_t Term_manager::mk_integer_constant(std::string const& str)
+namespace {
+
+// maximal number of decimal digits which always fit into a 64-bit integer
+constexpr std::size_t max_word_digits = 18;
+
+/** Convert a string of decimal digits to a rational number
+ *
+ * @param digits non-empty string of decimal digits
+ * @return integer represented by @p digits
+ */
+Rational parse_digits(std::string_view digits)
+{
+    if (digits.size() > max_word_digits)
+    {
+        return Rational{std::string{digits}.c_str()};
+    }
+    int64_t value = 0;
+    std::from_chars(digits.data(), digits.data() + digits.size(), value);
+    return Rational{value};
+}
+
+} // namespace
+
+term_t Term_manager::mk_integer_constant(std::string_view str)
 {
-    Rational rat(str.c_str());
+    Rational rat = parse_digits(str);
     assert(rat.isInteger());
     return term_table->arithmetic_constant(rat);
 }
 
-term_t Term_manager::mk_rational_constant(std::string const& str)
+term_t Term_manager::mk_rational_constant(std::string_view str)
 {
-    // TODO: This should be revisited and checked if it can be improved
     auto separator_position = str.find('.');
-    if (separator_position == std::string::npos)
+    if (separator_position == std::string_view::npos)
     {
         return mk_integer_constant(str);
     }
-    auto integral_part = str.substr(0, separator_position);
-    auto integral_value = Rational(integral_part.c_str()); // TODO: Make Rational accept string_view
-    std::string fractional_part = str.substr(separator_position + 1);
+    auto integral_value = parse_digits(str.substr(0, separator_position));
+    auto fractional_part = str.substr(separator_position + 1);
     auto precision = Rational(1);
     for (auto i = 0u; i < fractional_part.size(); ++i)
     {
         precision *= 10;
     }
 
-    auto fractional_value = Rational(fractional_part.c_str());
+    auto fractional_value = parse_digits(fractional_part);
     auto gcd_value = gcd(precision, fractional_value);
     auto num = fractional_value / gcd_value;
     auto den = precision / gcd_value;
@@ -6,6 +6,7 @@
 #include <span>
 
 #include "Arithmetic_polynomial.h"
+#include "Symbol_table.h"
 #include "Term_types.h"
 
 namespace yaga::terms {
@@ -36,7 +37,7 @@ public:
      * @param args argument list
      * @return handle to the corresponding composite term
      */
-    term_t mk_term(std::string const& op, std::span<term_t> args);
+    term_t mk_term(std::string_view op, std::span<term_t> args);
 
     /**
      * Gets the term of the specified kind with the given list of argument terms
@@ -93,9 +94,9 @@ public:
      * Arithmetic terms
      */
 
-    term_t mk_integer_constant(std::string const& str);
+    term_t mk_integer_constant(std::string_view str);
 
-    term_t mk_rational_constant(std::string const& str);
+    term_t mk_rational_constant(std::string_view str);
 
     term_t mk_arithmetic_eq(term_t t1, term_t t2);
 
@@ -122,9 +123,16 @@ public:
     /*
      * term names
      */
-    void set_term_name(term_t t, std::string const& name);
+    Symbol_table& symbols();
+    void set_term_name(term_t t, symbol_t name);
+    void set_term_name(term_t t, std::string_view name);
+    void remove_term_name(term_t t);
     std::optional<std::string_view> get_term_name(term_t t) const;
-    std::optional<term_t> get_term_by_name(std::string const& name);
+    std::optional<term_t> get_term_by_name(std::string_view name) const;
+    std::optional<term_t> get_term_by_symbol(symbol_t symbol) const;
+
+    // estimate number of bytes allocated by the term table
+    std::size_t memory_usage() const;
 
     /*
      * term queries
@@ -158,10 +166,26 @@ public:
 
     [[nodiscard]] Rational const& coeff_of_product(term_t arithmetic_product) const;
 
-private:
+    /*
+     * conversion between arithmetic terms and polynomials
+     */
+
+    /**
+     * Gets the normalized term of a polynomial
+     * @param poly linear polynomial over variables and ITE terms
+     * @return arithmetic term equal to @p poly
+     */
     term_t poly_to_term(poly_t const& poly);
+
+    /**
+     * Gets the polynomial of an arithmetic term
+     * @param term arithmetic term
+     * @return linear polynomial equal to @p term (the constant uses `term_t::Undef` as variable)
+     */
     poly_t term_to_poly(term_t term);
 
+private:
+
     term_t mk_bool_ite(term_t i, term_t t, term_t e);
     term_t mk_arithmetic_ite(term_t i, term_t t, term_t e);
 
@@ -1,35 +1,44 @@
 #ifndef YAGA_TERM_REWRITER_H
 #define YAGA_TERM_REWRITER_H
 
-#include <unordered_set>
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
+#include "Epoch_set.h"
 #include "Term_manager.h"
+#include "Terms.h"
 
 namespace yaga::terms {
 
 template<typename TConfig> class Rewriter {
+    struct DFSEntry {
+        explicit DFSEntry(term_t term) : term(term) {}
+        term_t term;
+        unsigned int next_child = 0;
+    };
 
 protected:
     Term_manager & tm;
     TConfig & cfg;
 
+    // handles (`term_t::x`) of terms processed in the current call of `rewrite()`
+    Epoch_set processed;
+    // term handle -> rewritten term (only valid for terms in `processed`)
+    std::vector<term_t> rewritten;
+    // DFS stack and a buffer for arguments reused by all calls of `rewrite()`
+    std::vector<DFSEntry> toProcess;
+    std::vector<term_t> aux_args;
+
 public:
     Rewriter(Term_manager & tm, TConfig & cfg) : tm(tm), cfg(cfg) {}
 
     term_t rewrite(term_t root) {
-        struct DFSEntry {
-            explicit DFSEntry(term_t term) : term(term) {}
-            term_t term;
-            unsigned int next_child = 0;
-        };
-
-        std::unordered_map<term_t, term_t> substitutions;
-        std::unordered_set<term_t> processed;
-        std::vector<DFSEntry> toProcess;
-        std::vector<term_t> aux_args;
-        auto is_processed = [&processed](term_t term) { return processed.find(term) != processed.end(); };
+        processed.clear();
+        auto is_processed = [this](term_t term) { return processed.contains(term.x); };
+        auto result_of = [this](term_t term) { return rewritten[term.x]; };
 
+        assert(toProcess.empty());
         toProcess.emplace_back(root);
         while (not toProcess.empty())
         {
@@ -41,34 +50,37 @@ public:
             {
                 term_t next_child = children[current_entry.next_child];
                 ++current_entry.next_child;
-                if (is_processed(next_child)) { toProcess.emplace_back(next_child); }
+                if (not is_processed(next_child)) { toProcess.emplace_back(next_child); }
                 continue;
             }
             // If we are here, we have already processed all children
-            assert(substitutions.count(current_term) == 0);
             bool needs_change = false;
             for (term_t child : children)
             {
-                auto it = substitutions.find(child);
-                bool child_changed = it != substitutions.end();
-                needs_change |= child_changed;
-                term_t newChild = child_changed ? it->second : child;
+                term_t newChild = result_of(child);
+                needs_change |= newChild != child;
                 assert(tm.get_type(child) == tm.get_type(newChild));
                 aux_args.push_back(newChild);
             }
-            term_t newTerm = needs_change ? tm.mk_term(tm.get_kind(current_term), aux_args) : current_term;
+            // children are shared by both polarities, so rebuild the positive term and negate it
+            term_t newTerm = current_term;
+            if (needs_change)
+            {
+                newTerm = tm.mk_term(tm.get_kind(current_term), aux_args);
+                newTerm = tm.is_negated(current_term) ? opposite_term(newTerm) : newTerm;
+            }
             aux_args.clear();
-            term_t rewritten = cfg.rewrite(newTerm);
-            if (rewritten != newTerm or needs_change) {
-                assert(tm.get_type(current_term) == tm.get_type(rewritten));
-                substitutions.insert({current_term, rewritten});
+            term_t result = cfg.rewrite(newTerm);
+            assert(tm.get_type(current_term) == tm.get_type(result));
+            if (static_cast<std::size_t>(current_term.x) >= rewritten.size())
+            {
+                rewritten.resize(std::max<std::size_t>(current_term.x + 1, 2 * rewritten.size()));
             }
-            processed.insert(current_term);
+            rewritten[current_term.x] = result;
+            processed.insert(current_term.x);
             toProcess.pop_back();
         }
-
-        auto it = substitutions.find(root);
-        return it == substitutions.end() ? root : it->second;
+        return result_of(root);
     }
 };
 
@@ -101,7 +113,7 @@ public:
     }
 };
 
-term_t simultaneous_variable_substitution(Term_manager& tm, subst_map_t const& map, term_t term)
+inline term_t simultaneous_variable_substitution(Term_manager& tm, subst_map_t const& map, term_t term)
 {
     VarSubstituteConfig config(tm, map);
     Rewriter<VarSubstituteConfig> rewriter(tm, config);
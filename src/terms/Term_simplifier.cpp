@@ -0,0 +1,136 @@
+#include "Term_simplifier.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace yaga::terms {
+
+term_t SimplifyConfig::rewrite(term_t term)
+{
+    term_t positive = tm.positive_term(term);
+    term_t result = positive;
+    switch (tm.get_kind(positive))
+    {
+    case Kind::UNINTERPRETED_TERM:
+        if (auto it = subst_map.find(positive); it != subst_map.end())
+        {
+            result = it->second;
+        }
+        break;
+    case Kind::ITE_TERM:
+        result = flatten_ite(positive);
+        break;
+    case Kind::ARITH_GE_ATOM:
+    case Kind::ARITH_EQ_ATOM:
+    case Kind::ARITH_BINEQ_ATOM:
+        if (auto lifted = lift_ite(positive))
+        {
+            result = lifted.value();
+        }
+        else
+        {
+            result = normalize_atom(positive);
+        }
+        break;
+    default:
+        break;
+    }
+    return tm.is_negated(term) ? opposite_term(result) : result;
+}
+
+term_t SimplifyConfig::flatten_ite(term_t ite)
+{
+    auto args = tm.get_args(ite);
+    term_t cond = args[0];
+    term_t then_term = args[1];
+    term_t else_term = args[2];
+    // ite(c, ite(c, a, b), e) = ite(c, a, e) and ite(c, t, ite(c, a, b)) = ite(c, t, b)
+    while (tm.is_ite(then_term) && tm.get_args(then_term)[0] == cond)
+    {
+        then_term = tm.get_args(then_term)[1];
+    }
+    while (tm.is_ite(else_term) && tm.get_args(else_term)[0] == cond)
+    {
+        else_term = tm.get_args(else_term)[2];
+    }
+
+    if (then_term == args[1] && else_term == args[2])
+    {
+        return ite;
+    }
+    return tm.mk_ite(cond, then_term, else_term);
+}
+
+std::optional<term_t> SimplifyConfig::lift_ite(term_t atom)
+{
+    auto poly = atom_poly(atom);
+    auto it = std::find_if(poly.begin(), poly.end(), [&](auto const& mono) {
+        return mono.var != term_t::Undef && tm.is_ite(mono.var);
+    });
+    if (it == poly.end())
+    {
+        return std::nullopt;
+    }
+
+    term_t ite = it->var;
+    Rational coeff = poly.remove_var(ite);
+    auto branch_atom = [&](term_t branch) {
+        auto branch_poly = poly;
+        branch_poly.merge(tm.term_to_poly(branch), coeff);
+        return mk_atom(atom, branch_poly);
+    };
+
+    auto args = tm.get_args(ite);
+    term_t then_atom = branch_atom(args[1]);
+    term_t else_atom = branch_atom(args[2]);
+    auto is_constant = [](term_t t) { return t == true_term || t == false_term; };
+    if (!is_constant(then_atom) && !is_constant(else_atom))
+    {
+        return std::nullopt; // lifting would duplicate the atom
+    }
+    return tm.mk_ite(args[0], then_atom, else_atom);
+}
+
+term_t SimplifyConfig::normalize_atom(term_t atom)
+{
+    if (tm.get_kind(atom) == Kind::ARITH_BINEQ_ATOM)
+    {
+        return atom; // `x = y` and `x = c` are already normalized
+    }
+
+    auto poly = atom_poly(atom);
+    auto it = std::find_if(poly.begin(), poly.end(),
+                           [](auto const& mono) { return mono.var != term_t::Undef; });
+    assert(it != poly.end());
+    Rational divisor = it->coeff;
+    if (tm.get_kind(atom) == Kind::ARITH_GE_ATOM && divisor < 0)
+    {
+        divisor = -divisor; // dividing by a negative number would change the predicate
+    }
+
+    if (divisor == 1)
+    {
+        return atom;
+    }
+    poly.divide_by(divisor);
+    return mk_atom(atom, poly);
+}
+
+poly_t SimplifyConfig::atom_poly(term_t atom)
+{
+    auto args = tm.get_args(atom);
+    if (tm.get_kind(atom) == Kind::ARITH_BINEQ_ATOM)
+    {
+        return tm.term_to_poly(tm.mk_arithmetic_minus(args[0], args[1]));
+    }
+    return tm.term_to_poly(args[0]);
+}
+
+term_t SimplifyConfig::mk_atom(term_t atom, poly_t const& poly)
+{
+    term_t poly_term = tm.poly_to_term(poly);
+    return tm.get_kind(atom) == Kind::ARITH_GE_ATOM ? tm.mk_arithmetic_geq(poly_term, zero_term)
+                                                    : tm.mk_arithmetic_eq(poly_term, zero_term);
+}
+
+} // namespace yaga::terms
@@ -0,0 +1,71 @@
+#ifndef YAGA_TERM_SIMPLIFIER_H
+#define YAGA_TERM_SIMPLIFIER_H
+
+#include <optional>
+
+#include "Term_manager.h"
+#include "Term_rewriter.h"
+
+namespace yaga::terms {
+
+/**
+ * Rewriter configuration which performs local simplifications of terms:
+ *  - substitution of uninterpreted constants by terms from a substitution map,
+ *  - normalization of arithmetic atoms (the first variable has coefficient 1 or -1),
+ *  - flattening of nested ITE terms with the same condition,
+ *  - lifting of ITE terms from arithmetic atoms if one of the branches simplifies to a constant.
+ *
+ * Constants are folded by `Term_manager` when a term with changed children is rebuilt.
+ */
+class SimplifyConfig : public DefaultRewriterConfig
+{
+    Term_manager& tm;
+    subst_map_t const& subst_map;
+
+    /**
+     * Flatten ITE terms in branches of @p ite which have the same condition as @p ite
+     * @param ite positive arithmetic ITE term
+     * @return equivalent ITE term without nested ITE terms with the same condition
+     */
+    term_t flatten_ite(term_t ite);
+
+    /**
+     * Lift the first ITE term in an arithmetic atom if it simplifies one of the branches
+     * @param atom positive arithmetic atom
+     * @return `(ite c atom[t] atom[e])` if `atom[t]` or `atom[e]` is a boolean constant,
+     * none otherwise
+     */
+    std::optional<term_t> lift_ite(term_t atom);
+
+    /**
+     * Divide polynomial of an arithmetic atom so that the first variable has coefficient 1
+     * (or -1 in inequalities)
+     * @param atom positive arithmetic atom
+     * @return normalized atom equivalent to @p atom
+     */
+    term_t normalize_atom(term_t atom);
+
+    /**
+     * Get polynomial @p p such that @p atom is `p >= 0` or `p = 0`
+     * @param atom positive arithmetic atom
+     * @return polynomial of @p atom
+     */
+    poly_t atom_poly(term_t atom);
+
+    /**
+     * Create arithmetic atom of the same kind as @p atom with a different polynomial
+     * @param atom positive arithmetic atom
+     * @param poly new polynomial of the atom
+     * @return `poly >= 0` if @p atom is an inequality, `poly = 0` otherwise
+     */
+    term_t mk_atom(term_t atom, poly_t const& poly);
+
+public:
+    SimplifyConfig(Term_manager& tm, subst_map_t const& subst_map) : tm(tm), subst_map(subst_map) {}
+
+    term_t rewrite(term_t term) override;
+};
+
+} // namespace yaga::terms
+
+#endif // YAGA_TERM_SIMPLIFIER_H
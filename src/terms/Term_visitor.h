@@ -1,8 +1,9 @@
 #ifndef YAGA_TERM_VISITOR_H
 #define YAGA_TERM_VISITOR_H
 
-#include <unordered_set>
+#include <vector>
 
+#include "Epoch_set.h"
 #include "Term_manager.h"
 
 namespace yaga::terms
@@ -10,9 +11,18 @@ namespace yaga::terms
 
 template<typename TConfig> class Visitor
 {
+    struct DFSEntry {
+        explicit DFSEntry(term_t term) : term(term) {}
+        term_t term;
+        unsigned int next_child = 0;
+    };
+
     Term_manager const& term_manager;
     TConfig& config;
-    std::unordered_set<int32_t> processed;
+    // indices of visited terms (term indices are dense, so a bitmap-like set is sufficient)
+    Epoch_set processed;
+    // DFS stack reused by all calls of `visit()`
+    std::vector<DFSEntry> worklist;
 
 public:
     Visitor(Term_manager const& term_manager, TConfig& config) : term_manager(term_manager), config(config) {}
@@ -27,7 +37,7 @@ public:
     {
         for (term_t root : roots)
         {
-            if (processed.count(term_manager.index_of(root)) == 0)
+            if (!processed.contains(term_manager.index_of(root)))
             {
                 visit(root);
             }
@@ -36,14 +46,7 @@ public:
 
     void visit(term_t root)
     {
-        struct DFSEntry {
-            explicit DFSEntry(term_t term) : term(term) {}
-            term_t term;
-            unsigned int next_child = 0;
-        };
-
-        std::vector<DFSEntry> worklist;
-
+        assert(worklist.empty());
         worklist.emplace_back(root);
         while (!worklist.empty())
         {
@@ -53,13 +56,13 @@ public:
             if (current_entry.next_child < children.size()) {
                 term_t next_child = children[current_entry.next_child];
                 ++current_entry.next_child;
-                if (processed.find(term_manager.index_of(next_child)) == processed.end()) {
+                if (!processed.contains(term_manager.index_of(next_child))) {
                     worklist.emplace_back(next_child);
                 }
                 continue;
             }
             // If we are here, we have already processed all children
-            assert(processed.count(term_manager.index_of(current)) == 0);
+            assert(!processed.contains(term_manager.index_of(current)));
             config.visit(current);
             processed.insert(term_manager.index_of(current));
             worklist.pop_back();
@@ -1,30 +1,38 @@
 #include "Terms.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace yaga::terms {
 
-namespace { // Hash functions. TODO: Improve
+namespace { // Hash functions
+
+// finalizer of the SplitMix64 generator (mixes all bits of the input)
+uint64_t mix(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
 uint64_t hash_composite_term(Kind kind, std::span<term_t> args) {
-    std::hash<int32_t> hasher;
-    uint64_t result = hasher(static_cast<std::underlying_type<Kind>::type>(kind));
+    uint64_t result = mix(static_cast<uint64_t>(kind));
     for (term_t arg : args) {
-        result = result * 31 + hasher(arg.x);
+        result = mix(result + static_cast<uint32_t>(arg.x));
     }
     return result;
 }
 
 uint64_t hash_integer_term(Kind kind, type_t tau, int32_t index) {
-    std::hash<int32_t> hasher;
-    uint64_t result = hasher(static_cast<std::underlying_type<Kind>::type>(kind));
-    result = result * 31 + hasher(tau);
-    result = result * 31 + hasher(index);
+    uint64_t result = mix(static_cast<uint64_t>(kind));
+    result = mix(result + static_cast<uint32_t>(tau));
+    result = mix(result + static_cast<uint32_t>(index));
     return result;
 }
 
 uint64_t hash_rational(Rational const& value) {
     // TODO: Implement hashing in Rationals to return 64-bit hash
-    return value.getHashValue();
+    return mix(value.getHashValue());
 }
 }
 
@@ -33,74 +41,67 @@ Term_table::Term_table()
     add_primitive_terms();
 }
 
-composite_term_descriptor_t::composite_term_descriptor_t(std::span<term_t> args)
-    : m_args(args.begin(), args.end())
-{
-}
+Kind Term_table::get_kind(term_t t) const { return inner_table[index_of(t)].kind; }
 
-std::unique_ptr<composite_term_descriptor_t>
-composite_term_descriptor_t::make(std::span<term_t> args)
-{
-    return std::unique_ptr<composite_term_descriptor_t>(new composite_term_descriptor_t(args));
-}
+type_t Term_table::get_type(term_t t) const { return inner_table[index_of(t)].type; }
 
-std::unique_ptr<rational_term_descriptor_t>
-rational_term_descriptor_t::make(Rational const& val)
+term_t const* Term_table::store_args(std::span<term_t const> args)
 {
-    return std::unique_ptr<rational_term_descriptor_t>(new rational_term_descriptor_t(val));
+    if (args.size() > static_cast<std::size_t>(end_arg - next_arg))
+    {
+        if (args.size() > arg_block_size / 2)
+        {
+            // large argument lists get their own block so that the current block is not wasted
+            auto& block = arg_blocks.emplace_back(new term_t[args.size()]);
+            std::ranges::copy(args, block.get());
+            return block.get();
+        }
+        next_arg = arg_blocks.emplace_back(new term_t[arg_block_size]).get();
+        end_arg = next_arg + arg_block_size;
+    }
+    term_t* result = next_arg;
+    next_arg = std::ranges::copy(args, next_arg).out;
+    return result;
 }
 
-std::unique_ptr<constant_term_descriptor_t>
-constant_term_descriptor_t::make(int32_t index)
+term_t Term_table::construct(Term term)
 {
-    return std::unique_ptr<constant_term_descriptor_t>(new constant_term_descriptor_t(index));
+    auto index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
+    this->inner_table.push_back(term);
+    return positive_term(index);
 }
 
-
-
-
-Kind Term_table::get_kind(term_t t) const { return inner_table[index_of(t)].kind; }
-
-type_t Term_table::get_type(term_t t) const { return inner_table[index_of(t)].type; }
-
-term_descriptor_t const& Term_table::get_descriptor(term_t t) const { return *inner_table[index_of(t)].descriptor; }
-
 term_t Term_table::construct_composite(Kind kind, type_t type, std::span<term_t> args)
 {
-    auto term = composite_term_descriptor_t::make(args);
-    auto index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{kind, type, std::move(term)});
-    return positive_term(index);
+    Term term{kind, type, static_cast<uint32_t>(args.size()), {}};
+    term.args = store_args(args);
+    return construct(term);
 }
 
 term_t Term_table::construct_rational(Kind kind, type_t type, Rational const& value)
 {
-    auto term = rational_term_descriptor_t::make(value);
-    auto index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{kind, type, std::move(term)});
-    return positive_term(index);
+    Term term{kind, type, 0, {}};
+    term.index = static_cast<int32_t>(rationals.size());
+    rationals.push_back(value);
+    return construct(term);
 }
 
 term_t Term_table::construct_constant(Kind kind, type_t type, int32_t index)
 {
-    auto term = constant_term_descriptor_t::make(index);
-    auto term_index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{kind, type, std::move(term)});
-    return positive_term(term_index);
+    Term term{kind, type, 0, {}};
+    term.index = index;
+    return construct(term);
 }
 
 term_t Term_table::construct_uninterpreted_constant(type_t type)
 {
-    auto term_descriptor = std::unique_ptr<term_descriptor_t>();
-    auto term_index = static_cast<int32_t>(inner_table.size()); // TODO: Check Max term count
-    this->inner_table.push_back(Term{Kind::UNINTERPRETED_TERM, type, std::move(term_descriptor)});
-    return positive_term(term_index);
+    return construct(Term{Kind::UNINTERPRETED_TERM, type, 0, {}});
 }
 
 void Term_table::add_primitive_terms()
 {
     assert(inner_table.empty());
-    inner_table.push_back(Term{Kind::RESERVED_TERM, types::null_type, nullptr});
+    construct(Term{Kind::RESERVED_TERM, types::null_type, 0, {}});
 
     term_t allocated_true_term = constant_term(types::bool_type, 0);
     assert(allocated_true_term == true_term);
@@ -192,31 +193,68 @@ term_t Term_table::new_uninterpreted_constant(type_t tau)
     return construct_uninterpreted_constant(tau);
 }
 
-void Term_table::set_term_name(term_t t, std::string const& name)
+void Term_table::set_term_name(term_t t, symbol_t name)
 {
+    if (static_cast<std::size_t>(name) >= term_of_symbol.size())
     {
-        auto [it, inserted] = symbol_table.insert({name, t});
-        assert(inserted);
-        (void)inserted;
+        term_of_symbol.resize(symbol_table.size(), null_term);
     }
+    assert(term_of_symbol[name] == null_term);
+    term_of_symbol[name] = t;
 
+    auto key = static_cast<std::size_t>(t.x);
+    if (key >= name_table.size())
+    {
+        name_table.resize(std::max(key + 1, 2 * name_table.size()), -1);
+    }
+    assert(name_table[key] < 0);
+    name_table[key] = name;
+}
+
+void Term_table::remove_term_name(term_t t)
+{
+    auto key = static_cast<std::size_t>(t.x);
+    if (key < name_table.size() && name_table[key] >= 0)
     {
-        auto [it, inserted] = name_table.insert({t, name});
-        assert(inserted);
-        (void)inserted;
+        term_of_symbol[name_table[key]] = null_term;
+        name_table[key] = -1;
     }
 }
 
 std::optional<std::string_view> Term_table::get_term_name(term_t t) const
 {
-    auto it = name_table.find(t);
-    return it != name_table.end() ? std::make_optional(std::string_view{it->second}) : std::nullopt;
+    auto key = static_cast<std::size_t>(t.x);
+    if (key < name_table.size() && name_table[key] >= 0)
+    {
+        return symbol_table.name(name_table[key]);
+    }
+    return std::nullopt;
+}
+
+std::optional<term_t> Term_table::get_term_by_name(std::string_view name) const
+{
+    auto symbol = symbol_table.find(name);
+    return symbol ? get_term_by_symbol(symbol.value()) : std::nullopt;
+}
+
+std::optional<term_t> Term_table::get_term_by_symbol(symbol_t symbol) const
+{
+    if (static_cast<std::size_t>(symbol) < term_of_symbol.size() &&
+        term_of_symbol[symbol] != null_term)
+    {
+        return term_of_symbol[symbol];
+    }
+    return std::nullopt;
 }
 
-std::optional<term_t> Term_table::get_term_by_name(std::string const& name) const
+std::size_t Term_table::memory_usage() const
 {
-    auto it = symbol_table.find(name);
-    return it != symbol_table.end() ? std::make_optional(it->second) : std::nullopt;
+    return inner_table.capacity() * sizeof(Term) +
+           arg_blocks.size() * arg_block_size * sizeof(term_t) +
+           arg_blocks.capacity() * sizeof(std::unique_ptr<term_t[]>) +
+           rationals.capacity() * sizeof(Rational) + known_terms.memory_usage() +
+           symbol_table.memory_usage() + term_of_symbol.capacity() * sizeof(term_t) +
+           name_table.capacity() * sizeof(symbol_t);
 }
 
 /*
@@ -231,8 +269,7 @@ bool Term_table::is_arithmetic_constant(term_t t) const
 Rational const& Term_table::arithmetic_constant_value(term_t t) const
 {
     assert(is_arithmetic_constant(t));
-    auto const& descriptor = static_cast<rational_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    return descriptor.value();
+    return rationals[this->inner_table[index_of(t)].index];
 }
 
 bool Term_table::is_uninterpreted_constant(term_t t) const
@@ -258,41 +295,34 @@ bool Term_table::is_ite(term_t t) const
 term_t Term_table::var_of_product(term_t t) const
 {
     assert(is_arithmetic_product(t));
-    auto const& descriptor = static_cast<composite_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    assert(descriptor.size() == 2);
-    return descriptor.args()[1];
+    auto args = get_args(t);
+    assert(args.size() == 2);
+    return args[1];
 }
 
 Rational const& Term_table::coeff_of_product(term_t t) const
 {
     assert(is_arithmetic_product(t));
-    auto const& descriptor = static_cast<composite_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    assert(descriptor.size() == 2);
-    return arithmetic_constant_value(descriptor.args()[0]);
+    auto args = get_args(t);
+    assert(args.size() == 2);
+    return arithmetic_constant_value(args[0]);
 }
 
 std::span<const term_t> Term_table::monomials_of(term_t t) const
 {
     assert(is_arithmetic_polynomial(t));
-    auto const& descriptor = static_cast<composite_term_descriptor_t const&>(*this->inner_table[index_of(t)].descriptor);
-    return descriptor.args();
+    return get_args(t);
 }
 
 std::span<const term_t> Term_table::get_args(term_t t) const
 {
-    auto kind = get_kind(t);
-    switch (kind)
+    // only composite terms have arguments
+    auto const& term = inner_table[index_of(t)];
+    if (term.size == 0)
     {
-    case Kind::ARITH_CONSTANT:
-    case Kind::CONSTANT_TERM:
-    case Kind::UNINTERPRETED_TERM:
         return {};
-    default:
-        term_descriptor_t const& descriptor = get_descriptor(t);
-        auto const& composite_descriptor = dynamic_cast<composite_term_descriptor_t const&>(descriptor);
-        assert(composite_descriptor.size() != 0);
-        return composite_descriptor.args();
     }
+    return {term.args, term.size};
 }
 
 } // namespace yaga::terms
\ No newline at end of file
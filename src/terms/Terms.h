@@ -4,73 +4,17 @@
 #include <memory>
 #include <optional>
 #include <span>
-#include <unordered_map>
-#include <unordered_set>
+#include <string_view>
 #include <vector>
 
 #include "Rational.h"
+#include "Stable_vector.h"
+#include "Symbol_table.h"
 #include "Term_hash_table.h"
 #include "Term_types.h"
 
 namespace yaga::terms {
 
-/**
- * Term descriptor contains additional information for different kinds of terms.
- *
- * Each kind uses a specialized subclass of this base class.
- */
-struct term_descriptor_t
-{
-    virtual ~term_descriptor_t() = default;
-};
-
-/**
- * A term descriptor for any composite term, i.e., a term with an operator and arguments.
- * It stores the arguments of the composite term.
- *
- */
-class composite_term_descriptor_t : public term_descriptor_t {
-    std::vector<term_t> m_args;
-
-    explicit composite_term_descriptor_t(std::span<term_t> args);
-
-public:
-    [[nodiscard]] std::size_t size() const noexcept { return m_args.size(); }
-    [[nodiscard]] std::span<term_t const> args() const noexcept { return m_args; }
-
-    static std::unique_ptr<composite_term_descriptor_t> make(std::span<term_t> args);
-};
-
-/**
- * A descriptor for terms representing rational numbers.
- * It stores the rational value of the corresponding term.
- */
-class rational_term_descriptor_t : public term_descriptor_t {
-    Rational m_value;
-
-    explicit rational_term_descriptor_t(Rational const& val) : m_value(val) {}
-
-public:
-    static std::unique_ptr<rational_term_descriptor_t> make(Rational const& val);
-
-    [[nodiscard]] Rational const& value() const { return m_value; }
-};
-
-/**
- * A descriptor for terms representing constant of a finite type.
- */
-class constant_term_descriptor_t : public term_descriptor_t {
-    int32_t m_index;
-
-    explicit constant_term_descriptor_t(int32_t index) : m_index(index) {}
-
-public:
-    static std::unique_ptr<constant_term_descriptor_t> make(int32_t index);
-
-    [[nodiscard]] int32_t index() const { return m_index; }
-};
-
-
 /*
  * Helper methods for simple queries on term handles
  */
@@ -120,55 +64,106 @@ inline constexpr term_t negative_term(term_t t) { return negative_term(index_of(
 /**
  * Term table is the main internal data structure for creating, storing and querying terms.
  *
- * Terms are internally stored in a table (vector). To avoid duplication, hash consing is used.
+ * Terms are internally stored in a table (`Stable_vector`). To avoid duplication, hash consing is used.
  * Term_table cooperates with Term_hash_table on creating new terms; the process goes through
  * the hash table to check if the term we want to create already exists.
  * If it does, the existing terms is returned instead of creating new one.
+ *
+ * Arguments of composite terms are stored contiguously in large blocks which are never moved, so
+ * spans returned by `get_args()` stay valid when new terms are created. Rational constants are
+ * interned: each value is stored once and referenced by its index.
+ *
+ * Terms, their arguments and rational values are never moved once they are created. Queries on
+ * existing terms can thus run in another thread while a single thread creates new terms, provided
+ * that the terms have been passed to the other thread with proper synchronization.
  */
 class Term_table {
     /**
      * Internal representation of terms.
      *
-     * It stores the kind of the term, its type and additional information in the term descriptor.
+     * It stores the kind of the term, its type and a reference to additional data of the term.
      */
     struct Term {
         Kind kind;
         type_t type;
-        std::unique_ptr<term_descriptor_t> descriptor;
+        // number of arguments of a composite term
+        uint32_t size;
+        union {
+            // arguments of a composite term (stored in `arg_blocks`)
+            term_t const* args;
+            // index of a finite constant in its type or index of a rational value in `rationals`
+            int32_t index;
+        };
     };
 
-    using inner_table_t = std::vector<Term>;
-    using symbol_table_t = std::unordered_map<std::string, term_t>;
-    using name_table_t = std::unordered_map<term_t, std::string>;
+    using inner_table_t = Stable_vector<Term>;
+
+    // number of arguments in one block of `arg_blocks`
+    static constexpr std::size_t arg_block_size = 1 << 16;
 
     // The actual storage of terms
     inner_table_t inner_table;
 
+    // Storage of arguments of composite terms
+    std::vector<std::unique_ptr<term_t[]>> arg_blocks;
+
+    // Free part of the last allocated block of arguments
+    term_t* next_arg = nullptr;
+    term_t* end_arg = nullptr;
+
+    // Values of rational constants
+    Stable_vector<Rational> rationals;
+
     // Hash table to implement hash consing
     Term_hash_table known_terms;
 
-    // Maps names to terms
-    symbol_table_t symbol_table;
+    // Interned names of terms
+    Symbol_table symbol_table;
+
+    // Maps symbols to terms (null_term if no term is associated with the symbol)
+    std::vector<term_t> term_of_symbol;
 
-    // Maps terms to their canonical names
-    name_table_t name_table;
+    // Maps term handles (`term_t::x`) to their canonical names (-1 if the term has no name)
+    std::vector<symbol_t> name_table;
 
     // Necessary initialization
     void add_primitive_terms();
 
+    /**
+     * Copy arguments of a new composite term to `arg_blocks`
+     *
+     * @param args arguments of a composite term
+     * @return pointer to the stored copy of @p args
+     */
+    term_t const* store_args(std::span<term_t const> args);
+
     // Actual construction of terms. These methods always create new terms!
     friend class Term_hash_table;
     term_t construct_composite(Kind kind, type_t type, std::span<term_t> args);
     term_t construct_rational(Kind kind, type_t type, Rational const & value);
     term_t construct_constant(Kind kind, type_t type, int32_t index);
     term_t construct_uninterpreted_constant(type_t type);
+    term_t construct(Term term);
+
+    // Index of the finite constant in its type (used by Term_hash_table)
+    int32_t constant_index(term_t t) const { return inner_table[index_of(t)].index; }
 public:
     Term_table();
 
+    /**
+     * @return Table of interned names of terms
+     */
+    Symbol_table& symbols() { return symbol_table; }
+
     /**
      * Associate a term with the given name
      */
-    void set_term_name(term_t, std::string const&);
+    void set_term_name(term_t, symbol_t);
+
+    /**
+     * Remove name associated with a term (if there is any)
+     */
+    void remove_term_name(term_t);
 
     /**
      * Get name associated with a term
@@ -182,26 +177,34 @@ public:
      *
      * @return Term associated with the name, or nothing if no term is associated with the name
      */
-    std::optional<term_t> get_term_by_name(std::string const& name) const;
+    std::optional<term_t> get_term_by_name(std::string_view name) const;
 
     /**
+     * Retrieves the term associated to the @p symbol
      *
-     * @return Kind of the given term
+     * @return Term associated with the symbol, or nothing if no term is associated with the symbol
      */
-    Kind get_kind(term_t) const;
+    std::optional<term_t> get_term_by_symbol(symbol_t symbol) const;
 
     /**
+     * Estimate memory used by terms, their arguments, values of constants, names, and the hash
+     * table used for hash consing
      *
-     * @return Type of the given term
+     * @return number of bytes allocated by this table
      */
-    type_t get_type(term_t) const;
+    std::size_t memory_usage() const;
 
     /**
      *
-     * @return The term descriptor of the given term
+     * @return Kind of the given term
      */
-    term_descriptor_t const& get_descriptor(term_t) const;
+    Kind get_kind(term_t) const;
 
+    /**
+     *
+     * @return Type of the given term
+     */
+    type_t get_type(term_t) const;
 
     /**
      * Retrieves the arguments (children) of the given term
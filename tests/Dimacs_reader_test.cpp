@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Dimacs_reader.h"
+#include "Evsids.h"
+#include "Solver.h"
+
+namespace {
+
+void init_solver(yaga::Solver& solver)
+{
+    using namespace yaga;
+
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+}
+
+}
+
+TEST_CASE("Read DIMACS formula", "[dimacs]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    init_solver(solver);
+
+    SECTION("clauses are asserted")
+    {
+        std::string input = "c comment\n"
+                            "p cnf 3 3\n"
+                            "1 -2 0\n"
+                            "  2 3\n"
+                            "-1 0 c comment\n"
+                            "-3 0";
+        auto stats = Dimacs_reader{std::string_view{input}}.read(solver);
+
+        REQUIRE(stats.num_vars == 3);
+        REQUIRE(stats.num_clauses == 3);
+        REQUIRE(!stats.has_empty_clause);
+        REQUIRE(stats.num_bytes == input.size());
+        REQUIRE(solver.trail().model<bool>(Variable::boolean).num_vars() == 3);
+        REQUIRE(solver.db().asserted().size() == 3);
+        REQUIRE(solver.db().asserted()[0] == Clause{lit(0), ~lit(1)});
+        REQUIRE(solver.db().asserted()[1] == Clause{lit(1), lit(2), ~lit(0)});
+        REQUIRE(solver.db().asserted()[2] == Clause{~lit(2)});
+        REQUIRE(solver.check() == Solver::Result::sat);
+    }
+
+    SECTION("empty clause stops reading")
+    {
+        auto stats = Dimacs_reader{std::string_view{"p cnf 2 3\n1 0\n0\n2 0\n"}}.read(solver);
+
+        REQUIRE(stats.has_empty_clause);
+        REQUIRE(solver.db().asserted().size() == 1);
+    }
+
+    SECTION("SATLIB end marker")
+    {
+        auto stats = Dimacs_reader{std::string_view{"p cnf 2 1\n1 2 0\n%\n0\n"}}.read(solver);
+
+        REQUIRE(!stats.has_empty_clause);
+        REQUIRE(solver.db().asserted().size() == 1);
+    }
+
+    SECTION("invalid inputs")
+    {
+        auto read = [&](std::string_view input) {
+            Solver other_solver;
+            init_solver(other_solver);
+            Dimacs_reader{input}.read(other_solver);
+        };
+
+        REQUIRE_THROWS_AS(read("1 2 0\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read("p cnf 2 1\np cnf 2 1\n1 0\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read("p cnf 2\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read("p dnf 2 1\n1 0\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read("p cnf 2 1\n1 3 0\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read("p cnf 2 1\n1 x 0\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read("p cnf 2 2\n1 2 0\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read("p cnf 2 1\n99999999999 0\n"), Dimacs_error);
+        REQUIRE_THROWS_AS(read(""), Dimacs_error);
+    }
+
+    SECTION("files are read the same way as memory")
+    {
+        std::string input = "p cnf 4 3\n1 -2 4 0\n-1 3 0\n2 -3 -4 0\n";
+        auto path = std::filesystem::temp_directory_path() / "yaga_dimacs_reader_test.cnf";
+        std::ofstream{path} << input;
+
+        auto stats = Dimacs_reader{path.string()}.read(solver);
+        REQUIRE(stats.num_bytes == input.size());
+        REQUIRE(solver.db().asserted().size() == 3);
+
+        // compressed input is only tested if gzip is installed
+        auto gz_path = path.string() + ".gz";
+        auto command = "gzip -c " + path.string() + " > " + gz_path + " 2> /dev/null";
+        if (std::system(command.c_str()) == 0)
+        {
+            Solver gz_solver;
+            init_solver(gz_solver);
+            auto gz_stats = Dimacs_reader{gz_path}.read(gz_solver);
+            REQUIRE(gz_stats.num_bytes == input.size());
+            REQUIRE(gz_solver.db().asserted() == solver.db().asserted());
+        }
+        std::filesystem::remove(path);
+        std::filesystem::remove(gz_path);
+    }
+
+    SECTION("missing file")
+    {
+        REQUIRE_THROWS_AS(Dimacs_reader{std::string{"/nonexistent/formula.cnf"}},
+                          std::system_error);
+    }
+}
+
+TEST_CASE("Benchmark DIMACS parsing", "[.][dimacs][bench]")
+{
+    using namespace yaga;
+
+    constexpr int num_vars = 100000;
+    constexpr int num_clauses = 1000000;
+
+    std::mt19937 rng{17};
+    std::uniform_int_distribution<int> var_dist{1, num_vars};
+    std::stringstream input_stream;
+    input_stream << "p cnf " << num_vars << " " << num_clauses << "\n";
+    for (int i = 0; i < num_clauses; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            input_stream << (rng() % 2 ? "-" : "") << var_dist(rng) << " ";
+        }
+        input_stream << "0\n";
+    }
+    auto input = input_stream.str();
+
+    {
+        Solver solver;
+        init_solver(solver);
+        auto stats = Dimacs_reader{std::string_view{input}}.read(solver);
+        std::cout << "parsed " << stats.megabytes_per_second() << " MB/s\n";
+    }
+
+    BENCHMARK("read 3-CNF from memory")
+    {
+        Solver solver;
+        init_solver(solver);
+        return Dimacs_reader{std::string_view{input}}.read(solver).num_bytes;
+    };
+}
@@ -0,0 +1,61 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Evsids.h"
+#include "Memory.h"
+#include "Restart.h"
+#include "Solver.h"
+
+TEST_CASE("Account memory of subsystems", "[memory]")
+{
+    using namespace yaga;
+
+    Memory_usage usage;
+    REQUIRE(usage.total() == 0);
+    REQUIRE(usage.bytes("clauses") == 0);
+
+    usage.add("clauses", 10);
+    usage.add("watches", 5);
+    usage.add("clauses", 20);
+    REQUIRE(usage.bytes("clauses") == 30);
+    REQUIRE(usage.bytes("watches") == 5);
+    REQUIRE(usage.total() == 35);
+    REQUIRE(usage.subsystems().size() == 2);
+
+    std::ostringstream out;
+    usage.print_json(out);
+    REQUIRE(out.str() == "{\"total\":35,\"clauses\":30,\"watches\":5}");
+
+    std::vector<std::vector<int>> lists(3);
+    lists[1].reserve(4);
+    REQUIRE(memory_of(lists) ==
+            lists.capacity() * sizeof(std::vector<int>) + lists[1].capacity() * sizeof(int));
+
+    REQUIRE(resident_memory() > 0);
+}
+
+TEST_CASE("Account memory used by a solver", "[memory][integration]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    solver.trail().set_model<bool>(Variable::boolean, 3);
+    solver.db().assert_clause(lit(0), lit(1), lit(2));
+    solver.db().assert_clause(~lit(0), lit(1));
+    REQUIRE(solver.check() == Solver::Result::sat);
+
+    auto usage = solver.memory_usage();
+    REQUIRE(usage.bytes("database.asserted") >= 5 * sizeof(Literal));
+    REQUIRE(usage.bytes("bool_theory.watches") >= 4 * sizeof(void*));
+    REQUIRE(usage.bytes("trail") > 0);
+    REQUIRE(usage.total() >= usage.bytes("database.asserted") + usage.bytes("trail"));
+}
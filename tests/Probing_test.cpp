@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Event_dispatcher.h"
+#include "Evsids.h"
+#include "Probing.h"
+#include "Restart.h"
+#include "Solver.h"
+
+TEST_CASE("Probe literals at decision level 0", "[probing]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Bool_theory theory;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&theory);
+    Trail trail{dispatcher};
+    auto& model = trail.set_model<bool>(Variable::boolean, 5);
+    theory.on_variable_resize(Variable::boolean, 5);
+
+    Database db;
+    Probing probing;
+
+    SECTION("failed literal")
+    {
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(~lit(0), lit(2));
+        db.assert_clause(~lit(1), ~lit(2), lit(3));
+        db.assert_clause(~lit(3), ~lit(0));
+
+        REQUIRE(probing.run(db, trail, theory, dispatcher, 1000));
+        REQUIRE(probing.num_failed() == 1);
+        REQUIRE(trail.decision_level() == 0);
+        REQUIRE(eval(model, ~lit(0)) == true);
+        REQUIRE(std::find(db.learned().begin(), db.learned().end(), clause(~lit(0))) !=
+                db.learned().end());
+    }
+
+    SECTION("literal implied by both polarities")
+    {
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(lit(0), lit(2));
+        db.assert_clause(~lit(1), lit(3));
+        db.assert_clause(~lit(2), lit(3));
+
+        REQUIRE(probing.run(db, trail, theory, dispatcher, 1000));
+        REQUIRE(probing.num_implied() > 0);
+        REQUIRE(eval(model, lit(3)) == true);
+        REQUIRE(trail.decision_level(bool_var(3)) == 0);
+    }
+
+    SECTION("equivalent literals are substituted")
+    {
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(~lit(1), lit(2));
+        db.assert_clause(~lit(2), lit(0));
+        db.assert_clause(~lit(1), lit(3), lit(4));
+        db.assert_clause(lit(2), ~lit(3), ~lit(4));
+        db.assert_clause(lit(1), ~lit(2), lit(3));
+
+        REQUIRE(probing.run(db, trail, theory, dispatcher, 1000));
+        REQUIRE(probing.num_substituted() == 2);
+
+        // the cycle is kept and other clauses only use the representative
+        auto sorted = [&](int index) {
+            auto result = db.asserted()[index];
+            std::sort(result.begin(), result.end(), Literal_comparer{});
+            return result;
+        };
+        REQUIRE(db.asserted().size() == 5);
+        REQUIRE(sorted(3) == clause(~lit(0), lit(3), lit(4)));
+        REQUIRE(sorted(4) == clause(lit(0), ~lit(3), ~lit(4)));
+
+        // the equivalences are not counted again
+        REQUIRE(probing.run(db, trail, theory, dispatcher, 1000));
+        REQUIRE(probing.num_substituted() == 2);
+    }
+
+    SECTION("literal equivalent to its negation")
+    {
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(~lit(1), ~lit(0));
+        db.assert_clause(lit(0), lit(2));
+        db.assert_clause(~lit(2), lit(0));
+
+        REQUIRE(!probing.run(db, trail, theory, dispatcher, 1000));
+    }
+
+    SECTION("budget limits the number of probes")
+    {
+        for (int i = 0; i + 1 < 5; ++i)
+        {
+            db.assert_clause(~lit(i), lit(i + 1), lit(4));
+            db.assert_clause(lit(i), ~lit(i + 1));
+        }
+
+        // only the first variable is probed (both of its literals propagate at most 5 variables)
+        REQUIRE(probing.run(db, trail, theory, dispatcher, 1));
+        REQUIRE(probing.num_propagations() <= 10);
+    }
+}
+
+TEST_CASE("Probing does not change answers of the solver", "[probing]")
+{
+    using namespace yaga;
+
+    std::mt19937 rng{7};
+    for (int round = 0; round < 100; ++round)
+    {
+        int num_vars = 10 + static_cast<int>(rng() % 30);
+        int num_clauses = num_vars * 3 + static_cast<int>(rng() % num_vars);
+        std::deque<Clause> clauses;
+        for (int i = 0; i < num_clauses; ++i)
+        {
+            auto& clause = clauses.emplace_back();
+            int size = 2 + static_cast<int>(rng() % 3 == 0);
+            for (int j = 0; j < size; ++j)
+            {
+                Literal lit{static_cast<int>(rng() % num_vars)};
+                clause.push_back(rng() % 2 ? ~lit : lit);
+            }
+        }
+
+        auto check = [&](bool probe) {
+            Solver solver;
+            solver.set_theory<Bool_theory>();
+            solver.set_variable_order<Evsids>();
+            solver.set_restart_policy<Luby_restart>();
+            auto& model = solver.trail().set_model<bool>(Variable::boolean, num_vars);
+            for (auto const& clause : clauses)
+            {
+                solver.db().assert_clause(clause);
+            }
+
+            if (probe)
+            {
+                auto& probing = solver.enable_probing();
+                probing.set_interval(1);
+                probing.set_preprocess_budget(20);
+                probing.set_inprocess_budget(20);
+            }
+
+            auto result = solver.check();
+            if (result == Solver::Result::sat)
+            {
+                REQUIRE(std::all_of(clauses.begin(), clauses.end(), [&](auto const& clause) {
+                    return eval(model, clause) == true;
+                }));
+            }
+            return result;
+        };
+
+        REQUIRE(check(true) == check(false));
+    }
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Database.h"
+#include "Evsids.h"
+#include "Model.h"
+#include "Sat_preprocessor.h"
+#include "Solver.h"
+
+namespace {
+
+bool satisfies(yaga::Model<bool> const& model, std::deque<yaga::Clause> const& clauses)
+{
+    return std::all_of(clauses.begin(), clauses.end(), [&](auto const& clause) {
+        return yaga::eval(model, clause) == true;
+    });
+}
+
+}
+
+TEST_CASE("Simplify asserted clauses", "[sat_preprocessor]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Sat_preprocessor preprocessor;
+
+    SECTION("subsumed clauses are removed")
+    {
+        db.assert_clause(lit(0), lit(1));
+        db.assert_clause(lit(0), lit(1), lit(2));
+        db.assert_clause(lit(0), lit(2), lit(1), lit(3));
+        db.assert_clause(~lit(0), lit(2), lit(3));
+        db.assert_clause(~lit(1), ~lit(2), ~lit(3));
+        db.assert_clause(lit(2), ~lit(3), lit(1));
+        db.assert_clause(~lit(2), lit(3), ~lit(0));
+
+        REQUIRE(preprocessor.simplify(db, 4));
+        REQUIRE(preprocessor.num_subsumed() >= 2);
+        REQUIRE(preprocessor.num_clauses_before() == 7);
+        REQUIRE(preprocessor.num_clauses_after() == db.asserted().size());
+        REQUIRE(db.asserted().size() <= 5);
+    }
+
+    SECTION("self-subsuming resolution strengthens clauses")
+    {
+        db.assert_clause(lit(0), lit(1), lit(2));
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(lit(2), lit(3), lit(0));
+        db.assert_clause(~lit(2), ~lit(3), ~lit(1));
+        db.assert_clause(~lit(1), lit(3), lit(0));
+
+        REQUIRE(preprocessor.simplify(db, 4));
+        REQUIRE(preprocessor.num_strengthened() > 0);
+    }
+
+    SECTION("units are propagated")
+    {
+        db.assert_clause(lit(0));
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(~lit(1), lit(2), lit(3));
+        db.assert_clause(lit(0), lit(3));
+
+        REQUIRE(preprocessor.simplify(db, 4));
+        // fixed variables only occur in unit clauses
+        for (auto const& clause : db.asserted())
+        {
+            REQUIRE((clause.size() == 1 ||
+                     std::none_of(clause.begin(), clause.end(),
+                                  [](auto lit) { return lit.var().ord() <= 1; })));
+        }
+    }
+
+    SECTION("tautologies and duplicate literals are removed")
+    {
+        db.assert_clause(lit(0), ~lit(0), lit(1));
+        db.assert_clause(lit(1), lit(2), lit(1));
+
+        REQUIRE(preprocessor.simplify(db, 3));
+        REQUIRE(std::all_of(db.asserted().begin(), db.asserted().end(),
+                            [](auto const& clause) { return clause.size() <= 2; }));
+    }
+
+    SECTION("eliminated variables are reconstructed")
+    {
+        db.assert_clause(lit(0), lit(1));
+        db.assert_clause(~lit(0), lit(2));
+        db.assert_clause(~lit(1), ~lit(2), lit(3));
+        db.assert_clause(~lit(3), lit(1));
+        std::deque<Clause> original = db.asserted();
+
+        REQUIRE(preprocessor.simplify(db, 4));
+        REQUIRE(preprocessor.num_eliminated() > 0);
+
+        // any model of the simplified clauses can be extended
+        for (int bits = 0; bits < 16; ++bits)
+        {
+            Model<bool> model;
+            model.resize(4);
+            for (int i = 0; i < 4; ++i)
+            {
+                model.set_value(i, (bits >> i) & 1);
+            }
+
+            if (satisfies(model, db.asserted()))
+            {
+                preprocessor.extend(model);
+                REQUIRE(satisfies(model, original));
+            }
+        }
+    }
+
+    SECTION("conflicting units")
+    {
+        db.assert_clause(lit(0), lit(1));
+        db.assert_clause(lit(0), ~lit(1));
+        db.assert_clause(~lit(0), lit(1));
+        db.assert_clause(~lit(0), ~lit(1));
+
+        REQUIRE(!preprocessor.simplify(db, 2));
+        REQUIRE(db.asserted().size() == 4);
+    }
+}
+
+TEST_CASE("Preprocessed random formulas have the same answer", "[sat_preprocessor]")
+{
+    using namespace yaga;
+
+    std::mt19937 rng{42};
+    for (int round = 0; round < 100; ++round)
+    {
+        int num_vars = 5 + static_cast<int>(rng() % 20);
+        int num_clauses = num_vars * 4 + static_cast<int>(rng() % 10);
+        std::deque<Clause> clauses;
+        for (int i = 0; i < num_clauses; ++i)
+        {
+            auto& clause = clauses.emplace_back();
+            int size = 1 + static_cast<int>(rng() % 4);
+            for (int j = 0; j < size; ++j)
+            {
+                Literal lit{static_cast<int>(rng() % num_vars)};
+                clause.push_back(rng() % 2 ? ~lit : lit);
+            }
+        }
+
+        auto check = [&](bool preprocess) {
+            Solver solver;
+            solver.set_theory<Bool_theory>();
+            solver.set_variable_order<Evsids>();
+            solver.set_restart_policy<No_restart>();
+            solver.trail().set_model<bool>(Variable::boolean, num_vars);
+            for (auto const& clause : clauses)
+            {
+                solver.db().assert_clause(clause);
+            }
+
+            Sat_preprocessor preprocessor;
+            if (preprocess && !preprocessor.simplify(solver.db(), num_vars))
+            {
+                return Solver::Result::unsat;
+            }
+
+            auto result = solver.check();
+            if (result == Solver::Result::sat)
+            {
+                auto& model = solver.trail().model<bool>(Variable::boolean);
+                preprocessor.extend(model);
+                REQUIRE(satisfies(model, clauses));
+            }
+            return result;
+        };
+
+        REQUIRE(check(true) == check(false));
+    }
+}
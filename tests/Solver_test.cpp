@@ -1,4 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
 
 #include "test.h"
 #include "Solver.h"
@@ -57,4 +63,262 @@ TEST_CASE("Check an unsatisfiable boolean formula", "[unsat][integration]")
 
     auto result = solver.check();
     REQUIRE(result == Solver::Result::unsat);
-}
\ No newline at end of file
+}
+TEST_CASE("Check a boolean formula under assumptions", "[sat][unsat][integration]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    solver.trail().set_model<bool>(Variable::boolean, 5);
+    auto [a, b, c, d, e] = std::array{lit(0), lit(1), lit(2), lit(3), lit(4)};
+    solver.db().assert_clause(a, b);
+    solver.db().assert_clause(~a, c);
+    solver.db().assert_clause(~b, c);
+    solver.db().assert_clause(d, e);
+
+    auto const& model = solver.trail().model<bool>(Variable::boolean);
+    auto contains = [](auto const& lits, Literal lit) {
+        return std::find(lits.begin(), lits.end(), lit) != lits.end();
+    };
+
+    std::array assumptions{~e, ~c};
+    REQUIRE(solver.check(assumptions) == Solver::Result::unsat);
+    REQUIRE(contains(solver.failed_assumptions(), ~c));
+    REQUIRE(!contains(solver.failed_assumptions(), ~e));
+
+    assumptions = {~e, ~a};
+    REQUIRE(solver.check(assumptions) == Solver::Result::sat);
+    REQUIRE(solver.failed_assumptions().empty());
+    REQUIRE(eval(model, a) == false);
+    REQUIRE(eval(model, b) == true);
+    REQUIRE(eval(model, c) == true);
+    REQUIRE(eval(model, d) == true);
+    REQUIRE(eval(model, e) == false);
+
+    assumptions = {d, ~d};
+    REQUIRE(solver.check(assumptions) == Solver::Result::unsat);
+    REQUIRE(contains(solver.failed_assumptions(), d));
+    REQUIRE(contains(solver.failed_assumptions(), ~d));
+
+    // add clauses between checks
+    REQUIRE(solver.check() == Solver::Result::sat);
+    solver.db().assert_clause(~c);
+    REQUIRE(solver.check(std::array{d}) == Solver::Result::unsat);
+    REQUIRE(solver.failed_assumptions().empty());
+}
+
+TEST_CASE("Minimize failed assumptions", "[unsat][integration]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    solver.trail().set_model<bool>(Variable::boolean, 7);
+    auto [s0, s1, s2, x, p, q, a] = std::array{lit(0), lit(1), lit(2), lit(3), lit(4), lit(5), 
+                                               lit(6)};
+    // s0 and s1 imply ~s2 by unit propagation
+    solver.db().assert_clause(~s0, ~s1, x);
+    solver.db().assert_clause(~x, ~s2);
+    // s0 alone implies ~s2 as well but not by unit propagation
+    solver.db().assert_clause(~s0, p, q);
+    solver.db().assert_clause(~p, ~s2);
+    solver.db().assert_clause(~q, ~s2);
+
+    auto sorted = [](std::vector<Literal> lits) {
+        std::sort(lits.begin(), lits.end());
+        return lits;
+    };
+
+    SECTION("without fixed assumptions")
+    {
+        REQUIRE(solver.check(std::array{s0, s1, s2}) == Solver::Result::unsat);
+        REQUIRE(sorted(solver.failed_assumptions()) == std::vector{s0, s1, s2});
+
+        auto const& core = solver.minimize_failed_assumptions({});
+        REQUIRE(sorted(core) == std::vector{s0, s2});
+        REQUIRE(sorted(solver.failed_assumptions()) == std::vector{s0, s2});
+    }
+
+    SECTION("with fixed assumptions")
+    {
+        solver.db().assert_clause(~a, s0);
+
+        std::array fixed{a};
+        REQUIRE(solver.check(std::array{a, s1, s2}) == Solver::Result::unsat);
+        REQUIRE(sorted(solver.minimize_failed_assumptions(fixed)) == std::vector{s2});
+    }
+}
+
+TEST_CASE("Stop check if the budget is exhausted", "[unsat][integration]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    // pigeonhole principle: 7 pigeons cannot be placed in 6 holes
+    constexpr int num_pigeons = 7;
+    constexpr int num_holes = 6;
+    auto var = [&](int pigeon, int hole) { return lit(pigeon * num_holes + hole); };
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    solver.trail().set_model<bool>(Variable::boolean, num_pigeons * num_holes);
+    for (int pigeon = 0; pigeon < num_pigeons; ++pigeon)
+    {
+        auto& clause = solver.db().assert_clause();
+        for (int hole = 0; hole < num_holes; ++hole)
+        {
+            clause.push_back(var(pigeon, hole));
+        }
+    }
+
+    for (int hole = 0; hole < num_holes; ++hole)
+    {
+        for (int i = 0; i < num_pigeons; ++i)
+        {
+            for (int j = i + 1; j < num_pigeons; ++j)
+            {
+                solver.db().assert_clause(~var(i, hole), ~var(j, hole));
+            }
+        }
+    }
+
+    SECTION("conflict limit")
+    {
+        solver.set_budget(Solver::Budget{.conflicts = 10});
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.num_conflicts() == 10);
+
+        // the limit applies to each check
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.num_conflicts() == 10);
+
+        solver.set_budget(Solver::Budget{});
+        REQUIRE(solver.check() == Solver::Result::unsat);
+    }
+
+    SECTION("propagation limit")
+    {
+        solver.set_budget(Solver::Budget{.propagations = 1});
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.num_conflicts() < 10);
+    }
+
+    SECTION("interrupt before check")
+    {
+        solver.interrupt();
+        REQUIRE(solver.check() == Solver::Result::unknown);
+        REQUIRE(solver.num_decisions() == 0);
+
+        // the request is cleared
+        REQUIRE(solver.check() == Solver::Result::unsat);
+    }
+
+    SECTION("memory limit")
+    {
+        // the test process alone uses more than 1 MB
+        solver.set_budget(Solver::Budget{.memory = 1});
+        REQUIRE(solver.check() == Solver::Result::unknown);
+    }
+}
+
+TEST_CASE("Benchmark minimization of failed assumptions", "[.][unsat][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    constexpr int num_vars = 50;
+    constexpr int num_clauses = 250;
+
+    // random 3-SAT formula where each clause is guarded by a selector literal
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> var_dist{0, num_vars - 1};
+    std::vector<std::vector<Literal>> clauses;
+    for (int i = 0; i < num_clauses; ++i)
+    {
+        auto& clause = clauses.emplace_back();
+        for (int j = 0; j < 3; ++j)
+        {
+            clause.push_back(rng() % 2 ? lit(var_dist(rng)) : ~lit(var_dist(rng)));
+        }
+    }
+
+    auto make_solver = [&](Solver& solver) {
+        solver.set_theory<Bool_theory>();
+        solver.set_variable_order<Evsids>();
+        solver.set_restart_policy<Luby_restart>();
+        solver.trail().set_model<bool>(Variable::boolean, num_vars + num_clauses);
+    };
+
+    // assumption i selects clause i
+    std::vector<Literal> selectors;
+    for (int i = 0; i < num_clauses; ++i)
+    {
+        selectors.push_back(lit(num_vars + i));
+    }
+
+    BENCHMARK("incremental minimization")
+    {
+        Solver solver;
+        make_solver(solver);
+        for (int i = 0; i < num_clauses; ++i)
+        {
+            auto clause = clauses[i];
+            clause.push_back(~selectors[i]);
+            solver.db().assert_clause(std::move(clause));
+        }
+        solver.check(selectors);
+        return solver.minimize_failed_assumptions({}).size();
+    };
+
+    BENCHMARK("deletion with a new solver for each subset")
+    {
+        Solver solver;
+        make_solver(solver);
+        for (int i = 0; i < num_clauses; ++i)
+        {
+            auto clause = clauses[i];
+            clause.push_back(~selectors[i]);
+            solver.db().assert_clause(std::move(clause));
+        }
+        solver.check(selectors);
+
+        // indices of clauses in the core
+        std::vector<int> core;
+        for (auto lit : solver.failed_assumptions())
+        {
+            core.push_back(lit.var().ord() - num_vars);
+        }
+
+        for (std::size_t i = 0; i < core.size();)
+        {
+            Solver subset_solver;
+            make_solver(subset_solver);
+            for (std::size_t j = 0; j < core.size(); ++j)
+            {
+                if (j != i)
+                {
+                    subset_solver.db().assert_clause(Clause{clauses[core[j]]});
+                }
+            }
+
+            if (subset_solver.check() == Solver::Result::unsat)
+            {
+                core.erase(core.begin() + i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        return core.size();
+    };
+}
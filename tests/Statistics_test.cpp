@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Evsids.h"
+#include "Restart.h"
+#include "Solver.h"
+#include "Statistics.h"
+
+TEST_CASE("Record statistics in a registry", "[statistics]")
+{
+    using namespace yaga;
+
+    Statistics stats;
+    // expected value of a statistic which is only recorded if statistics are compiled in
+    auto expected = [](std::uint64_t value) -> std::uint64_t {
+        return statistics_enabled ? value : 0;
+    };
+
+    SECTION("counters")
+    {
+        auto& counter = stats.counter("counter");
+        counter.add();
+        counter.add(41);
+        REQUIRE(counter.value() == expected(42));
+        REQUIRE(&stats.counter("counter") == &counter);
+
+        stats.reset();
+        REQUIRE(counter.value() == 0);
+    }
+
+    SECTION("timers")
+    {
+        auto& timer = stats.timer("timer");
+        for (int i = 0; i < 3; ++i)
+        {
+            Scoped_timer scope{timer};
+        }
+        timer.add(std::chrono::seconds{1});
+        REQUIRE(timer.calls() == expected(4));
+        REQUIRE(timer.total() >= (statistics_enabled ? std::chrono::seconds{1}
+                                                     : std::chrono::seconds{0}));
+    }
+
+    SECTION("histograms")
+    {
+        auto& histogram = stats.histogram("histogram");
+        for (std::uint64_t value : {0, 1, 2, 3, 4, 7, 8})
+        {
+            histogram.record(value);
+        }
+        REQUIRE(histogram.count() == expected(7));
+        REQUIRE(histogram.sum() == expected(25));
+        REQUIRE(histogram.min() == 0);
+        REQUIRE(histogram.max() == expected(8));
+        REQUIRE(histogram.bucket(0) == expected(1));
+        REQUIRE(histogram.bucket(1) == expected(1));
+        REQUIRE(histogram.bucket(2) == expected(2));
+        REQUIRE(histogram.bucket(3) == expected(2));
+        REQUIRE(histogram.bucket(4) == expected(1));
+    }
+
+    SECTION("JSON output")
+    {
+        stats.counter("a.b").add(3);
+        stats.timer("t").add(std::chrono::milliseconds{500});
+        stats.histogram("h").record(5);
+
+        std::stringstream out;
+        stats.print_json(out);
+        if constexpr (statistics_enabled)
+        {
+            REQUIRE(out.str() == "{\"counters\":{\"a.b\":3},"
+                                 "\"timers\":{\"t\":{\"seconds\":0.5,\"calls\":1}},"
+                                 "\"histograms\":{\"h\":{\"count\":1,\"sum\":5,\"min\":5,"
+                                 "\"max\":5,\"mean\":5,\"buckets\":[[4,7,1]]}}}");
+        }
+        else
+        {
+            REQUIRE(out.str() == "{\"counters\":{},\"timers\":{},\"histograms\":{}}");
+        }
+    }
+}
+
+TEST_CASE("Solver records statistics of learned clauses", "[statistics]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    auto& stats = Statistics::global();
+    stats.reset();
+
+    // pigeonhole principle with 4 pigeons and 3 holes
+    int const num_pigeons = 4;
+    int const num_holes = 3;
+    auto var = [&](int pigeon, int hole) { return lit(pigeon * num_holes + hole); };
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    solver.trail().set_model<bool>(Variable::boolean, num_pigeons * num_holes);
+    for (int pigeon = 0; pigeon < num_pigeons; ++pigeon)
+    {
+        Clause clause;
+        for (int hole = 0; hole < num_holes; ++hole)
+        {
+            clause.push_back(var(pigeon, hole));
+        }
+        solver.db().assert_clause(std::move(clause));
+    }
+
+    for (int hole = 0; hole < num_holes; ++hole)
+    {
+        for (int first = 0; first < num_pigeons; ++first)
+        {
+            for (int second = first + 1; second < num_pigeons; ++second)
+            {
+                solver.db().assert_clause(~var(first, hole), ~var(second, hole));
+            }
+        }
+    }
+
+    REQUIRE(solver.check() == Solver::Result::unsat);
+    REQUIRE(solver.num_learned_clauses() > 0);
+    if constexpr (statistics_enabled)
+    {
+        auto num_learned = static_cast<std::uint64_t>(solver.num_learned_clauses());
+        REQUIRE(stats.histogram("learned.size").count() == num_learned);
+        REQUIRE(stats.histogram("learned.lbd").count() == num_learned);
+        REQUIRE(stats.histogram("learned.lbd").max() <= stats.histogram("learned.size").max());
+        REQUIRE(stats.histogram("conflict.trail_size").min() > 0);
+        REQUIRE(stats.histogram("conflict.backjump_distance").min() >= 1);
+        REQUIRE(stats.timer("bool_theory.propagate").calls() > 0);
+        REQUIRE(stats.timer("conflict_analysis").calls() ==
+                static_cast<std::uint64_t>(solver.num_conflicts()));
+        REQUIRE(stats.counter("bool_theory.propagations").value() > 0);
+    }
+}
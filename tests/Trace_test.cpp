@@ -0,0 +1,166 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Evsids.h"
+#include "Restart.h"
+#include "Solver.h"
+#include "Trace.h"
+
+TEST_CASE("Record events in a ring buffer", "[trace]")
+{
+    using namespace yaga;
+
+    Tracer tracer;
+    tracer.record(Trace_event::check, Tracer::Phase::begin);
+    REQUIRE(tracer.records().empty());
+
+    if constexpr (!tracing_enabled)
+    {
+        tracer.enable(4);
+        tracer.record(Trace_event::check, Tracer::Phase::begin);
+        REQUIRE(!tracer.is_enabled());
+        REQUIRE(tracer.records().empty());
+        return;
+    }
+
+    tracer.enable(3); // rounded up to 4
+    REQUIRE(tracer.is_enabled());
+
+    SECTION("events are ordered from the oldest")
+    {
+        tracer.record(Trace_event::propagate, Tracer::Phase::begin, 2);
+        tracer.record(Trace_event::propagate, Tracer::Phase::end);
+        auto records = tracer.records();
+        REQUIRE(records.size() == 2);
+        REQUIRE(records[0].event == Trace_event::propagate);
+        REQUIRE(records[0].phase == Tracer::Phase::begin);
+        REQUIRE(records[0].arg == 2);
+        REQUIRE(records[1].phase == Tracer::Phase::end);
+        REQUIRE(records[0].time <= records[1].time);
+        REQUIRE(tracer.num_dropped() == 0);
+    }
+
+    SECTION("the oldest events are overwritten")
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            tracer.record(Trace_event::decide, Tracer::Phase::begin, i);
+        }
+        auto records = tracer.records();
+        REQUIRE(records.size() == 4);
+        REQUIRE(records.front().arg == 2);
+        REQUIRE(records.back().arg == 5);
+        REQUIRE(tracer.num_dropped() == 2);
+    }
+
+    SECTION("disabled tracer does not record events")
+    {
+        tracer.disable();
+        tracer.record(Trace_event::decide, Tracer::Phase::begin);
+        REQUIRE(tracer.records().empty());
+    }
+
+    SECTION("Chrome JSON skips end events without a begin")
+    {
+        tracer.record(Trace_event::check, Tracer::Phase::begin);
+        tracer.record(Trace_event::restart, Tracer::Phase::begin, 7);
+        tracer.record(Trace_event::restart, Tracer::Phase::end);
+        tracer.record(Trace_event::check, Tracer::Phase::end);
+        tracer.record(Trace_event::learn, Tracer::Phase::begin, 1);
+
+        // the first event is overwritten
+        std::stringstream out;
+        tracer.write_chrome_json(out);
+        auto json = out.str();
+        REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+        REQUIRE(json.find("\"name\":\"check\"") == std::string::npos);
+        REQUIRE(json.find("\"name\":\"restart\",\"cat\":\"yaga\",\"ph\":\"B\"") !=
+                std::string::npos);
+        REQUIRE(json.find("\"args\":{\"restarts\":7}") != std::string::npos);
+        REQUIRE(json.find("\"args\":{\"clauses\":1}") != std::string::npos);
+        REQUIRE(std::count(json.begin(), json.end(), '\n') == 3);
+    }
+
+    SECTION("binary format")
+    {
+        tracer.record(Trace_event::learn, Tracer::Phase::begin, 3);
+
+        std::stringstream out;
+        tracer.write_binary(out);
+        auto data = out.str();
+        REQUIRE(data.size() == 8 + 2 * sizeof(std::uint64_t) + sizeof(Tracer::Record));
+        REQUIRE(data.starts_with("YAGATRC1"));
+
+        std::uint64_t num_events = 0;
+        std::memcpy(&num_events, data.data() + 8, sizeof(num_events));
+        REQUIRE(num_events == 1);
+
+        Tracer::Record record;
+        std::memcpy(&record, data.data() + 8 + 2 * sizeof(std::uint64_t), sizeof(record));
+        REQUIRE(record.event == Trace_event::learn);
+        REQUIRE(record.arg == 3);
+    }
+}
+
+TEST_CASE("Trace phases of the solver", "[trace]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Solver solver;
+    solver.set_theory<Bool_theory>();
+    solver.set_variable_order<Evsids>();
+    solver.set_restart_policy<No_restart>();
+    solver.trail().set_model<bool>(Variable::boolean, 3);
+    solver.db().assert_clause(lit(0), lit(1));
+    solver.db().assert_clause(lit(0), ~lit(1));
+    solver.db().assert_clause(~lit(0), lit(2));
+    solver.db().assert_clause(~lit(0), ~lit(2));
+
+    auto& tracer = Tracer::global();
+    tracer.enable(1 << 10);
+    auto result = solver.check();
+    tracer.disable();
+    REQUIRE(result == Solver::Result::unsat);
+
+    auto records = tracer.records();
+    if constexpr (tracing_enabled)
+    {
+        REQUIRE(records.front().event == Trace_event::check);
+        REQUIRE(records.back().event == Trace_event::check);
+        for (auto event : {Trace_event::on_init, Trace_event::propagate, Trace_event::decide,
+                           Trace_event::analyze, Trace_event::learn, Trace_event::backtrack,
+                           Trace_event::on_learned_clause, Trace_event::on_conflict_resolved})
+        {
+            REQUIRE(std::any_of(records.begin(), records.end(),
+                                [&](auto const& record) { return record.event == event; }));
+        }
+
+        // scopes are properly nested
+        std::vector<Trace_event> stack;
+        for (auto const& record : records)
+        {
+            if (record.phase == Tracer::Phase::begin)
+            {
+                stack.push_back(record.event);
+            }
+            else
+            {
+                REQUIRE(!stack.empty());
+                REQUIRE(stack.back() == record.event);
+                stack.pop_back();
+            }
+        }
+        REQUIRE(stack.empty());
+    }
+    else
+    {
+        REQUIRE(records.empty());
+    }
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+#include "test.h"
+#include "Bool_theory.h"
+#include "Event_dispatcher.h"
+#include "Evsids.h"
+#include "Restart.h"
+#include "Solver.h"
+#include "Vivification.h"
+
+TEST_CASE("Vivify learned clauses", "[vivification]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Bool_theory theory;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&theory);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 6);
+    theory.on_variable_resize(Variable::boolean, 6);
+
+    Database db;
+    Vivification vivification;
+    vivification.reset();
+
+    // propagation can reorder literals in clauses
+    auto same = [](Clause const& lhs, Clause const& rhs) {
+        return std::is_permutation(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    };
+
+    auto learn = [&](Clause&& clause, int lbd = 1) -> Clause& {
+        auto& learned = db.learn_clause(std::move(clause));
+        vivification.add_candidate(learned, lbd);
+        return learned;
+    };
+
+    SECTION("implied literal")
+    {
+        db.assert_clause(lit(0), lit(1));
+        auto& learned = learn(clause(lit(0), lit(1), lit(2)));
+
+        REQUIRE(vivification.run(db, trail, theory, dispatcher));
+        REQUIRE(same(learned, clause(lit(0), lit(1))));
+        REQUIRE(vivification.num_vivified() == 1);
+        REQUIRE(vivification.num_removed() == 1);
+        REQUIRE(trail.empty());
+    }
+
+    SECTION("conflict")
+    {
+        db.assert_clause(lit(0), ~lit(3));
+        db.assert_clause(lit(0), lit(3));
+        auto& learned = learn(clause(lit(0), lit(1), lit(2)));
+
+        REQUIRE(vivification.run(db, trail, theory, dispatcher));
+        REQUIRE(same(learned, clause(lit(0))));
+        REQUIRE(vivification.num_removed() == 2);
+    }
+
+    SECTION("false literals are removed")
+    {
+        db.assert_clause(lit(0), ~lit(1));
+        auto& learned = learn(clause(lit(0), lit(1), lit(2)));
+
+        REQUIRE(vivification.run(db, trail, theory, dispatcher));
+        REQUIRE(same(learned, clause(lit(0), lit(2))));
+    }
+
+    SECTION("irreducible clause")
+    {
+        db.assert_clause(lit(3), lit(4));
+        auto& learned = learn(clause(lit(0), lit(1), lit(2)));
+
+        REQUIRE(vivification.run(db, trail, theory, dispatcher));
+        REQUIRE(same(learned, clause(lit(0), lit(1), lit(2))));
+        REQUIRE(vivification.num_vivified() == 0);
+    }
+
+    SECTION("clauses with lower LBD are vivified first")
+    {
+        db.assert_clause(lit(0), lit(1));
+        db.assert_clause(lit(3), lit(4));
+
+        auto& high_lbd = learn(clause(lit(3), lit(4), lit(5)), 3);
+        auto& low_lbd = learn(clause(lit(0), lit(1), lit(2)), 1);
+
+        // the budget is exhausted after the first clause
+        vivification.set_budget(1);
+        REQUIRE(vivification.run(db, trail, theory, dispatcher));
+        REQUIRE(same(low_lbd, clause(lit(0), lit(1))));
+        REQUIRE(same(high_lbd, clause(lit(3), lit(4), lit(5))));
+
+        // candidates are forgotten after each run
+        REQUIRE(vivification.run(db, trail, theory, dispatcher));
+        REQUIRE(same(high_lbd, clause(lit(3), lit(4), lit(5))));
+    }
+}
+
+TEST_CASE("Vivification does not change answers of the solver", "[vivification]")
+{
+    using namespace yaga;
+
+    std::mt19937 rng{11};
+    for (int round = 0; round < 50; ++round)
+    {
+        int num_vars = 40 + static_cast<int>(rng() % 40);
+        int num_clauses = num_vars * 4 + static_cast<int>(rng() % num_vars);
+        std::deque<Clause> clauses;
+        for (int i = 0; i < num_clauses; ++i)
+        {
+            auto& clause = clauses.emplace_back();
+            for (int j = 0; j < 3; ++j)
+            {
+                Literal lit{static_cast<int>(rng() % num_vars)};
+                clause.push_back(rng() % 2 ? ~lit : lit);
+            }
+        }
+
+        auto check = [&](bool vivify) {
+            Solver solver;
+            solver.set_theory<Bool_theory>();
+            solver.set_variable_order<Evsids>();
+            solver.set_restart_policy<Glucose_restart>().set_min_conflicts(5);
+            auto& model = solver.trail().set_model<bool>(Variable::boolean, num_vars);
+            for (auto const& clause : clauses)
+            {
+                solver.db().assert_clause(clause);
+            }
+
+            if (vivify)
+            {
+                solver.enable_vivification().set_time_ratio(1.0);
+            }
+
+            auto result = solver.check();
+            if (result == Solver::Result::sat)
+            {
+                REQUIRE(std::all_of(clauses.begin(), clauses.end(), [&](auto const& clause) {
+                    return eval(model, clause) == true;
+                }));
+            }
+            return result;
+        };
+
+        REQUIRE(check(true) == check(false));
+    }
+}
@@ -16,6 +16,8 @@ TEST_CASE("Arithmetic operations with fractions", "[fraction]")
         REQUIRE(0_r == 0_r / 6);
         REQUIRE(0_r == 0_r / 5);
         REQUIRE(0_r / 3 == 0_r / 5);
+        REQUIRE(Rational{-6, 4} == -3_r / 2);
+        REQUIRE(Rational{std::numeric_limits<int>::lowest(), 2147483648u} == -1_r);
     }
 
     SECTION("Add fractions")
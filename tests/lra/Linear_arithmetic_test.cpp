@@ -1,6 +1,13 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
 #include "Clause.h"
 #include "Linear_arithmetic.h"
 #include "Literal.h"
@@ -252,6 +259,47 @@ TEST_CASE("Compute bounds correctly after backtracking", "[linear_arithmetic]")
     REQUIRE(bounds_x.upper_bound(models)->value() == 12);
 }
 
+TEST_CASE("Evaluate constraints correctly after backtracking a real variable", "[linear_arithmetic]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto models = lra.relevant_models(trail);
+    auto linear = factory(lra, trail);
+    auto [x, y, z] = real_vars<3>();
+
+    auto c = linear(x + y + z <= 5);
+    auto d = linear(x + y + z < 4);
+    decide(trail, c);
+    REQUIRE(lra.propagate(db, trail).empty());
+    decide(trail, x, 1);
+    REQUIRE(lra.propagate(db, trail).empty());
+    decide(trail, y, 2);
+    REQUIRE(lra.propagate(db, trail).empty());
+
+    auto& bounds_z = lra.find_bounds(z.ord());
+    REQUIRE(bounds_z.upper_bound(models)->value() == 2);
+
+    lra.on_before_backtrack(db, trail, 2);
+    trail.backtrack(2);
+    decide(trail, y, 3);
+    REQUIRE(lra.propagate(db, trail).empty());
+    REQUIRE(bounds_z.upper_bound(models)->value() == 1);
+
+    decide(trail, z, 1);
+    REQUIRE(lra.propagate(db, trail).empty());
+    REQUIRE(models.boolean().is_defined(d.lit().var().ord()));
+    REQUIRE(eval(models.boolean(), d.lit()) == false);
+}
+
 TEST_CASE("Detect a bound conflict", "[linear_arithmetic]")
 {
     using namespace yaga;
@@ -473,6 +521,86 @@ TEST_CASE("Always choose a new boolean variable for unique derived constraints",
     REQUIRE(linear(y < 0).lit().var().ord() == 3);
 }
 
+TEST_CASE("Remove unused derived constraints on restart", "[linear_arithmetic]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Linear_arithmetic::Options options;
+    options.collect_limit = 1;
+    lra.set_options(options);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 1);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto models = lra.relevant_models(trail);
+    auto linear = factory(lra, trail);
+    auto [x, y] = real_vars<2>();
+
+    decide(trail, y, 0);
+    propagate(trail, linear(x > 0));
+    propagate(trail, linear(x + y < 0));
+
+    auto conflicts = lra.propagate(db, trail);
+    REQUIRE(!conflicts.empty());
+    REQUIRE(!lra.constraint(3).empty());
+
+    lra.on_before_backtrack(db, trail, 0);
+    trail.clear();
+    lra.on_restart(db, trail);
+
+    REQUIRE(lra.constraint(3).empty());
+    REQUIRE(linear(x > 0).lit().var().ord() == 1);
+    REQUIRE(linear(x + y < 0).lit().var().ord() == 2);
+    REQUIRE(linear(x + 2 * y <= 5).lit().var().ord() == 3);
+    REQUIRE(models.boolean().num_vars() == 4);
+
+    propagate(trail, linear(x + y < 0));
+    decide(trail, y, 0);
+    REQUIRE(lra.propagate(db, trail).empty());
+    REQUIRE(lra.find_bounds(x.ord()).upper_bound(models)->value() == 0);
+}
+
+TEST_CASE("Keep derived constraints which occur in a clause on restart", "[linear_arithmetic]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    Database db;
+    Linear_arithmetic lra;
+    Linear_arithmetic::Options options;
+    options.collect_limit = 1;
+    lra.set_options(options);
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 1);
+    trail.set_model<Rational>(Variable::rational, 3);
+
+    auto linear = factory(lra, trail);
+    auto [x, y] = real_vars<2>();
+
+    decide(trail, y, 0);
+    propagate(trail, linear(x > 0));
+    propagate(trail, linear(x + y < 0));
+
+    auto conflicts = lra.propagate(db, trail);
+    REQUIRE(!conflicts.empty());
+    db.learn_clause(conflicts.front());
+
+    lra.on_before_backtrack(db, trail, 0);
+    trail.clear();
+    lra.on_restart(db, trail);
+
+    REQUIRE(!lra.constraint(3).empty());
+    REQUIRE(linear(y < 0).lit().var().ord() == 3);
+    REQUIRE(linear(x + 2 * y <= 5).lit().var().ord() == 4);
+}
+
 TEST_CASE("Detect an inequality conflict", "[linear_arithmetic]")
 {
     using namespace yaga;
@@ -874,4 +1002,97 @@ TEST_CASE("Decide variable", "[linear_arithmetic]")
         REQUIRE(models.owned().value(x.ord()) > 8_r / 10);
         REQUIRE(models.owned().value(x.ord()) < 9_r / 10);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Microbenchmark of propagation with many variables", "[.][linear_arithmetic][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    constexpr int num_vars = 5000;
+
+    Database db;
+    Linear_arithmetic lra;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    trail.set_model<Rational>(Variable::rational, num_vars);
+
+    // x_i + x_{i+1} <= i
+    std::vector<Linear_constraint<Rational>> constraints;
+    for (int i = 0; i + 1 < num_vars; ++i)
+    {
+        constraints.push_back(lra.constraint(trail, std::array{i, i + 1},
+                                             std::array{Rational{1}, Rational{1}},
+                                             Order_predicate::leq, Rational{i}));
+    }
+    decide(trail, constraints.front());
+    for (auto const& cons : constraints | std::views::drop(1))
+    {
+        propagate(trail, cons);
+    }
+    REQUIRE(lra.propagate(db, trail).empty());
+
+    BENCHMARK("decide and propagate every other variable")
+    {
+        int num_conflicts = 0;
+        for (int i = 0; i < num_vars; i += 2)
+        {
+            decide(trail, Variable{i, Variable::rational}, 0);
+            num_conflicts += lra.propagate(db, trail).size();
+        }
+        lra.on_before_backtrack(db, trail, 1);
+        trail.backtrack(1);
+        return num_conflicts;
+    };
+}
+
+TEST_CASE("Microbenchmark of watch replacement in long constraints", "[.][linear_arithmetic][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    constexpr int num_vars = 2000;
+    constexpr int num_vars_per_cons = 50;
+    constexpr int num_cons = 2000;
+
+    Database db;
+    Linear_arithmetic lra;
+    Event_dispatcher dispatcher;
+    dispatcher.add(&lra);
+    Trail trail{dispatcher};
+    trail.set_model<bool>(Variable::boolean, 0);
+    trail.set_model<Rational>(Variable::rational, num_vars);
+
+    std::mt19937 eng{42};
+    std::uniform_int_distribution<int> coef_dist{1, 10};
+    std::vector<int> all_vars(num_vars);
+    std::iota(all_vars.begin(), all_vars.end(), 0);
+    for (int i = 0; i < num_cons; ++i)
+    {
+        std::vector<int> vars;
+        std::sample(all_vars.begin(), all_vars.end(), std::back_inserter(vars), num_vars_per_cons,
+                    eng);
+        std::shuffle(vars.begin(), vars.end(), eng);
+        std::vector<Rational> coef;
+        for (int j = 0; j < num_vars_per_cons; ++j)
+        {
+            coef.emplace_back(coef_dist(eng));
+        }
+        lra.constraint(trail, vars, coef, Order_predicate::leq, Rational{num_vars});
+    }
+
+    BENCHMARK("decide and propagate all variables")
+    {
+        int num_conflicts = 0;
+        for (int i = 0; i < num_vars; ++i)
+        {
+            decide(trail, Variable{i, Variable::rational}, 0);
+            num_conflicts += lra.propagate(db, trail).size();
+        }
+        lra.on_before_backtrack(db, trail, 0);
+        trail.backtrack(0);
+        return num_conflicts;
+    };
+}
@@ -287,6 +287,135 @@ TEST_CASE("Encode true constraint and false constraint uniformly", "[linear_cons
     REQUIRE(false_cons3.lit() == false_cons4.lit());
 }
 
+TEST_CASE("Reuse boolean variable of a removed constraint", "[linear_constraints]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    using Value_type = Rational;
+
+    Linear_constraints<Value_type> repo;
+    auto make = factory(repo);
+    auto [x, y, z] = real_vars<3>();
+
+    auto c0 = make(x + y <= 1);
+    auto c1 = make(x + 2 * z <= 2);
+    auto c2 = make(y + 3 * z <= 3);
+    REQUIRE(c1.lit().var().ord() == 1);
+
+    repo.remove(c1.lit().var().ord());
+    REQUIRE(repo.garbage() == 2);
+    repo.compact();
+    REQUIRE(repo.garbage() == 0);
+    REQUIRE(repo[1].empty());
+
+    c0 = repo[0];
+    c2 = repo[2];
+    REQUIRE(std::ranges::equal(c0.vars(), std::vector<int>{x.ord(), y.ord()}));
+    REQUIRE(std::ranges::equal(c0.coef(), std::vector<Value_type>{1, 1}));
+    REQUIRE(std::ranges::equal(c2.vars(), std::vector<int>{y.ord(), z.ord()}));
+    REQUIRE(std::ranges::equal(c2.coef(), std::vector<Value_type>{1, 3}));
+
+    // existing constraints are still deduplicated
+    REQUIRE(make(x + y <= 1).lit() == c0.lit());
+    REQUIRE(make(y + 3 * z <= 3).lit() == c2.lit());
+
+    auto c3 = repo.make(std::array{x.ord(), z.ord()}, std::array{Value_type{1}, Value_type{2}},
+                        Order_predicate::lt, Value_type{2}, /*bool_var_ord=*/1);
+    REQUIRE(c3.lit() == Literal{1});
+    REQUIRE(repo[1].pred() == Order_predicate::lt);
+    REQUIRE(repo.size() == 3);
+}
+
+TEST_CASE("Evaluate constraints in the integer form", "[linear_constraints]")
+{
+    using namespace yaga;
+    using namespace yaga::test;
+
+    using Value_type = Rational;
+
+    Linear_constraints<Value_type> repo;
+    auto make = factory(repo);
+    auto [x, y, z] = real_vars<3>();
+
+    // x + 2/3 * y - 1/2 * z <= 1/6
+    auto cons = make(6 * x + 4 * y - 3 * z <= 1);
+    auto bool_var_ord = cons.lit().var().ord();
+    REQUIRE(repo.is_int(cons));
+    REQUIRE(std::ranges::equal(cons.vars(), std::vector<int>{x.ord(), y.ord(), z.ord()}));
+
+    auto expected = [&](Model<Value_type> const& model) {
+        return model.value(x.ord()) + Value_type{2, 3} * model.value(y.ord()) -
+                   Value_type{1, 2} * model.value(z.ord()) <=
+               Value_type{1, 6};
+    };
+
+    Model<Value_type> model;
+    model.resize(3);
+    model.set_value(y.ord(), 1);
+    model.set_value(z.ord(), 1);
+    REQUIRE(cons.implied_value(model) == 0);
+    model.set_value(x.ord(), 0);
+    REQUIRE(eval(model, cons) == expected(model));
+    model.set_value(x.ord(), Value_type{1, 6}); // not an integer
+    REQUIRE(eval(model, cons) == expected(model));
+    model.set_value(y.ord(), Value_type{std::int64_t{1} << 62}); // `scale * coef * value` overflows
+    REQUIRE(eval(model, cons) == expected(model));
+
+    // swap variables together with coefficients of both forms
+    model.set_value(x.ord(), 1);
+    model.set_value(y.ord(), 2);
+    model.set_value(z.ord(), 5);
+    repo.swap(cons, 0, 2);
+    REQUIRE(std::ranges::equal(cons.vars(), std::vector<int>{z.ord(), y.ord(), x.ord()}));
+    REQUIRE(eval(model, cons) == true);
+    repo.swap(cons, 0, 2);
+
+    auto include = [&](int i) {
+        repo.include(bool_var_ord, cons.coef()[i], repo.int_coef(cons)[i],
+                     model.value(cons.vars()[i]));
+    };
+    auto exclude = [&](int i) {
+        repo.exclude(bool_var_ord, cons.coef()[i], repo.int_coef(cons)[i],
+                     model.value(cons.vars()[i]));
+    };
+
+    // partial sums with integer terms
+    model.set_value(x.ord(), 1);
+    model.set_value(y.ord(), -1);
+    model.set_value(z.ord(), 2);
+    include(1);
+    include(2);
+    REQUIRE(repo.partial_sum(cons).value == 0);
+    REQUIRE(cons.implied_value(model) == Value_type{11, 6});
+    include(0);
+    REQUIRE(eval(model, cons) == expected(model));
+
+    // partial sums with both integer and rational terms
+    exclude(0);
+    model.set_value(x.ord(), Value_type{11, 6});
+    include(0);
+    REQUIRE(repo.partial_sum(cons).value == Value_type{11, 6});
+    REQUIRE(eval(model, cons) == expected(model));
+    exclude(0);
+    exclude(2);
+    exclude(1);
+    REQUIRE(repo.partial_sum(cons).num_vars == 0);
+    REQUIRE(repo.partial_sum(cons).value == 0);
+    REQUIRE(repo.partial_sum(cons).int_value == 0);
+
+    // coefficients which do not fit into 64-bit integers
+    auto big = repo.make(std::array{x.ord(), y.ord()},
+                         std::array{Value_type{1}, Value_type{"100000000000000000000"}},
+                         Order_predicate::leq, Value_type{0});
+    REQUIRE(!repo.is_int(big));
+    model.set_value(x.ord(), 1);
+    model.set_value(y.ord(), 0);
+    REQUIRE(eval(model, big) == false);
+    model.set_value(x.ord(), -1);
+    REQUIRE(eval(model, big) == true);
+}
+
 template<int num_vars, int min_var_per_const, int max_var_per_const, int num_const>
 std::vector<yaga::test::Linear_predicate<yaga::Rational>> generate()
 {
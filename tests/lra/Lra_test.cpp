@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
+#include <vector>
 
 #include "test.h"
 #include "Solver.h"
@@ -246,4 +249,46 @@ TEST_CASE("Formula which forces the solver to generate duplicate constraints and
         REQUIRE(*test.real("z") + *test.real("y") < 0);
         REQUIRE(*test.real("z") > 0);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Check an LRA formula incrementally under assumptions", "[lra][sat][unsat][integration]")
+{
+    Options opts;
+    Yaga smt{logic::qf_lra, opts};
+    auto x = smt.make(Variable::rational);
+    auto y = smt.make(Variable::rational);
+    // x + y <= 4
+    smt.assert_clause(smt.linear_constraint(std::array{x.ord(), y.ord()}, std::array{1_r, 1_r},
+                                            Order_predicate::leq, 4_r));
+    // x >= 3
+    auto a = ~smt.linear_constraint(std::array{x.ord()}, std::array{1_r}, Order_predicate::lt, 3_r);
+    // y >= 2
+    auto b = ~smt.linear_constraint(std::array{y.ord()}, std::array{1_r}, Order_predicate::lt, 2_r);
+
+    auto& solver = smt.solver();
+    auto const& model = solver.trail().model<Rational>(Variable::rational);
+    auto contains = [](auto const& lits, Literal lit) {
+        return std::find(lits.begin(), lits.end(), lit) != lits.end();
+    };
+
+    REQUIRE(solver.check(std::array{a}) == Solver::Result::sat);
+    REQUIRE(model.value(x.ord()) >= 3);
+    REQUIRE(model.value(x.ord()) + model.value(y.ord()) <= 4);
+
+    REQUIRE(solver.check(std::array{a, b}) == Solver::Result::unsat);
+    REQUIRE(contains(solver.failed_assumptions(), a));
+    REQUIRE(contains(solver.failed_assumptions(), b));
+
+    REQUIRE(solver.check(std::array{b}) == Solver::Result::sat);
+    REQUIRE(model.value(y.ord()) >= 2);
+
+    // add a constraint between checks
+    auto z = smt.make(Variable::rational);
+    smt.assert_clause(smt.linear_constraint(std::array{x.ord(), z.ord()}, std::array{1_r, -1_r},
+                                            Order_predicate::eq, 0_r));
+    smt.assert_clause(a);
+    REQUIRE(solver.check(std::array{b}) == Solver::Result::unsat);
+    REQUIRE(solver.failed_assumptions() == std::vector<Literal>{b});
+    REQUIRE(solver.check() == Solver::Result::sat);
+    REQUIRE(model.value(z.ord()) == model.value(x.ord()));
+    REQUIRE(model.value(x.ord()) >= 3);
+}
@@ -1,6 +1,10 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark_all.hpp>
 
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <regex>
@@ -11,6 +15,9 @@
 #include "Solver_answer.h"
 #include "Smtlib_parser.h"
 #include "Smt2_parser.h"
+#include "smt2_lexer.h"
+#include "Mmap_lexer.h"
+#include "Preprocessor.h"
 #include "Yaga.h"
 
 TEST_CASE("Parse boolean functions", "[test_parser]")
@@ -389,4 +396,854 @@ TEST_CASE("Parse if-then-else with real output", "[test_parser]")
         REQUIRE(test.real("x").has_value());
         REQUIRE(*test.real("x") < Rational{0});
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Check assertions in nested assertion levels", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    std::stringstream input;
+    std::stringstream output;
+    input << "(declare-fun x () Real)\n";
+    input << "(declare-fun y () Real)\n";
+    input << "(declare-fun b () Bool)\n";
+    input << "(assert (<= (+ x y) 4))\n";
+
+    SECTION("popped assertions are retracted")
+    {
+        input << "(push 1)\n";
+        input << "(assert (>= x 3))\n";
+        input << "(assert (>= y 2))\n";
+        input << "(check-sat)\n";
+        input << "(pop 1)\n";
+        input << "(assert (>= x 3))\n";
+        input << "(check-sat)\n";
+        input << "(push 2)\n";
+        input << "(assert false)\n";
+        input << "(check-sat)\n";
+        input << "(pop 2)\n";
+        input << "(check-sat)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "unsat\nsat\nunsat\nsat\n");
+    }
+
+    SECTION("symbols declared in a popped level can be declared again")
+    {
+        input << "(push 1)\n";
+        input << "(declare-fun z () Real)\n";
+        input << "(assert (and (< z x) (> z 4)))\n";
+        input << "(check-sat)\n";
+        input << "(pop 1)\n";
+        input << "(declare-fun z () Bool)\n";
+        input << "(assert (and z (> x 4)))\n";
+        input << "(check-sat)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "sat\nsat\n");
+    }
+
+    SECTION("assumptions only hold in one check")
+    {
+        input << "(assert (=> b (> x 5)))\n";
+        input << "(check-sat-assuming (b (> y 0)))\n";
+        input << "(check-sat-assuming ((not b)))\n";
+        input << "(check-sat)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "unsat\nsat\nsat\n");
+    }
+
+    SECTION("reset removes all assertions")
+    {
+        input << "(assert (> x 4))\n";
+        input << "(assert (> y 4))\n";
+        input << "(check-sat)\n";
+        input << "(reset)\n";
+        input << "(declare-fun x () Real)\n";
+        input << "(assert (> x 4))\n";
+        input << "(check-sat)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "unsat\nsat\n");
+    }
+}
+
+TEST_CASE("Get unsat core of named assertions", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    std::stringstream input;
+    std::stringstream output;
+    input << "(set-option :produce-unsat-cores true)\n";
+    input << "(declare-fun x () Real)\n";
+    input << "(declare-fun y () Real)\n";
+    input << "(declare-fun b () Bool)\n";
+    input << "(assert (<= (+ x y) 4))\n";
+    input << "(assert (! (>= x 3) :named a1))\n";
+    input << "(assert (! (<= x 10) :named a2))\n";
+
+    SECTION("core contains only named assertions")
+    {
+        input << "(assert (! (>= y 2) :named a3))\n";
+        input << "(check-sat)\n";
+        input << "(get-unsat-core)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "unsat\n(a1 a3)\n");
+    }
+
+    SECTION("core contains assumptions")
+    {
+        input << "(assert (! (=> b (< x 0)) :named a3))\n";
+        input << "(check-sat-assuming (b))\n";
+        input << "(get-unsat-core)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "unsat\n(a1 a3 b)\n");
+    }
+
+    SECTION("named assertions in popped levels are retracted")
+    {
+        input << "(push 1)\n";
+        input << "(assert (! (>= y 2) :named a3))\n";
+        input << "(check-sat)\n";
+        input << "(pop 1)\n";
+        input << "(assert (! (> y 5) :named a4))\n";
+        input << "(check-sat)\n";
+        input << "(get-unsat-core)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "unsat\nunsat\n(a1 a4)\n");
+    }
+}
+
+TEST_CASE("Check shared boolean subterms in both polarities", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    std::stringstream input;
+    std::stringstream output;
+    input << "(declare-fun x () Real)\n";
+    input << "(declare-fun a () Bool)\n";
+    input << "(declare-fun b () Bool)\n";
+    input << "(declare-fun c () Bool)\n";
+    input << "(assert (or (or a (< x 0)) (and b c)))\n";
+
+    SECTION("nested disjunction")
+    {
+        input << "(assert (not a))\n";
+        input << "(assert (>= x 0))\n";
+        input << "(check-sat)\n";
+        input << "(assert (not c))\n";
+        input << "(check-sat)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "sat\nunsat\n");
+    }
+
+    SECTION("subterm is used in the opposite polarity later")
+    {
+        input << "(assert (not (or a (< x 0))))\n";
+        input << "(check-sat)\n";
+        input << "(assert (=> (and b c) (> x 1)))\n";
+        input << "(check-sat)\n";
+        input << "(assert (< x 1))\n";
+        input << "(check-sat)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "sat\nsat\nunsat\n");
+    }
+
+    SECTION("subterm is used in both polarities in ite condition")
+    {
+        input << "(declare-fun y () Real)\n";
+        input << "(assert (= y (ite (and b c) 1 2)))\n";
+        input << "(assert (not a))\n";
+        input << "(assert (> x 0))\n";
+        input << "(check-sat)\n";
+        input << "(assert (> y 1))\n";
+        input << "(check-sat)\n";
+        Smt2_parser{}.parse(input, output);
+
+        REQUIRE(output.str() == "sat\nunsat\n");
+    }
+}
+
+TEST_CASE("Simplify assertions before internalization", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+    using namespace yaga::terms;
+
+    Term_manager tm;
+    Options options;
+    Preprocessor preprocessor{tm, options};
+    auto is_internalized = [](term_t) { return false; };
+    auto mk = [&](std::string const& op, std::vector<term_t> args) { return tm.mk_term(op, args); };
+    term_t a = tm.mk_uninterpreted_constant(types::bool_type);
+    term_t b = tm.mk_uninterpreted_constant(types::bool_type);
+    term_t c = tm.mk_uninterpreted_constant(types::bool_type);
+    term_t x = tm.mk_uninterpreted_constant(types::real_type);
+    term_t y = tm.mk_uninterpreted_constant(types::real_type);
+    term_t one = tm.mk_integer_constant("1");
+    term_t three = tm.mk_integer_constant("3");
+    term_t five = tm.mk_integer_constant("5");
+
+    SECTION("duplicate and subsumed assertions are removed")
+    {
+        term_t a_or_b = mk("or", {a, b});
+        term_t b_or_c = mk("or", {b, c});
+        term_t b_or_c_or_a = mk("or", {a, b, c});
+        auto result = preprocessor.preprocess({b_or_c_or_a, b_or_c, b_or_c}, is_internalized, false);
+        REQUIRE(result == std::vector<term_t>{b_or_c});
+        REQUIRE(preprocessor.num_removed() == 2);
+
+        preprocessor.push();
+        result = preprocessor.preprocess({a, a_or_b}, is_internalized, false);
+        REQUIRE(result == std::vector<term_t>{a});
+        preprocessor.pop();
+
+        result = preprocessor.preprocess({a_or_b}, is_internalized, false);
+        REQUIRE(result == std::vector<term_t>{a_or_b});
+    }
+
+    SECTION("conjunctions are split")
+    {
+        auto result = preprocessor.preprocess({mk("and", {a, mk("and", {b, c})})}, is_internalized, 
+                                              false);
+        REQUIRE(result == std::vector<term_t>{a, b, c});
+    }
+
+    SECTION("top-level equalities are substituted")
+    {
+        term_t x_eq_y = mk("=", {x, mk("+", {y, one})});
+        term_t x_ge_3 = mk(">=", {x, three});
+        auto result = preprocessor.preprocess({x_eq_y, x_ge_3}, is_internalized, true);
+        REQUIRE(preprocessor.num_eliminated() == 1);
+        REQUIRE(result.size() == 1);
+        // y + 1 >= 3
+        REQUIRE(result[0] == mk(">=", {y, tm.mk_integer_constant("2")}));
+    }
+
+    SECTION("equalities of internalized variables are kept")
+    {
+        term_t x_eq_y = mk("=", {x, y});
+        auto result = preprocessor.preprocess({x_eq_y}, [](term_t) { return true; }, true);
+        REQUIRE(preprocessor.num_eliminated() == 0);
+        REQUIRE(result == std::vector<term_t>{x_eq_y});
+    }
+
+    SECTION("equalities in pushed levels are kept")
+    {
+        term_t x_eq_y = mk("=", {x, y});
+        preprocessor.push();
+        auto result = preprocessor.preprocess({x_eq_y}, is_internalized, false);
+        REQUIRE(preprocessor.num_eliminated() == 0);
+        REQUIRE(result == std::vector<term_t>{x_eq_y});
+    }
+
+    SECTION("boolean literals are substituted")
+    {
+        auto result = preprocessor.preprocess({mk("not", {a}), mk("or", {a, b})}, is_internalized, 
+                                              true);
+        REQUIRE(result == std::vector<term_t>{mk("not", {a}), b});
+    }
+
+    SECTION("ite terms are lifted if a branch is a constant")
+    {
+        // (ite a 1 5) >= 3 is equivalent to (not a)
+        term_t atom = mk(">=", {mk("ite", {a, one, five}), three});
+        REQUIRE(preprocessor.simplify(atom) == mk("not", {a}));
+
+        // (ite a (ite a x 1) y) is (ite a x y)
+        term_t ite = mk("ite", {a, mk("ite", {a, x, one}), y});
+        REQUIRE(preprocessor.simplify(mk("=", {ite, five})) == 
+                mk("=", {mk("ite", {a, x, y}), five}));
+    }
+
+    SECTION("arithmetic atoms are normalized")
+    {
+        term_t two_x = mk("*", {tm.mk_integer_constant("2"), x});
+        term_t atom = mk(">=", {mk("+", {two_x, mk("*", {tm.mk_integer_constant("4"), y})}), 
+                                five});
+        term_t normalized = mk(">=", {mk("+", {x, mk("*", {tm.mk_integer_constant("2"), y})}),
+                                      tm.mk_rational_constant("2.5")});
+        REQUIRE(preprocessor.simplify(atom) == normalized);
+    }
+}
+
+TEST_CASE("Get model of eliminated variables", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+    using namespace yaga::test;
+
+    Yaga_test test;
+    test.input() << "(declare-fun x () Real)\n";
+    test.input() << "(declare-fun y () Real)\n";
+    test.input() << "(declare-fun z () Real)\n";
+    test.input() << "(assert (= x (+ y 1)))\n";
+    test.input() << "(assert (= (* 2 z) (+ x 1)))\n";
+    test.input() << "(assert (> y 0.5))\n";
+    test.input() << "(assert (< z 3))\n";
+    test.run();
+
+    REQUIRE(test.answer() == Solver_answer::SAT);
+    REQUIRE(test.real("x").has_value());
+    REQUIRE(test.real("y").has_value());
+    REQUIRE(test.real("z").has_value());
+    auto x = test.real("x").value();
+    auto y = test.real("y").value();
+    auto z = test.real("z").value();
+    REQUIRE(x == y + 1);
+    REQUIRE(z * 2 == x + 1);
+    REQUIRE(y > Rational{1, 2});
+    REQUIRE(z < 3);
+}
+
+TEST_CASE("Scan tokens from memory", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    SECTION("tokens are the same as tokens of the flex lexer")
+    {
+        std::string input = "(set-info :status sat) ; comment ( )\n"
+                            "(declare-fun |quoted x| () Real)\t(assertx as! 12.5 007 "
+                            "\"say \"\"hi\"\"\" check-sat-assuming _ ! <=)\r\n; end";
+        std::stringstream input_stream{input};
+        smt2_lexer flex_lexer;
+        flex_lexer.yyrestart(input_stream);
+        Mmap_lexer mmap_lexer{std::string_view{input}};
+
+        for (Token expected = flex_lexer.next_token(); expected != Token::EOF_TOK;
+             expected = flex_lexer.next_token())
+        {
+            REQUIRE(mmap_lexer.next_token() == expected);
+            REQUIRE(mmap_lexer.token_string() == flex_lexer.token_string());
+        }
+        REQUIRE(mmap_lexer.next_token() == Token::EOF_TOK);
+    }
+
+    SECTION("longest match")
+    {
+        Mmap_lexer lexer{std::string_view{"1.x #b012 #x1Fg :a.b"}};
+        REQUIRE(lexer.next_token() == Token::INTEGER_LITERAL);
+        REQUIRE(lexer.token_string() == "1");
+        REQUIRE(lexer.next_token() == Token::SYMBOL);
+        REQUIRE(lexer.token_string() == ".x");
+        REQUIRE(lexer.next_token() == Token::BINARY_LITERAL);
+        REQUIRE(lexer.token_string() == "#b01");
+        REQUIRE(lexer.next_token() == Token::INTEGER_LITERAL);
+        REQUIRE(lexer.token_string() == "2");
+        REQUIRE(lexer.next_token() == Token::HEX_LITERAL);
+        REQUIRE(lexer.token_string() == "#x1F");
+        REQUIRE(lexer.next_token() == Token::SYMBOL);
+        REQUIRE(lexer.token_string() == "g");
+        REQUIRE(lexer.next_token() == Token::KEYWORD);
+        REQUIRE(lexer.token_string() == ":a.b");
+        REQUIRE(lexer.next_token() == Token::EOF_TOK);
+    }
+
+    SECTION("invalid token")
+    {
+        Mmap_lexer lexer{std::string_view{"(assert |x\\y|)"}};
+        REQUIRE(lexer.next_token() == Token::LPAREN_TOK);
+        REQUIRE(lexer.next_token() == Token::ASSERT_TOK);
+        REQUIRE_THROWS(lexer.next_token());
+    }
+
+    SECTION("script is parsed the same way as from a stream")
+    {
+        std::string input = "(declare-fun x () Real)\n"
+                            "(declare-fun |y| () Real)\n"
+                            "(declare-fun b () Bool)\n"
+                            "(assert (let ((z (+ x y))) (and (<= z 4.5) (>= |z| 1) b)))\n"
+                            "(assert (let ((z x)) (let ((z (* 2 z))) (= z y))))\n"
+                            "(check-sat)\n"
+                            "(get-model)\n";
+        std::stringstream input_stream{input};
+        std::stringstream stream_output;
+        Smt2_parser{}.parse(input_stream, stream_output);
+
+        std::stringstream memory_output;
+        Smt2_parser{}.parse(std::string_view{input}, memory_output);
+
+        REQUIRE(memory_output.str().starts_with("sat\n"));
+        REQUIRE(memory_output.str() == stream_output.str());
+    }
+}
+
+TEST_CASE("Internalize assertions in a background thread", "[test_parser]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    Options options;
+    options.pipeline = true;
+    auto parse = [&](std::string const& input) {
+        std::stringstream input_stream{input};
+        std::stringstream output;
+        Smt2_parser parser;
+        parser.set_options(options);
+        parser.parse(input_stream, output);
+        return output.str();
+    };
+
+    SECTION("assertion levels and unsat cores")
+    {
+        std::string input = "(set-option :produce-unsat-cores true)\n"
+                            "(declare-fun x () Real)\n"
+                            "(declare-fun y () Real)\n"
+                            "(declare-fun b () Bool)\n"
+                            "(assert (<= (+ x y) 4))\n"
+                            "(assert (! (>= x 3) :named a1))\n"
+                            "(push 1)\n"
+                            "(assert (! (>= y 2) :named a2))\n"
+                            "(check-sat)\n"
+                            "(get-unsat-core)\n"
+                            "(pop 1)\n"
+                            "(assert (=> b (> y 1)))\n"
+                            "(check-sat)\n"
+                            "(check-sat-assuming (b))\n"
+                            "(reset)\n"
+                            "(declare-fun x () Real)\n"
+                            "(assert (> x 4))\n"
+                            "(check-sat)\n";
+
+        REQUIRE(parse(input) == "unsat\n(a1 a2)\nsat\nunsat\nsat\n");
+    }
+
+    SECTION("answers are the same as without the pipeline")
+    {
+        constexpr int num_vars = 8;
+        std::mt19937 rng{11};
+        auto random_int = [&](int lb, int ub) {
+            return std::uniform_int_distribution<int>{lb, ub}(rng);
+        };
+
+        std::stringstream input;
+        for (int i = 0; i < num_vars; ++i)
+        {
+            input << "(declare-fun x" << i << " () Real)\n";
+            input << "(declare-fun b" << i << " () Bool)\n";
+        }
+        int num_levels = 0;
+        for (int i = 0; i < 200; ++i)
+        {
+            int x = random_int(0, num_vars - 1);
+            int y = random_int(0, num_vars - 1);
+            std::string literal = "b" + std::to_string(x);
+            input << "(assert (or " << (random_int(0, 1) ? literal : "(not " + literal + ")")
+                  << " (" << (random_int(0, 1) ? "<=" : ">=") << " (+ x" << x << " (* "
+                  << random_int(1, 3) << " x" << y << ")) "
+                  << random_int(0, 10) << ")))\n";
+            switch (random_int(0, 9))
+            {
+            case 0:
+                input << "(push 1)\n";
+                ++num_levels;
+                break;
+            case 1:
+                if (num_levels > 0)
+                {
+                    input << "(pop 1)\n";
+                    --num_levels;
+                }
+                break;
+            case 2:
+                input << "(check-sat)\n";
+                break;
+            }
+        }
+        input << "(check-sat)\n";
+
+        auto answers = parse(input.str());
+        options.pipeline = false;
+        REQUIRE(answers == parse(input.str()));
+    }
+
+    SECTION("coefficients which do not fit in a machine word")
+    {
+        // the parser and the worker both allocate GMP numbers from the shared pool
+        constexpr int num_vars = 16;
+        std::mt19937 rng{13};
+        auto random_int = [&](int lb, int ub) {
+            return std::uniform_int_distribution<int>{lb, ub}(rng);
+        };
+        auto big = [&](int value) {
+            return std::to_string(value) + "000000000000000000000";
+        };
+
+        std::stringstream input;
+        for (int i = 0; i < num_vars; ++i)
+        {
+            input << "(declare-fun x" << i << " () Real)\n";
+        }
+        for (int i = 0; i < 2000; ++i)
+        {
+            int x = random_int(0, num_vars - 1);
+            int y = random_int(0, num_vars - 1);
+            input << "(assert (or (<= (+ (* " << big(random_int(1, 9)) << " x" << x << ") (* "
+                  << big(random_int(1, 9)) << " x" << y << ")) " << big(random_int(1, 99))
+                  << ") (>= (- x" << x << " (* " << big(random_int(1, 9)) << " x" << y
+                  << ")) (- " << big(random_int(1, 99)) << "))))\n";
+        }
+        input << "(check-sat)\n";
+
+        auto answers = parse(input.str());
+        REQUIRE(answers == "sat\n");
+        options.pipeline = false;
+        REQUIRE(answers == parse(input.str()));
+    }
+}
+
+TEST_CASE("Benchmark incremental checks in assertion levels", "[.][test_parser][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    constexpr int num_vars = 50;
+    constexpr int num_checks = 50;
+
+    // chain x0 < x1 < ... < x49 with an additional bound in each check
+    std::stringstream prefix;
+    for (int i = 0; i < num_vars; ++i)
+    {
+        prefix << "(declare-fun x" << i << " () Real)\n";
+    }
+    for (int i = 0; i + 1 < num_vars; ++i)
+    {
+        prefix << "(assert (or (< x" << i << " x" << i + 1 << ") (< x" << i + 1 << " (- x" << i
+               << " " << num_vars << "))))\n";
+    }
+    auto query = [](int i) {
+        return "(assert (and (> x0 " + std::to_string(i) + ") (< x" + std::to_string(num_vars - 1) +
+               " " + std::to_string(2 * i) + ")))\n";
+    };
+
+    std::string incremental = prefix.str();
+    for (int i = 0; i < num_checks; ++i)
+    {
+        incremental += "(push 1)\n" + query(i) + "(check-sat)\n(pop 1)\n";
+    }
+
+    BENCHMARK("incremental")
+    {
+        std::stringstream input{incremental};
+        std::stringstream output;
+        Smt2_parser{}.parse(input, output);
+        return output.str().size();
+    };
+
+    BENCHMARK("solve each check from scratch")
+    {
+        std::size_t size = 0;
+        for (int i = 0; i < num_checks; ++i)
+        {
+            std::stringstream input{prefix.str() + query(i) + "(check-sat)\n"};
+            std::stringstream output;
+            Smt2_parser{}.parse(input, output);
+            size += output.str().size();
+        }
+        return size;
+    };
+}
+
+TEST_CASE("Benchmark checks of a growing set of assertions", "[.][test_parser][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    constexpr int num_vars = 200;
+
+    // each check adds one link of a chain x0 < x1 < ... < x199 which is always satisfiable
+    std::stringstream input_stream;
+    for (int i = 0; i < num_vars; ++i)
+    {
+        input_stream << "(declare-fun x" << i << " () Real)\n";
+    }
+    for (int i = 0; i + 1 < num_vars; ++i)
+    {
+        input_stream << "(assert (and (< x" << i << " x" << i + 1 << ") (<= x" << i << " " 
+                     << num_vars << ")))\n";
+        input_stream << "(check-sat)\n";
+    }
+    auto input = input_stream.str();
+
+    BENCHMARK("check after each assertion")
+    {
+        std::stringstream input_copy{input};
+        std::stringstream output;
+        Smt2_parser{}.parse(input_copy, output);
+        return output.str().size();
+    };
+}
+
+TEST_CASE("Benchmark deep boolean structure", "[.][test_parser][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    constexpr int num_real_vars = 10;
+    constexpr int num_bool_vars = 20;
+    constexpr int num_assertions = 40;
+    constexpr int depth = 6;
+
+    std::mt19937 rng{5};
+    auto random_int = [&](int lb, int ub) {
+        return std::uniform_int_distribution<int>{lb, ub}(rng);
+    };
+    auto print_num = [](std::ostream& out, int value) -> std::ostream& {
+        return value < 0 ? out << "(- " << -value << ")" : out << value;
+    };
+
+    // random formula with nested and, or, not and => of arithmetic and boolean atoms
+    std::function<void(std::ostream&, int)> print_formula = [&](std::ostream& out, int level) {
+        if (level == 0)
+        {
+            if (random_int(0, 9) < 3)
+            {
+                out << "b" << random_int(0, num_bool_vars - 1);
+            }
+            else
+            {
+                out << "(<= (+ x" << random_int(0, num_real_vars - 1) << " (* ";
+                print_num(out, random_int(-3, 3)) << " x" << random_int(0, num_real_vars - 1) 
+                                                  << ")) ";
+                print_num(out, random_int(-6, 6)) << ")";
+            }
+            return;
+        }
+
+        switch (random_int(0, 4))
+        {
+        case 0:
+            out << "(not ";
+            print_formula(out, level - 1);
+            out << ")";
+            break;
+        case 1:
+            out << "(=> ";
+            print_formula(out, level - 1);
+            out << " ";
+            print_formula(out, level - 1);
+            out << ")";
+            break;
+        default:
+            out << (random_int(0, 2) == 0 ? "(and" : "(or");
+            for (int i = random_int(2, 3); i > 0; --i)
+            {
+                out << " ";
+                print_formula(out, level - 1);
+            }
+            out << ")";
+            break;
+        }
+    };
+
+    std::stringstream input_stream;
+    for (int i = 0; i < num_real_vars; ++i)
+    {
+        input_stream << "(declare-fun x" << i << " () Real)\n";
+    }
+    for (int i = 0; i < num_bool_vars; ++i)
+    {
+        input_stream << "(declare-fun b" << i << " () Bool)\n";
+    }
+    for (int i = 0; i < num_assertions; ++i)
+    {
+        input_stream << "(assert ";
+        print_formula(input_stream, depth);
+        input_stream << ")\n";
+    }
+    input_stream << "(check-sat)\n";
+    auto input = input_stream.str();
+
+    BENCHMARK("parse and check")
+    {
+        std::stringstream input_copy{input};
+        std::stringstream output;
+        Smt2_parser{}.parse(input_copy, output);
+        return output.str().size();
+    };
+}
+
+TEST_CASE("Benchmark parse throughput", "[.][test_parser][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    constexpr int num_vars = 1000;
+    constexpr int num_assertions = 20000;
+
+    std::mt19937 rng{7};
+    auto random_int = [&](int lb, int ub) {
+        return std::uniform_int_distribution<int>{lb, ub}(rng);
+    };
+
+    // disjunctions of linear inequalities with many distinct rational constants
+    std::size_t num_terms = 0;
+    std::stringstream input_stream;
+    for (int i = 0; i < num_vars; ++i)
+    {
+        input_stream << "(declare-fun x" << i << " () Real)\n";
+    }
+    for (int i = 0; i < num_assertions; ++i)
+    {
+        input_stream << "(assert (or";
+        for (int j = random_int(2, 4); j > 0; --j)
+        {
+            input_stream << " (<= (+";
+            for (int k = random_int(2, 5); k > 0; --k)
+            {
+                input_stream << " (* " << random_int(1, 1000) << " x"
+                             << random_int(0, num_vars - 1) << ")";
+                num_terms += 3;
+            }
+            input_stream << ") " << random_int(0, 100000) << ".5)";
+            num_terms += 3;
+        }
+        input_stream << "))\n";
+        num_terms += 1;
+    }
+    auto input = input_stream.str();
+
+    auto parse_stream = [&]() {
+        std::stringstream input_copy{input};
+        std::stringstream output;
+        Smt2_parser{}.parse(input_copy, output);
+        return output.str().size();
+    };
+
+    auto parse_memory = [&]() {
+        std::stringstream output;
+        Smt2_parser{}.parse(std::string_view{input}, output);
+        return output.str().size();
+    };
+
+    auto report = [&](std::string_view name, auto parse) {
+        auto start = std::chrono::steady_clock::now();
+        parse();
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        std::cout << name << ": parsed " << input.size() / 1e6 / seconds.count() << " MB/s, "
+                  << num_terms / seconds.count() << " terms/s\n";
+    };
+    report("stream", parse_stream);
+    report("memory", parse_memory);
+
+    BENCHMARK("parse assertions from a stream")
+    {
+        return parse_stream();
+    };
+
+    BENCHMARK("parse assertions from memory")
+    {
+        return parse_memory();
+    };
+}
+
+TEST_CASE("Benchmark shared subterms", "[.][test_parser][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    constexpr int num_vars = 100;
+    constexpr int depth = 3000;
+
+    // each let-bound formula is used twice by the next one, so the formula is a DAG whose tree
+    // representation is exponential in `depth`
+    std::stringstream input_stream;
+    for (int i = 0; i < num_vars; ++i)
+    {
+        input_stream << "(declare-fun x" << i << " () Real)\n";
+    }
+    input_stream << "(assert ";
+    for (int i = 0; i < depth; ++i)
+    {
+        input_stream << "(let ((f" << i + 1 << " ";
+        auto atom = [&](int j) {
+            return "(<= x" + std::to_string(j % num_vars) + " " + std::to_string(j) + ")";
+        };
+        if (i == 0)
+        {
+            input_stream << atom(0);
+        }
+        else
+        {
+            input_stream << "(or (and f" << i << " " << atom(2 * i) << ") (and (not f" << i
+                         << ") " << atom(2 * i + 1) << "))";
+        }
+        input_stream << ")) ";
+    }
+    input_stream << "f" << depth << std::string(depth, ')') << ")\n(check-sat)\n";
+    auto input = input_stream.str();
+
+    BENCHMARK("parse and check")
+    {
+        std::stringstream input_copy{input};
+        std::stringstream output;
+        Smt2_parser{}.parse(input_copy, output);
+        return output.str().size();
+    };
+}
+
+TEST_CASE("Benchmark pipelined internalization", "[.][test_parser][bench]")
+{
+    using namespace yaga;
+    using namespace yaga::parser;
+
+    constexpr int num_vars = 1000;
+    constexpr int num_assertions = 50000;
+
+    std::mt19937 rng{13};
+    auto random_int = [&](int lb, int ub) {
+        return std::uniform_int_distribution<int>{lb, ub}(rng);
+    };
+
+    // `push` waits until all assertions are internalized, so the benchmark measures the time
+    // until the solver could make its first decision
+    std::stringstream input_stream;
+    for (int i = 0; i < num_vars; ++i)
+    {
+        input_stream << "(declare-fun x" << i << " () Real)\n";
+    }
+    for (int i = 0; i < num_assertions; ++i)
+    {
+        input_stream << "(assert (or";
+        for (int j = random_int(2, 4); j > 0; --j)
+        {
+            input_stream << " (<= (+ (* " << random_int(1, 1000) << " x"
+                         << random_int(0, num_vars - 1) << ") x" << random_int(0, num_vars - 1)
+                         << ") " << random_int(0, 100000) << ")";
+        }
+        input_stream << "))\n";
+    }
+    input_stream << "(push 1)\n";
+    auto input = input_stream.str();
+
+    auto parse = [&](bool pipeline) {
+        Options options;
+        options.simplify = false;
+        options.pipeline = pipeline;
+        Smt2_parser parser;
+        parser.set_options(options);
+        std::stringstream output;
+        parser.parse(std::string_view{input}, output);
+        return output.str().size();
+    };
+
+    BENCHMARK("parse and internalize sequentially")
+    {
+        return parse(false);
+    };
+
+    BENCHMARK("parse and internalize in a pipeline")
+    {
+        return parse(true);
+    };
+}
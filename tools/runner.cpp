@@ -0,0 +1,837 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+void print_help()
+{
+    std::cerr << "Usage:\n";
+    std::cerr << "   ./runner run [options] <path>...\n";
+    std::cerr << "   ./runner compare <baseline.json> <candidate.json>\n";
+    std::cerr << "\n";
+    std::cerr << "The run command solves all .cnf files using `sat` and all .smt2 files using `smt`\n"
+                 "(directories are searched recursively) and writes results as JSON. Answers are\n"
+                 "checked against `(set-info :status ...)` annotations.\n";
+    std::cerr << "Options of the run command:\n";
+    std::cerr << "   --output <path>: write results to path instead of the standard output.\n";
+    std::cerr << "   --timeout <s>: wall-clock time limit of each instance (default: 60).\n";
+    std::cerr << "   --memory-limit <MB>: address space limit of each instance (default: 4096).\n";
+    std::cerr << "   --jobs <n>: number of instances solved in parallel (default: number of cores).\n";
+    std::cerr << "   --sat <path>: SAT solver executable (default: `sat` next to this executable).\n";
+    std::cerr << "   --smt <path>: SMT solver executable (default: `smt` next to this executable).\n";
+    std::cerr << "   --arg <arg>: pass an extra argument to the solvers (can be repeated).\n";
+    std::cerr << "\n";
+    std::cerr << "The compare command prints solved counts, PAR-2 scores and speedups per family\n"
+                 "(directory) of two result files. It returns a non-zero exit code if the candidate\n"
+                 "gives a wrong answer or does not solve an instance solved by the baseline.\n";
+}
+
+/** Minimal JSON value used to read result files.
+ */
+struct Json {
+    using Array = std::vector<Json>;
+    using Object = std::vector<std::pair<std::string, Json>>;
+
+    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> value;
+
+    /** Find a member of an object
+     *
+     * @param key name of the member
+     * @return pointer to the member or nullptr if this is not an object or there is no such member
+     */
+    Json const* find(std::string_view key) const
+    {
+        if (auto object = std::get_if<Object>(&value))
+        {
+            for (auto const& [name, member] : *object)
+            {
+                if (name == key)
+                {
+                    return &member;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // get member `key` as a string or return @p def if there is no such string member
+    std::string string(std::string_view key, std::string def = "") const
+    {
+        auto member = find(key);
+        auto str = member ? std::get_if<std::string>(&member->value) : nullptr;
+        return str ? *str : def;
+    }
+
+    // get member `key` as a number or return @p def if there is no such number member
+    double number(std::string_view key, double def = 0) const
+    {
+        auto member = find(key);
+        auto num = member ? std::get_if<double>(&member->value) : nullptr;
+        return num ? *num : def;
+    }
+};
+
+/** Recursive descent parser of JSON documents.
+ */
+class Json_parser {
+public:
+    explicit Json_parser(std::string_view text) : text(text) {}
+
+    /** Parse the whole input as a single JSON value
+     *
+     * @return parsed value
+     * @throws std::runtime_error if the input is not valid JSON
+     */
+    Json parse()
+    {
+        auto result = parse_value();
+        skip_space();
+        if (pos != text.size())
+        {
+            error("unexpected trailing characters");
+        }
+        return result;
+    }
+
+private:
+    std::string_view text;
+    std::size_t pos = 0;
+
+    [[noreturn]] void error(std::string const& msg) const
+    {
+        throw std::runtime_error{"JSON: " + msg + " at offset " + std::to_string(pos)};
+    }
+
+    void skip_space()
+    {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+        {
+            ++pos;
+        }
+    }
+
+    bool accept(char c)
+    {
+        skip_space();
+        if (pos < text.size() && text[pos] == c)
+        {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c)
+    {
+        if (!accept(c))
+        {
+            error(std::string{"expected '"} + c + "'");
+        }
+    }
+
+    Json parse_value()
+    {
+        skip_space();
+        if (pos >= text.size())
+        {
+            error("unexpected end of input");
+        }
+
+        if (accept('{'))
+        {
+            Json::Object object;
+            if (!accept('}'))
+            {
+                do
+                {
+                    skip_space();
+                    auto key = parse_string();
+                    expect(':');
+                    object.emplace_back(std::move(key), parse_value());
+                } while (accept(','));
+                expect('}');
+            }
+            return {std::move(object)};
+        }
+        else if (accept('['))
+        {
+            Json::Array array;
+            if (!accept(']'))
+            {
+                do
+                {
+                    array.push_back(parse_value());
+                } while (accept(','));
+                expect(']');
+            }
+            return {std::move(array)};
+        }
+        else if (text[pos] == '"')
+        {
+            return {parse_string()};
+        }
+        else if (text.substr(pos, 4) == "true")
+        {
+            pos += 4;
+            return {true};
+        }
+        else if (text.substr(pos, 5) == "false")
+        {
+            pos += 5;
+            return {false};
+        }
+        else if (text.substr(pos, 4) == "null")
+        {
+            pos += 4;
+            return {nullptr};
+        }
+        return {parse_number()};
+    }
+
+    std::string parse_string()
+    {
+        if (pos >= text.size() || text[pos] != '"')
+        {
+            error("expected a string");
+        }
+        ++pos;
+
+        std::string result;
+        while (pos < text.size() && text[pos] != '"')
+        {
+            char c = text[pos++];
+            if (c == '\\' && pos < text.size())
+            {
+                c = text[pos++];
+                switch (c)
+                {
+                case 'n':
+                    c = '\n';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 'b':
+                    c = '\b';
+                    break;
+                case 'f':
+                    c = '\f';
+                    break;
+                case 'u':
+                    // only ASCII escapes are written by the runner
+                    if (pos + 4 > text.size())
+                    {
+                        error("invalid escape sequence");
+                    }
+                    c = static_cast<char>(std::stoi(std::string{text.substr(pos, 4)}, nullptr, 16));
+                    pos += 4;
+                    break;
+                default: // '"', '\\', '/'
+                    break;
+                }
+            }
+            result.push_back(c);
+        }
+
+        if (pos >= text.size())
+        {
+            error("unterminated string");
+        }
+        ++pos;
+        return result;
+    }
+
+    double parse_number()
+    {
+        auto begin = text.data() + pos;
+        char* end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin)
+        {
+            error("unexpected character");
+        }
+        pos += end - begin;
+        return value;
+    }
+};
+
+// write @p str as a JSON string literal
+void write_string(std::ostream& out, std::string_view str)
+{
+    out << '"';
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                << std::dec << std::setfill(' ');
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+/** Parameters of the run command.
+ */
+struct Run_options {
+    // wall-clock time limit of each instance
+    std::chrono::duration<double> timeout{60};
+    // address space limit of each instance in MB
+    long memory_limit = 4096;
+    // maximal number of solver processes at the same time
+    int num_jobs = std::max(1u, std::thread::hardware_concurrency());
+    // path to the SAT solver
+    fs::path sat_path;
+    // path to the SMT solver
+    fs::path smt_path;
+    // extra arguments passed to the solvers
+    std::vector<std::string> args;
+};
+
+/** Benchmark instance and result of the solver on it.
+ */
+struct Instance {
+    fs::path path;
+    // name of the directory which contains the instance
+    std::string family;
+    // expected answer (`sat`, `unsat`) or an empty string if it is not known
+    std::string expected;
+    // answer of the solver (`sat`, `unsat`, `unknown`) or an empty string if there is none
+    std::string answer;
+    // `solved`, `unknown`, `wrong`, `timeout`, `memout` or `error`
+    std::string status;
+    // wall-clock time in seconds
+    double time = 0;
+    // maximal resident set size in MB
+    double max_rss = 0;
+    // JSON statistics printed by the solver (the last JSON object on its output)
+    std::string stats;
+};
+
+// read expected answer from a `(set-info :status ...)` annotation
+std::string read_expected_answer(fs::path const& path)
+{
+    if (path.extension() != ".smt2")
+    {
+        return "";
+    }
+
+    std::ifstream input{path};
+    std::string line;
+    while (std::getline(input, line))
+    {
+        auto pos = line.find(":status");
+        if (pos != std::string::npos && line.find("set-info") != std::string::npos)
+        {
+            std::istringstream stream{line.substr(pos + 7)};
+            std::string answer;
+            stream >> answer;
+            answer.erase(std::remove(answer.begin(), answer.end(), ')'), answer.end());
+            return answer == "sat" || answer == "unsat" ? answer : "";
+        }
+    }
+    return "";
+}
+
+// find all benchmark files in @p paths
+std::vector<Instance> find_instances(std::vector<fs::path> const& paths)
+{
+    std::vector<fs::path> files;
+    for (auto const& path : paths)
+    {
+        if (fs::is_directory(path))
+        {
+            for (auto const& entry : fs::recursive_directory_iterator{path})
+            {
+                if (entry.is_regular_file())
+                {
+                    files.push_back(entry.path());
+                }
+            }
+        }
+        else
+        {
+            files.push_back(path);
+        }
+    }
+
+    std::vector<Instance> instances;
+    for (auto const& file : files)
+    {
+        if (file.extension() == ".cnf" || file.extension() == ".smt2")
+        {
+            auto& instance = instances.emplace_back();
+            instance.path = file;
+            instance.family = file.parent_path().filename().string();
+            instance.expected = read_expected_answer(file);
+        }
+    }
+    std::sort(instances.begin(), instances.end(),
+              [](auto const& lhs, auto const& rhs) { return lhs.path < rhs.path; });
+    return instances;
+}
+
+/** Solver process of one instance.
+ */
+struct Job {
+    Instance* instance;
+    pid_t pid;
+    // file with merged standard and error output of the solver
+    std::string output_path;
+    Clock::time_point start;
+    bool killed = false;
+};
+
+// start solver on @p instance in a new process
+Job start(Instance& instance, Run_options const& options)
+{
+    Job job{.instance = &instance, .pid = -1, .output_path = "", .start = Clock::now()};
+
+    char output_template[] = "/tmp/yaga-runner-XXXXXX";
+    int fd = mkstemp(output_template);
+    if (fd < 0)
+    {
+        throw std::runtime_error{"cannot create a temporary file"};
+    }
+    job.output_path = output_template;
+
+    auto solver = instance.path.extension() == ".cnf" ? options.sat_path : options.smt_path;
+    std::vector<std::string> args{solver.string(), "--print-stats"};
+    args.insert(args.end(), options.args.begin(), options.args.end());
+    args.push_back(instance.path.string());
+
+    job.pid = fork();
+    if (job.pid < 0)
+    {
+        throw std::runtime_error{"fork() failed"};
+    }
+    else if (job.pid == 0) // child
+    {
+        rlimit limit;
+        limit.rlim_cur = limit.rlim_max = static_cast<rlim_t>(options.memory_limit) << 20;
+        setrlimit(RLIMIT_AS, &limit);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+
+        std::vector<char*> argv;
+        for (auto& arg : args)
+        {
+            argv.push_back(arg.data());
+        }
+        argv.push_back(nullptr);
+        execv(argv[0], argv.data());
+        std::_Exit(127);
+    }
+    close(fd);
+    return job;
+}
+
+// process output of a finished solver process
+void finish(Job const& job, int exit_status, rusage const& usage, Run_options const& options)
+{
+    auto& instance = *job.instance;
+    instance.time = std::chrono::duration<double>(Clock::now() - job.start).count();
+    instance.max_rss = static_cast<double>(usage.ru_maxrss) / 1024.0;
+
+    std::ifstream input{job.output_path};
+    std::string line;
+    bool out_of_memory = false;
+    while (std::getline(input, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        std::string lower = line;
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        if (instance.answer.empty() && (lower == "sat" || lower == "unsat" || lower == "unknown"))
+        {
+            instance.answer = lower;
+        }
+        else if (line.starts_with("{"))
+        {
+            instance.stats = line;
+        }
+        else if (line.find("bad_alloc") != std::string::npos)
+        {
+            out_of_memory = true;
+        }
+    }
+    input.close();
+    fs::remove(job.output_path);
+
+    if (job.killed)
+    {
+        instance.status = "timeout";
+        instance.time = options.timeout.count();
+    }
+    else if (instance.answer == "sat" || instance.answer == "unsat")
+    {
+        instance.status = !instance.expected.empty() && instance.expected != instance.answer
+                              ? "wrong"
+                              : "solved";
+    }
+    else if (instance.answer == "unknown")
+    {
+        instance.status = "unknown";
+    }
+    else if (out_of_memory || (WIFSIGNALED(exit_status) &&
+                               instance.max_rss >= 0.9 * static_cast<double>(options.memory_limit)))
+    {
+        instance.status = "memout";
+    }
+    else
+    {
+        instance.status = "error";
+    }
+}
+
+/** Solve all @p instances using at most `options.num_jobs` solver processes at the same time.
+ *
+ * @param instances benchmark instances whose result is filled in
+ * @param options parameters of the run
+ */
+void run(std::vector<Instance>& instances, Run_options const& options)
+{
+    std::vector<Job> running;
+    std::size_t next = 0;
+    std::size_t num_finished = 0;
+    while (num_finished < instances.size())
+    {
+        while (next < instances.size() && static_cast<int>(running.size()) < options.num_jobs)
+        {
+            running.push_back(start(instances[next++], options));
+        }
+
+        for (auto it = running.begin(); it != running.end();)
+        {
+            int exit_status = 0;
+            rusage usage{};
+            if (wait4(it->pid, &exit_status, WNOHANG, &usage) == it->pid)
+            {
+                finish(*it, exit_status, usage, options);
+                auto const& instance = *it->instance;
+                std::cerr << "[" << ++num_finished << "/" << instances.size() << "] "
+                          << instance.path.string() << ": " << instance.status << " ("
+                          << instance.time << " s)\n";
+                it = running.erase(it);
+                continue;
+            }
+
+            if (!it->killed && Clock::now() - it->start > options.timeout)
+            {
+                kill(it->pid, SIGKILL);
+                it->killed = true;
+            }
+            ++it;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+}
+
+// write results of the run command as JSON
+void write_results(std::ostream& out, std::vector<Instance> const& instances,
+                   Run_options const& options)
+{
+    out << "{\"timeout\":" << options.timeout.count()
+        << ",\"memory_limit\":" << options.memory_limit << ",\"instances\":[";
+    for (bool is_first = true; auto const& instance : instances)
+    {
+        out << (is_first ? "\n" : ",\n") << "{\"path\":";
+        write_string(out, instance.path.string());
+        out << ",\"family\":";
+        write_string(out, instance.family);
+        out << ",\"expected\":";
+        write_string(out, instance.expected);
+        out << ",\"answer\":";
+        write_string(out, instance.answer);
+        out << ",\"status\":\"" << instance.status << "\",\"time\":" << instance.time
+            << ",\"max_rss\":" << instance.max_rss;
+        out << ",\"stats\":" << (instance.stats.empty() ? "null" : instance.stats) << "}";
+        is_first = false;
+    }
+    out << "\n]}\n";
+}
+
+int run_command(int argc, char** argv)
+{
+    Run_options options;
+    auto bin_dir = fs::absolute(argv[0]).parent_path();
+    options.sat_path = bin_dir / "sat";
+    options.smt_path = bin_dir / "smt";
+
+    std::string output_path;
+    std::vector<fs::path> paths;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg{argv[i]};
+        bool has_value = i + 1 < argc;
+        if (arg == "--output" && has_value)
+        {
+            output_path = argv[++i];
+        }
+        else if (arg == "--timeout" && has_value)
+        {
+            options.timeout = std::chrono::duration<double>{std::stod(argv[++i])};
+        }
+        else if (arg == "--memory-limit" && has_value)
+        {
+            options.memory_limit = std::stol(argv[++i]);
+        }
+        else if (arg == "--jobs" && has_value)
+        {
+            options.num_jobs = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--sat" && has_value)
+        {
+            options.sat_path = fs::absolute(argv[++i]);
+        }
+        else if (arg == "--smt" && has_value)
+        {
+            options.smt_path = fs::absolute(argv[++i]);
+        }
+        else if (arg == "--arg" && has_value)
+        {
+            options.args.emplace_back(argv[++i]);
+        }
+        else if (arg.starts_with("--"))
+        {
+            std::cerr << "Unrecognized option: '" << arg << "'\n";
+            print_help();
+            return -1;
+        }
+        else
+        {
+            paths.emplace_back(arg);
+        }
+    }
+
+    auto instances = find_instances(paths);
+    run(instances, options);
+
+    std::ofstream file;
+    if (!output_path.empty())
+    {
+        file.open(output_path);
+        if (!file)
+        {
+            std::cerr << "Error: cannot write to '" << output_path << "'\n";
+            return -1;
+        }
+    }
+    write_results(output_path.empty() ? std::cout : file, instances, options);
+    return 0;
+}
+
+/** Summary of results of one run.
+ */
+struct Summary {
+    int num_instances = 0;
+    int num_solved = 0;
+    int num_wrong = 0;
+    // sum of PAR-2 scores
+    double par2 = 0;
+};
+
+// read results of the run command from @p path
+Json read_results(std::string const& path)
+{
+    std::ifstream input{path};
+    if (!input)
+    {
+        throw std::runtime_error{"cannot read '" + path + "'"};
+    }
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    return Json_parser{buffer.str()}.parse();
+}
+
+// PAR-2 score of an instance (wall-clock time if solved, twice the time limit otherwise)
+double par2_score(Json const& instance, double timeout)
+{
+    return instance.string("status") == "solved" ? instance.number("time") : 2 * timeout;
+}
+
+int compare_command(std::string const& baseline_path, std::string const& candidate_path)
+{
+    auto baseline = read_results(baseline_path);
+    auto candidate = read_results(candidate_path);
+    auto baseline_timeout = baseline.number("timeout");
+    auto candidate_timeout = candidate.number("timeout");
+    if (baseline_timeout != candidate_timeout)
+    {
+        std::cerr << "Warning: the runs use different time limits\n";
+    }
+
+    // instances of the baseline by path
+    std::map<std::string, Json const*> baseline_instances;
+    if (auto list = baseline.find("instances"))
+    {
+        for (auto const& instance : std::get<Json::Array>(list->value))
+        {
+            baseline_instances[instance.string("path")] = &instance;
+        }
+    }
+
+    // compare instances present in both runs
+    Summary baseline_total;
+    Summary candidate_total;
+    std::map<std::string, std::pair<Summary, Summary>> families;
+    std::vector<std::string> regressions;
+    std::vector<std::string> improvements;
+    std::vector<std::string> wrong;
+    if (auto list = candidate.find("instances"))
+    {
+        for (auto const& instance : std::get<Json::Array>(list->value))
+        {
+            auto path = instance.string("path");
+            auto it = baseline_instances.find(path);
+            if (it == baseline_instances.end())
+            {
+                continue;
+            }
+
+            auto const& base = *it->second;
+            auto& [base_family, cand_family] = families[instance.string("family")];
+            for (auto [result, timeout, summary] :
+                 {std::tuple{&base, baseline_timeout, &base_family},
+                  std::tuple{&instance, candidate_timeout, &cand_family},
+                  std::tuple{&base, baseline_timeout, &baseline_total},
+                  std::tuple{&instance, candidate_timeout, &candidate_total}})
+            {
+                ++summary->num_instances;
+                summary->num_solved += result->string("status") == "solved";
+                summary->num_wrong += result->string("status") == "wrong";
+                summary->par2 += par2_score(*result, timeout);
+            }
+
+            bool base_solved = base.string("status") == "solved";
+            bool cand_solved = instance.string("status") == "solved";
+            if (instance.string("status") == "wrong")
+            {
+                wrong.push_back(path);
+            }
+            else if (base_solved && !cand_solved)
+            {
+                regressions.push_back(path + " (" + instance.string("status") + ")");
+            }
+            else if (!base_solved && cand_solved)
+            {
+                improvements.push_back(path);
+            }
+        }
+    }
+
+    auto speedup = [](Summary const& base, Summary const& cand) {
+        return cand.par2 > 0 ? base.par2 / cand.par2 : 1.0;
+    };
+
+    auto& out = std::cout;
+    out << std::fixed << std::setprecision(2);
+    out << "baseline:  " << baseline_path << "\n";
+    out << "candidate: " << candidate_path << "\n";
+    out << "instances: " << candidate_total.num_instances << "\n\n";
+    out << std::left << std::setw(24) << "" << std::right << std::setw(12) << "baseline"
+        << std::setw(12) << "candidate" << "\n";
+    out << std::left << std::setw(24) << "solved" << std::right << std::setw(12)
+        << baseline_total.num_solved << std::setw(12) << candidate_total.num_solved << "\n";
+    out << std::left << std::setw(24) << "wrong" << std::right << std::setw(12)
+        << baseline_total.num_wrong << std::setw(12) << candidate_total.num_wrong << "\n";
+    out << std::left << std::setw(24) << "PAR-2 [s]" << std::right << std::setw(12)
+        << baseline_total.par2 << std::setw(12) << candidate_total.par2 << "\n";
+    out << std::left << std::setw(24) << "speedup" << std::right << std::setw(24)
+        << speedup(baseline_total, candidate_total) << "\n\n";
+
+    out << std::left << std::setw(24) << "family" << std::right << std::setw(10) << "instances"
+        << std::setw(10) << "solved" << std::setw(10) << "solved'" << std::setw(12) << "PAR-2"
+        << std::setw(12) << "PAR-2'" << std::setw(10) << "speedup" << "\n";
+    for (auto const& [name, summaries] : families)
+    {
+        auto const& [base, cand] = summaries;
+        out << std::left << std::setw(24) << name << std::right << std::setw(10)
+            << base.num_instances << std::setw(10) << base.num_solved << std::setw(10)
+            << cand.num_solved << std::setw(12) << base.par2 << std::setw(12) << cand.par2
+            << std::setw(10) << speedup(base, cand) << "\n";
+    }
+
+    for (auto [title, list] : {std::pair{"wrong answers", &wrong},
+                               std::pair{"solved only by the baseline", &regressions},
+                               std::pair{"solved only by the candidate", &improvements}})
+    {
+        if (!list->empty())
+        {
+            out << "\n" << title << ":\n";
+            for (auto const& path : *list)
+            {
+                out << "  " << path << "\n";
+            }
+        }
+    }
+    return wrong.empty() && regressions.empty() ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string command = argc > 1 ? argv[1] : "";
+    try
+    {
+        if (command == "run")
+        {
+            return run_command(argc, argv);
+        }
+        else if (command == "compare" && argc == 4)
+        {
+            return compare_command(argv[2], argv[3]);
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return -1;
+    }
+
+    print_help();
+    return -1;
+}
@@ -4,7 +4,7 @@ script_path=$(realpath "$0")
 script_dir=$(dirname "$script_path")
 bin=$(realpath "$script_dir/../build-release/sat")
 
-echo "path,result,time,conflicts,decisions,restarts"
+echo "path,result,parse_time,parse_mbps,preprocess_time,eliminated,removed_clauses,probing_time,failed_literals,equivalent_vars,vivification_time,vivified_clauses,vivified_literals,time,conflicts,decisions,restarts"
 for path in $@
 do
     out=$("$bin" "$path")